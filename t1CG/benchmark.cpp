@@ -0,0 +1,403 @@
+/**
+ * @file benchmark.cpp
+ * @brief Benchmark do preenchimento ET/AET e do pipeline de extrusão (sem janela GLUT)
+ *
+ * Compara as estratégias de ordenação da AET (std::sort completo vs. ordenação
+ * incremental), o DDA em ponto fixo 16.16 e o preenchimento paralelo por faixas
+ * em polígonos côncavos grandes, medindo scanlines por segundo.
+ *
+ * Em seguida mede cada etapa do pipeline (generateSpans, scanPolygon com um sink
+ * que só conta, generateTriangulation, ear clipping, Douglas-Peucker,
+ * buildExtrudedObject e calculateNormals) sobre formas sintéticas
+ * (n-gonos convexos, estrelas côncavas, polígonos auto-intersectantes e arestas
+ * quase horizontais) com número de vértices e altura crescentes, reportando
+ * tempo por chamada, spans/s, triângulos gerados e alocações por chamada.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "core/data_structures.h"
+#include "core/polygon_fill_algorithm.h"
+#include "core/parallel_scanline_fill.h"
+#include "core/polygon_triangulator.h"
+#include "core/polygon_simplifier.h"
+#include "core/scene_manager.h"
+
+// --- Contagem de alocações ---
+// operator new global substituído: cada chamada (de qualquer thread) incrementa o contador
+
+static std::atomic<size_t> allocationCount(0);
+
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+
+/**
+ * @brief Gera um polígono em forma de pente: muitas arestas ativas em cada scanline
+ * @param teethCount Número de dentes (cada dente adiciona 2 vértices)
+ * @param width Largura total do pente
+ * @param height Altura dos dentes
+ */
+std::vector<Point2D> makeCombPolygon(int teethCount, int width, int height) {
+    std::vector<Point2D> vertices;
+    int top = 10;
+    int bottom = top + height;
+    float toothWidth = static_cast<float>(width) / teethCount;
+
+    for (int tooth = 0; tooth < teethCount; ++tooth) {
+        int leftX = 10 + static_cast<int>(tooth * toothWidth);
+        int tipX = 10 + static_cast<int>((tooth + 0.5f) * toothWidth);
+        vertices.push_back(Point2D(leftX, bottom));
+        vertices.push_back(Point2D(tipX, top));
+    }
+    vertices.push_back(Point2D(10 + width, bottom));
+    vertices.push_back(Point2D(10 + width, bottom + 20));
+    vertices.push_back(Point2D(10, bottom + 20));
+    return vertices;
+}
+
+/**
+ * @brief Gera uma estrela côncava com muitas pontas em torno de um centro
+ * @param pointCount Número de pontas
+ * @param radius Raio externo
+ */
+std::vector<Point2D> makeStarPolygon(int pointCount, int radius) {
+    std::vector<Point2D> vertices;
+    const double pi = 3.14159265358979323846;
+    int center = radius + 10;
+
+    for (int i = 0; i < pointCount * 2; ++i) {
+        double angle = pi * i / pointCount;
+        double currentRadius = (i % 2 == 0) ? radius : radius * 0.45;
+        vertices.push_back(Point2D(center + static_cast<int>(currentRadius * std::cos(angle)),
+                                   center + static_cast<int>(currentRadius * std::sin(angle))));
+    }
+    return vertices;
+}
+
+/**
+ * @brief Mede o throughput de generateSpans para uma estratégia de ordenação
+ * @return Scanlines processadas por segundo
+ */
+double measureScanlineThroughput(const std::vector<Point2D>& polygon, AETOrderingMode mode,
+                                 EdgeSteppingMode stepping, int iterations, size_t* spanCount) {
+    PolygonFillAlgorithm algorithm(mode, stepping);
+    const int maxHeight = 2000;
+    const int maxWidth = 4000;
+
+    int minY = polygon[0].coordinateY;
+    int maxY = polygon[0].coordinateY;
+    for (const Point2D& vertex : polygon) {
+        minY = std::min(minY, vertex.coordinateY);
+        maxY = std::max(maxY, vertex.coordinateY);
+    }
+
+    size_t totalSpans = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        totalSpans += algorithm.generateSpans(polygon, maxHeight, maxWidth).size();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    *spanCount = totalSpans / iterations;
+    return (static_cast<double>(maxY - minY) * iterations) / seconds;
+}
+
+/**
+ * @brief Mede o throughput do preenchimento paralelo por faixas (16.16, AET incremental)
+ * @return Scanlines processadas por segundo
+ */
+double measureParallelThroughput(const std::vector<Point2D>& polygon, int iterations, size_t* spanCount) {
+    ParallelScanlineFill parallelFill(AETOrderingMode::INCREMENTAL, EdgeSteppingMode::FIXED_POINT);
+    const int maxHeight = 2000;
+    const int maxWidth = 4000;
+
+    int minY = polygon[0].coordinateY;
+    int maxY = polygon[0].coordinateY;
+    for (const Point2D& vertex : polygon) {
+        minY = std::min(minY, vertex.coordinateY);
+        maxY = std::max(maxY, vertex.coordinateY);
+    }
+
+    size_t totalSpans = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        totalSpans += parallelFill.generateSpans(polygon, maxHeight, maxWidth).size();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    *spanCount = totalSpans / iterations;
+    return (static_cast<double>(maxY - minY) * iterations) / seconds;
+}
+
+void runCase(const char* name, const std::vector<Point2D>& polygon, int iterations) {
+    size_t sortedSpans = 0;
+    size_t incrementalSpans = 0;
+    size_t fixedSpans = 0;
+    size_t parallelSpans = 0;
+    double fullSort = measureScanlineThroughput(polygon, AETOrderingMode::FULL_SORT,
+                                                EdgeSteppingMode::FLOATING_POINT, iterations, &sortedSpans);
+    double incremental = measureScanlineThroughput(polygon, AETOrderingMode::INCREMENTAL,
+                                                   EdgeSteppingMode::FLOATING_POINT, iterations, &incrementalSpans);
+    double fixedPoint = measureScanlineThroughput(polygon, AETOrderingMode::INCREMENTAL,
+                                                  EdgeSteppingMode::FIXED_POINT, iterations, &fixedSpans);
+    double parallel = measureParallelThroughput(polygon, iterations, &parallelSpans);
+
+    std::printf("%-22s %7zu vertices | std::sort: %10.0f | incremental: %10.0f (%.2fx) | 16.16: %10.0f (%.2fx) | paralelo: %10.0f (%.2fx) linhas/s%s\n",
+                name, polygon.size(), fullSort, incremental, incremental / fullSort,
+                fixedPoint, fixedPoint / fullSort, parallel, parallel / fullSort,
+                (sortedSpans == incrementalSpans && fixedSpans == parallelSpans) ? "" : "  [AVISO: spans diferentes]");
+}
+
+/**
+ * @brief Gera um n-gono convexo regular
+ * @param vertexCount Número de vértices
+ * @param radius Raio do círculo circunscrito
+ */
+std::vector<Point2D> makeConvexPolygon(int vertexCount, int radius) {
+    std::vector<Point2D> vertices;
+    const double pi = 3.14159265358979323846;
+    int center = radius + 10;
+
+    for (int i = 0; i < vertexCount; ++i) {
+        double angle = 2.0 * pi * i / vertexCount;
+        vertices.push_back(Point2D(center + static_cast<int>(radius * std::cos(angle)),
+                                   center + static_cast<int>(radius * std::sin(angle))));
+    }
+    return vertices;
+}
+
+/**
+ * @brief Gera um polígono estrelado {n/2}: cada vértice liga ao segundo seguinte no círculo
+ *
+ * Com n ímpar o contorno fecha em uma única volta dupla e cada aresta cruza as
+ * duas vizinhas, o que força o fallback de scanline na triangulação.
+ * @param vertexCount Número de vértices (arredondado para ímpar)
+ * @param radius Raio do círculo
+ */
+std::vector<Point2D> makeSelfIntersectingPolygon(int vertexCount, int radius) {
+    std::vector<Point2D> vertices;
+    const double pi = 3.14159265358979323846;
+    int center = radius + 10;
+    int count = vertexCount | 1;
+
+    for (int i = 0; i < count; ++i) {
+        double angle = 2.0 * pi * ((2 * i) % count) / count;
+        vertices.push_back(Point2D(center + static_cast<int>(radius * std::cos(angle)),
+                                   center + static_cast<int>(radius * std::sin(angle))));
+    }
+    return vertices;
+}
+
+/**
+ * @brief Gera uma faixa larga cujo topo é um serrilhado de arestas quase horizontais
+ *
+ * Cada aresta do topo sobe ou desce 3 pixels ao longo de width / vertexCount
+ * pixels: muitas arestas começam e terminam em poucas scanlines.
+ * @param vertexCount Número de vértices do serrilhado
+ * @param width Largura da faixa
+ * @param height Altura da faixa
+ */
+std::vector<Point2D> makeNearHorizontalPolygon(int vertexCount, int width, int height) {
+    std::vector<Point2D> vertices;
+    int top = 10;
+    int bottom = top + height;
+
+    for (int i = 0; i < vertexCount; ++i) {
+        int x = 10 + static_cast<int>(static_cast<long long>(width) * i / (vertexCount - 1));
+        vertices.push_back(Point2D(x, top + (i % 2) * 3));
+    }
+    vertices.push_back(Point2D(10 + width, bottom));
+    vertices.push_back(Point2D(10, bottom));
+    return vertices;
+}
+
+/**
+ * @brief Resultado de uma etapa do pipeline para um caso
+ */
+struct StageSample {
+    double microsecondsPerCall;
+    double allocationsPerCall;
+    size_t outputCount;        // Spans, triângulos ou faces da última chamada
+};
+
+/**
+ * @brief Mede uma etapa repetindo-a até somar ~targetSeconds (pelo menos uma vez)
+ * @param work Função que executa a etapa e devolve o tamanho da saída
+ */
+template <typename Work>
+StageSample measureStage(Work work, double targetSeconds = 0.05) {
+    // Uma chamada de aquecimento também estima quantas repetições cabem no tempo alvo
+    auto warmupStart = std::chrono::high_resolution_clock::now();
+    size_t output = work();
+    double warmupSeconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - warmupStart).count();
+    int iterations = static_cast<int>(std::min(10000.0, std::max(1.0, targetSeconds / std::max(warmupSeconds, 1e-7))));
+
+    size_t allocationsBefore = allocationCount.load();
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        output = work();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    size_t allocations = allocationCount.load() - allocationsBefore;
+
+    StageSample sample;
+    sample.microsecondsPerCall = std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+    sample.allocationsPerCall = static_cast<double>(allocations) / iterations;
+    sample.outputCount = output;
+    return sample;
+}
+
+/**
+ * @brief Um polígono sintético do pipeline, com o nome da família e a altura pedida
+ */
+struct PipelineCase {
+    std::string family;
+    int height;
+    std::vector<Point2D> polygon;
+};
+
+std::vector<PipelineCase> makePipelineCases() {
+    const int vertexCounts[] = { 16, 256, 4096 };
+    const int heights[] = { 250, 1000, 1900 };
+    std::vector<PipelineCase> cases;
+
+    for (int height : heights) {
+        for (int vertexCount : vertexCounts) {
+            cases.push_back({ "Convexo", height, makeConvexPolygon(vertexCount, height / 2) });
+            cases.push_back({ "Estrela", height, makeStarPolygon(vertexCount / 2, height / 2) });
+            cases.push_back({ "Auto-intersectante", height, makeSelfIntersectingPolygon(vertexCount, height / 2) });
+            cases.push_back({ "Quase horizontal", height, makeNearHorizontalPolygon(vertexCount, 3900, height) });
+        }
+    }
+    return cases;
+}
+
+void printStageHeader(const char* stage, const char* outputName, bool showRate) {
+    std::printf("\n--- %s ---\n", stage);
+    std::printf("%-20s %8s %7s | %12s %10s%s %10s\n", "forma", "vertices", "altura",
+                "us/chamada", outputName, showRate ? "      por s" : "", "aloc/cham");
+}
+
+void printStageRow(const PipelineCase& benchmarkCase, const StageSample& sample, bool showRate) {
+    std::printf("%-20s %8zu %7d | %12.1f %10zu", benchmarkCase.family.c_str(), benchmarkCase.polygon.size(),
+                benchmarkCase.height, sample.microsecondsPerCall, sample.outputCount);
+    if (showRate) {
+        std::printf(" %10.3g", sample.outputCount / (sample.microsecondsPerCall * 1e-6));
+    }
+    std::printf(" %10.1f\n", sample.allocationsPerCall);
+}
+
+/**
+ * @brief Mede as etapas do preenchimento e da extrusão em todos os casos sintéticos
+ */
+void runPipelineBenchmark() {
+    const int maxHeight = 2000;
+    const int maxWidth = 4000;
+    const float extrusionDepth = 100.0f;
+    std::vector<PipelineCase> cases = makePipelineCases();
+    PolygonFillAlgorithm algorithm;
+
+    std::printf("\n========================================\n");
+    std::printf("Pipeline de preenchimento e extrusao\n");
+    std::printf("========================================\n");
+
+    printStageHeader("PolygonFillAlgorithm::generateSpans", "spans", true);
+    for (const PipelineCase& benchmarkCase : cases) {
+        printStageRow(benchmarkCase, measureStage([&]() {
+            return algorithm.generateSpans(benchmarkCase.polygon, maxHeight, maxWidth).size();
+        }), true);
+    }
+
+    // Mesmo laço sem materializar a SpanList: diferença = custo de armazenar os spans
+    printStageHeader("PolygonFillAlgorithm::scanPolygon (CountingSpanSink)", "spans", true);
+    for (const PipelineCase& benchmarkCase : cases) {
+        printStageRow(benchmarkCase, measureStage([&]() {
+            CountingSpanSink sink;
+            algorithm.scanPolygon(benchmarkCase.polygon, maxHeight, maxWidth, sink);
+            return sink.spanCount;
+        }), true);
+    }
+
+    printStageHeader("PolygonFillAlgorithm::generateTriangulation (faixas da scanline)", "triangulos", true);
+    for (const PipelineCase& benchmarkCase : cases) {
+        printStageRow(benchmarkCase, measureStage([&]() {
+            return algorithm.generateTriangulation(benchmarkCase.polygon, maxHeight).size();
+        }), true);
+    }
+
+    printStageHeader("PolygonTriangulator::triangulate (ear clipping, fallback scanline)", "triangulos", true);
+    for (const PipelineCase& benchmarkCase : cases) {
+        printStageRow(benchmarkCase, measureStage([&]() {
+            return PolygonTriangulator::triangulate(benchmarkCase.polygon, maxHeight).size();
+        }), true);
+    }
+
+    // Nível intermediário de detalhe das extrusões; a saída é o número de vértices mantidos
+    printStageHeader("PolygonSimplifier::simplifyClosed (tolerancia do 2o nivel de LOD)", "vertices", false);
+    for (const PipelineCase& benchmarkCase : cases) {
+        printStageRow(benchmarkCase, measureStage([&]() {
+            return PolygonSimplifier::simplifyClosed(benchmarkCase.polygon, SceneManager::EXTRUSION_LOD_TOLERANCES[1]).size();
+        }), false);
+    }
+
+    printStageHeader("SceneManager::buildExtrudedObject (inclui calculateNormals e niveis de LOD)", "faces", false);
+    for (const PipelineCase& benchmarkCase : cases) {
+        printStageRow(benchmarkCase, measureStage([&]() {
+            std::unique_ptr<Object3D> object = SceneManager::buildExtrudedObject(benchmarkCase.polygon, extrusionDepth);
+            return object ? object->getFaceCount() : static_cast<size_t>(0);
+        }), false);
+    }
+
+    printStageHeader("Object3D::calculateNormals (malha extrudada ja montada)", "vertices", false);
+    for (const PipelineCase& benchmarkCase : cases) {
+        std::unique_ptr<Object3D> object = SceneManager::buildExtrudedObject(benchmarkCase.polygon, extrusionDepth);
+        if (!object) {
+            continue;
+        }
+        printStageRow(benchmarkCase, measureStage([&]() {
+            object->calculateNormals();
+            return object->getVertexCount();
+        }), false);
+    }
+}
+
+int main() {
+    std::printf("========================================\n");
+    std::printf("Benchmark ET/AET - ordenacao da AET\n");
+    std::printf("Threads disponiveis: %u\n", getWorkerThreadCount());
+    std::printf("========================================\n");
+
+    runCase("Pente 250 dentes", makeCombPolygon(250, 3000, 1500), 20);
+    runCase("Pente 1000 dentes", makeCombPolygon(1000, 3900, 1500), 10);
+    runCase("Pente 2000 dentes", makeCombPolygon(2000, 3900, 1500), 5);
+    runCase("Estrela 500 pontas", makeStarPolygon(500, 900), 20);
+    runCase("Estrela 4000 pontas", makeStarPolygon(4000, 900), 10);
+
+    runPipelineBenchmark();
+
+    return 0;
+}
@@ -0,0 +1,44 @@
+@echo off
+echo ========================================
+echo Compilando Benchmark (sem janela GLUT)
+echo ========================================
+echo.
+
+REM Verificar se g++ está disponível
+where g++ >nul 2>nul
+if %ERRORLEVEL% NEQ 0 (
+    echo [ERRO] MinGW/g++ nao encontrado!
+    echo Por favor, instale MinGW e adicione ao PATH.
+    pause
+    exit /b 1
+)
+
+echo [1/3] Limpando arquivos antigos...
+if exist benchmark.exe (
+    del benchmark.exe
+    echo    - benchmark.exe removido
+)
+
+echo.
+echo [2/3] Compilando...
+echo Comando: g++ -O2 -o benchmark.exe benchmark.cpp -Iinclude -Icore -Llib -lfreeglut -lopengl32 -lglu32 -lgdi32 -luser32 -lkernel32 -std=c++17
+echo.
+
+g++ -O2 -o benchmark.exe benchmark.cpp -Iinclude -Icore -Llib -lfreeglut -lopengl32 -lglu32 -lgdi32 -luser32 -lkernel32 -std=c++17
+
+if %ERRORLEVEL% NEQ 0 (
+    echo.
+    echo ========================================
+    echo [ERRO] FALHA NA COMPILACAO!
+    echo ========================================
+    echo Codigo de erro: %ERRORLEVEL%
+    echo.
+    pause
+    exit /b %ERRORLEVEL%
+)
+
+echo.
+echo [3/3] Executando benchmark...
+echo.
+benchmark.exe
+pause
@@ -7,6 +7,8 @@
 #include "scene_manager.h"
 #include "event_handler.h"
 #include "ui_manager.h"
+#include "scene_file.h"
+#include "editor_layer.h"
 #include <GL/glut.h>
 
 enum class AppMode {
@@ -16,6 +18,8 @@ enum class AppMode {
 
 class ApplicationContext {
 public:
+    static constexpr float SAVED_POLYGON_DEPTH = 50.0f; // Profundidade da extrusão dos polígonos 2D
+
     PolygonManager polygonManager;
     GraphicsRenderer graphicsRenderer;
     SceneManager sceneManager;
@@ -30,11 +34,19 @@ public:
     int lastMouseY;
     bool isRightMouseButtonPressed;
     
+    // Camada persistente do editor 2D e o que foi desenhado nela por último,
+    // para marcar o dano que o PolygonManager não enxerga (estado de preenchimento, backend)
+    EditorLayer editorLayer;
+    bool drawnCurrentFill;
+    ScreenRect drawnCurrentFillBounds;
+    RenderBackend drawnBackend;
+    
     ApplicationContext() 
         : eventHandler(nullptr), windowDimensions(nullptr),
           applicationState(ApplicationState::DRAWING_POLYGON),
           currentMode(AppMode::MODE_2D_EDITOR),
-          lastMouseX(0), lastMouseY(0), isRightMouseButtonPressed(false) {
+          lastMouseX(0), lastMouseY(0), isRightMouseButtonPressed(false),
+          drawnCurrentFill(false), drawnBackend(RenderBackend::IMMEDIATE_MODE) {
     }
     
     ~ApplicationContext() {
@@ -143,31 +155,157 @@ public:
                                           windowDimensions, &currentMode);
     }
     
+    /**
+     * @brief Acrescenta ao dano do editor o que mudou fora do PolygonManager desde o último quadro
+     *
+     * O preenchimento do polígono atual depende de applicationState, e trocar de
+     * backend muda os pixels de todos os polígonos salvos.
+     */
+    void collectEditorDamage() {
+        DamageTracker& damage = polygonManager.getDamage();
+
+        bool fillCurrent = polygonManager.canBeFilled() && applicationState == ApplicationState::POLYGON_FILLED;
+        ScreenRect fillBounds;
+        if (fillCurrent) {
+            fillBounds = ScreenRect::boundsOf(polygonManager.getVertices()).expanded(1);
+        }
+        bool sameBounds = fillBounds.minX == drawnCurrentFillBounds.minX && fillBounds.minY == drawnCurrentFillBounds.minY &&
+                          fillBounds.maxX == drawnCurrentFillBounds.maxX && fillBounds.maxY == drawnCurrentFillBounds.maxY;
+        if (fillCurrent != drawnCurrentFill || !sameBounds) {
+            damage.addRect(drawnCurrentFillBounds);
+            damage.addRect(fillBounds);
+        }
+        drawnCurrentFill = fillCurrent;
+        drawnCurrentFillBounds = fillBounds;
+
+        if (graphicsRenderer.getBackend() != drawnBackend) {
+            damage.invalidateAll();
+            drawnBackend = graphicsRenderer.getBackend();
+        }
+    }
+    
     void create3DObjectsFrom2D() {
-        sceneManager.clearObjects();
-        bool hasObjects = false;
+        // Ids reservados para as fontes que não são polígonos salvos
+        const unsigned long CURRENT_POLYGON_SOURCE_ID = ~0ul;
+        const unsigned long DEFAULT_SQUARE_SOURCE_ID = ~0ul - 1;
+        
+        std::vector<ExtrusionSource> sources;
 
         const auto& savedPolys = polygonManager.getSavedPolygons();
         for (const auto& poly : savedPolys) {
             if (poly.vertices.size() >= 3) {
-                sceneManager.createExtrudedObject(poly.vertices, 50.0f);
-                hasObjects = true;
+                sources.emplace_back(poly.id, poly.vertices, SAVED_POLYGON_DEPTH);
             }
         }
         
         if (polygonManager.isPolygonCurrentlyClosed() && polygonManager.getVertexCount() >= 3) {
-            sceneManager.createExtrudedObject(polygonManager.getVertices(), 50.0f);
-            hasObjects = true;
+            sources.emplace_back(CURRENT_POLYGON_SOURCE_ID, polygonManager.getVertices(), SAVED_POLYGON_DEPTH);
         }
         
-        if (!hasObjects) {
+        if (sources.empty()) {
             std::vector<Point2D> square;
             square.push_back(Point2D(350, 250));
             square.push_back(Point2D(450, 250));
             square.push_back(Point2D(450, 350));
             square.push_back(Point2D(350, 350));
-            sceneManager.createExtrudedObject(square, 100.0f);
+            sources.emplace_back(DEFAULT_SQUARE_SOURCE_ID, square, 100.0f);
+        }
+        
+        // Só polígonos novos ou editados desde a última troca são extrudados de novo, em
+        // segundo plano; a cena anterior continua na tela até display() recolher o resultado
+        sceneManager.requestExtrudedObjects(sources);
+    }
+    
+    /**
+     * @brief Grava os polígonos salvos e suas extrusões em um arquivo de cena
+     * @return false se o arquivo não puder ser escrito
+     *
+     * Extrusões que já estão na cena 3D vão como estão; as que faltam são
+     * montadas aqui, na thread atual.
+     */
+    bool saveScene(const char* path) {
+        const auto& savedPolys = polygonManager.getSavedPolygons();
+        std::vector<std::unique_ptr<Object3D>> builtForFile;
+        std::vector<SceneFileMesh> meshes;
+        
+        for (size_t i = 0; i < savedPolys.size(); i++) {
+            const auto& poly = savedPolys[i];
+            uint64_t contentHash = SceneManager::hashExtrusion(poly.vertices, SAVED_POLYGON_DEPTH);
+            Object3D* object = sceneManager.findCachedExtrusion(poly.id, contentHash);
+            if (!object) {
+                builtForFile.push_back(SceneManager::buildExtrudedObject(poly.vertices, SAVED_POLYGON_DEPTH));
+                object = builtForFile.back().get();
+            }
+            if (object) {
+                meshes.push_back(SceneFileMesh{ static_cast<uint32_t>(i), SAVED_POLYGON_DEPTH, contentHash, object });
+            }
+        }
+        
+        return SceneFile::save(path, savedPolys, meshes);
+    }
+    
+    /**
+     * @brief Substitui os polígonos salvos e a cena 3D pelo conteúdo de um arquivo de cena
+     * @return false se o arquivo não existir ou for inválido (nada é alterado)
+     *
+     * As extrusões gravadas (com seus níveis de detalhe) entram no cache da cena 3D,
+     * então voltar ao modo 3D não extruda nada; extrusões que não batem mais com o
+     * polígono são ignoradas. No modo 3D, polígonos sem extrusão válida seguem para
+     * as threads de trabalho: confira hasPendingExtrusions() depois.
+     */
+    bool loadScene(const char* path) {
+        SceneFileReader reader;
+        if (!reader.open(path)) {
+            return false;
+        }
+        
+        std::vector<PolygonManager::SavedPolygon> polygons;
+        polygons.reserve(reader.getPolygonCount());
+        for (size_t i = 0; i < reader.getPolygonCount(); i++) {
+            if (!reader.readPolygon(i, polygons)) {
+                return false;
+            }
+        }
+        
+        polygonManager.loadSavedPolygons(std::move(polygons));
+        polygonManager.clearPolygon();
+        applicationState = ApplicationState::DRAWING_POLYGON;
+        
+        const auto& savedPolys = polygonManager.getSavedPolygons();
+        std::vector<BakedExtrusion> baked;
+        bool acceptingLevels = false; // A última malha completa lida foi aceita
+        for (size_t i = 0; i < reader.getMeshCount(); i++) {
+            SceneFileMeshInfo info;
+            MeshGeometryView view;
+            if (!reader.readMesh(i, info, view) || info.polygonIndex >= savedPolys.size()) {
+                acceptingLevels = false;
+                continue;
+            }
+            if (info.geometricError > 0.0f) {
+                // Nível de detalhe da malha completa anterior
+                if (acceptingLevels && savedPolys[info.polygonIndex].id == baked.back().sourceId) {
+                    auto level = std::make_unique<Object3D>();
+                    level->loadGeometry(view);
+                    baked.back().object->addLodLevel(std::move(level), info.geometricError);
+                }
+                continue;
+            }
+            const auto& poly = savedPolys[info.polygonIndex];
+            acceptingLevels = info.contentHash == SceneManager::hashExtrusion(poly.vertices, info.depth);
+            if (!acceptingLevels) {
+                continue;
+            }
+            auto object = std::make_unique<Object3D>();
+            object->loadGeometry(view);
+            object->color = info.color;
+            baked.push_back(BakedExtrusion{ poly.id, info.contentHash, std::move(object) });
+        }
+        sceneManager.adoptExtrudedObjects(baked);
+        
+        if (currentMode == AppMode::MODE_3D_VIEWER) {
+            create3DObjectsFrom2D();
         }
+        return true;
     }
     
     static ApplicationContext* getInstance() {
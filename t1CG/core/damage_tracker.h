@@ -0,0 +1,171 @@
+/**
+ * @file damage_tracker.h
+ * @brief Retângulos alterados da área de desenho 2D, para redesenhar só o que mudou
+ * @author Sistema de Computação Gráfica
+ * @date 2025
+ */
+
+#ifndef DAMAGE_TRACKER_H
+#define DAMAGE_TRACKER_H
+
+#include "data_structures.h"
+#include <algorithm>
+#include <climits>
+#include <vector>
+
+/**
+ * @brief Retângulo em pixels de janela (Y para baixo), limites inclusivos
+ */
+struct ScreenRect {
+    int minX, minY, maxX, maxY;
+
+    ScreenRect() : minX(INT_MAX), minY(INT_MAX), maxX(INT_MIN), maxY(INT_MIN) {}
+    ScreenRect(int x0, int y0, int x1, int y1) : minX(x0), minY(y0), maxX(x1), maxY(y1) {}
+
+    bool empty() const { return minX > maxX || minY > maxY; }
+
+    long long area() const {
+        return empty() ? 0 : static_cast<long long>(maxX - minX + 1) * (maxY - minY + 1);
+    }
+
+    bool intersects(const ScreenRect& other) const {
+        return !empty() && !other.empty() &&
+               minX <= other.maxX && other.minX <= maxX && minY <= other.maxY && other.minY <= maxY;
+    }
+
+    void include(int x, int y) {
+        minX = std::min(minX, x);
+        minY = std::min(minY, y);
+        maxX = std::max(maxX, x);
+        maxY = std::max(maxY, y);
+    }
+
+    void unite(const ScreenRect& other) {
+        if (!other.empty()) {
+            include(other.minX, other.minY);
+            include(other.maxX, other.maxY);
+        }
+    }
+
+    ScreenRect expanded(int padding) const {
+        return empty() ? *this : ScreenRect(minX - padding, minY - padding, maxX + padding, maxY + padding);
+    }
+
+    ScreenRect clipped(int width, int height) const {
+        return ScreenRect(std::max(minX, 0), std::max(minY, 0), std::min(maxX, width - 1), std::min(maxY, height - 1));
+    }
+
+    static ScreenRect boundsOf(const std::vector<Point2D>& vertices) {
+        ScreenRect bounds;
+        for (const Point2D& vertex : vertices) {
+            bounds.include(vertex.coordinateX, vertex.coordinateY);
+        }
+        return bounds;
+    }
+};
+
+/**
+ * @class DamageTracker
+ * @brief Lista curta de retângulos disjuntos que precisam ser redesenhados
+ *
+ * Retângulos que se tocam são fundidos na inserção; passando de MAX_RECTS, o
+ * par cuja união menos aumenta a área vira um só. Quem consome redesenha cada
+ * retângulo (com glScissor) e chama clear().
+ */
+class DamageTracker {
+public:
+    static const size_t MAX_RECTS = 8;
+
+private:
+    std::vector<ScreenRect> rects;
+    bool fullDamage;
+
+    static ScreenRect unionOf(const ScreenRect& a, const ScreenRect& b) {
+        ScreenRect merged = a;
+        merged.unite(b);
+        return merged;
+    }
+
+    /**
+     * @brief Tira da lista o par cuja união menos aumenta a área e devolve essa união
+     */
+    ScreenRect takeCheapestPair() {
+        size_t bestA = 0, bestB = 1;
+        long long bestGrowth = -1;
+        for (size_t a = 0; a < rects.size(); a++) {
+            for (size_t b = a + 1; b < rects.size(); b++) {
+                long long growth = unionOf(rects[a], rects[b]).area() - rects[a].area() - rects[b].area();
+                if (bestGrowth < 0 || growth < bestGrowth) {
+                    bestGrowth = growth;
+                    bestA = a;
+                    bestB = b;
+                }
+            }
+        }
+        ScreenRect merged = unionOf(rects[bestA], rects[bestB]);
+        rects.erase(rects.begin() + bestB); // bestB > bestA: apagar antes não desloca bestA
+        rects.erase(rects.begin() + bestA);
+        return merged;
+    }
+
+public:
+    DamageTracker() : fullDamage(true) {}
+
+    void addRect(const ScreenRect& rect) {
+        if (fullDamage || rect.empty()) {
+            return;
+        }
+        // A união pode passar a tocar outros retângulos: repete até ficar disjunta
+        ScreenRect merged = rect;
+        bool grew = true;
+        while (grew) {
+            grew = false;
+            for (size_t i = 0; i < rects.size(); i++) {
+                if (rects[i].intersects(merged.expanded(1))) {
+                    merged.unite(rects[i]);
+                    rects.erase(rects.begin() + i);
+                    grew = true;
+                    break;
+                }
+            }
+        }
+        rects.push_back(merged);
+        if (rects.size() > MAX_RECTS) {
+            // A união do par pode tocar um terceiro: volta pelo laço de fusão acima
+            addRect(takeCheapestPair());
+        }
+    }
+
+    /**
+     * @brief Caixa de uma aresta (ou de um vértice, se a == b) com folga para espessura e marcadores
+     */
+    void addEdge(const Point2D& a, const Point2D& b, int padding) {
+        ScreenRect rect;
+        rect.include(a.coordinateX, a.coordinateY);
+        rect.include(b.coordinateX, b.coordinateY);
+        addRect(rect.expanded(padding));
+    }
+
+    void addBounds(const std::vector<Point2D>& vertices, int padding) {
+        addRect(ScreenRect::boundsOf(vertices).expanded(padding));
+    }
+
+    /**
+     * @brief Marca a área inteira (mudança de tamanho, de backend ou da cena toda)
+     */
+    void invalidateAll() {
+        fullDamage = true;
+        rects.clear();
+    }
+
+    bool isFull() const { return fullDamage; }
+    bool hasDamage() const { return fullDamage || !rects.empty(); }
+    const std::vector<ScreenRect>& getRects() const { return rects; }
+
+    void clear() {
+        fullDamage = false;
+        rects.clear();
+    }
+};
+
+#endif // DAMAGE_TRACKER_H
@@ -18,6 +18,7 @@ const int UI_PANEL_HEIGHT = 0;
 const int RIGHT_PANEL_WIDTH = 200;
 const int DRAWING_AREA_WIDTH = WINDOW_WIDTH - RIGHT_PANEL_WIDTH;
 const int DRAWING_AREA_HEIGHT = WINDOW_HEIGHT;
+const float VERTEX_MARKER_SIZE = 6.0f; // Lado, em pixels, do ponto desenhado em cada vértice
 
 /**
  * @struct Color16Bit
@@ -128,6 +129,37 @@ struct EdgeData {
 
 typedef std::vector<std::vector<EdgeData>> EdgeTable;
 
+/**
+ * @struct SparseEdgeTable
+ * @brief Edge Table compacta: lista plana de arestas ordenada por minimumY,
+ *        cobrindo apenas o intervalo [minY, maxY] do polígono
+ */
+struct SparseEdgeTable {
+    int minY;
+    int maxY;
+    std::vector<EdgeData> edges;
+
+    SparseEdgeTable() : minY(0), maxY(-1) {}
+
+    bool empty() const {
+        return edges.empty();
+    }
+};
+
+/**
+ * @struct Span
+ * @brief Segmento horizontal preenchido [xStart, xEnd] de uma scanline
+ */
+struct Span {
+    int y;
+    int xStart;
+    int xEnd;
+
+    Span(int scanLine, int startX, int endX) : y(scanLine), xStart(startX), xEnd(endX) {}
+};
+
+typedef std::vector<Span> SpanList;
+
 /**
  * @struct ColorRGB
  * @brief Representa uma cor RGB com componentes de 0.0 a 1.0
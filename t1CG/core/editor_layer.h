@@ -0,0 +1,204 @@
+/**
+ * @file editor_layer.h
+ * @brief Camada persistente (FBO + textura) com o conteúdo da área de desenho 2D
+ * @author Sistema de Computação Gráfica
+ * @date 2025
+ */
+
+#ifndef EDITOR_LAYER_H
+#define EDITOR_LAYER_H
+
+#include "damage_tracker.h"
+#include "shader_utils.h"
+#include "render_counters.h"
+#include <GL/gl.h>
+#include <vector>
+
+/**
+ * @class EditorLayer
+ * @brief Alvo de renderização do tamanho da janela com os polígonos do editor
+ *
+ * O back buffer do GLUT não tem conteúdo definido depois do swap, então os
+ * polígonos ficam nesta textura: a cada quadro só os retângulos danificados são
+ * limpos e redesenhados (com glScissor), e a camada inteira é copiada para a
+ * tela com um quad. A UI continua sendo desenhada por cima, como antes.
+ *
+ * A textura tem o tamanho da janela, então a projeção 2D da janela serve sem
+ * mudanças durante a atualização.
+ */
+class EditorLayer {
+private:
+    GLuint texture;
+    GLuint framebuffer;
+    int width, height;
+    bool contentValid; // Falso logo após (re)criar a textura
+    bool updating;
+    GLint previousFramebuffer;
+
+    bool ensureTarget(int targetWidth, int targetHeight) {
+        if (texture && width == targetWidth && height == targetHeight) {
+            return true;
+        }
+
+        if (!texture) {
+            glGenTextures(1, &texture);
+        }
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, targetWidth, targetHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        if (!framebuffer) {
+            glGenFramebuffers(1, &framebuffer);
+        }
+        GLint boundFramebuffer = 0;
+        glGetIntegerv(GL_FRAMEBUFFER_BINDING, &boundFramebuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+        bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+        glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(boundFramebuffer));
+
+        if (!complete) {
+            release();
+            return false;
+        }
+        width = targetWidth;
+        height = targetHeight;
+        contentValid = false;
+        return true;
+    }
+
+    void scissorTo(const ScreenRect& rect) const {
+        // glScissor conta Y de baixo para cima
+        glScissor(rect.minX, height - 1 - rect.maxY, rect.maxX - rect.minX + 1, rect.maxY - rect.minY + 1);
+    }
+
+public:
+    EditorLayer()
+        : texture(0), framebuffer(0), width(0), height(0), contentValid(false),
+          updating(false), previousFramebuffer(0) {}
+
+    ~EditorLayer() {
+        release();
+    }
+
+    EditorLayer(const EditorLayer&) = delete;
+    EditorLayer& operator=(const EditorLayer&) = delete;
+
+    /**
+     * @brief Garante a camada no tamanho da janela
+     * @return false se não houver FBO (desenhe tudo direto na tela a cada quadro)
+     */
+    bool prepare(int windowWidth, int windowHeight) {
+        if (!ShaderUtils::hasFramebufferObjects() || windowWidth <= 0 || windowHeight <= 0) {
+            return false;
+        }
+        return ensureTarget(windowWidth, windowHeight);
+    }
+
+    /**
+     * @brief Retângulos a redesenhar neste quadro, já recortados à camada; limpa o dano
+     *
+     * A camada inteira quando acabou de ser criada ou o dano é total.
+     */
+    std::vector<ScreenRect> takeDirtyRects(DamageTracker& damage) {
+        std::vector<ScreenRect> rects;
+        if (!contentValid || damage.isFull()) {
+            rects.push_back(ScreenRect(0, 0, width - 1, height - 1));
+        } else {
+            for (const ScreenRect& rect : damage.getRects()) {
+                ScreenRect visible = rect.clipped(width, height);
+                if (!visible.empty()) {
+                    rects.push_back(visible);
+                }
+            }
+        }
+        damage.clear();
+        contentValid = true;
+        return rects;
+    }
+
+    /**
+     * @brief Redireciona o desenho para a camada, com o scissor ligado
+     */
+    void beginUpdate() {
+        glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        glPushAttrib(GL_VIEWPORT_BIT | GL_SCISSOR_BIT);
+        glViewport(0, 0, width, height);
+        glEnable(GL_SCISSOR_TEST);
+        updating = true;
+    }
+
+    /**
+     * @brief Limita o desenho ao retângulo e o limpa com a cor de fundo
+     */
+    void beginRect(const ScreenRect& rect) const {
+        scissorTo(rect);
+        glClear(GL_COLOR_BUFFER_BIT);
+    }
+
+    /**
+     * @brief Limita o desenho ao retângulo sem limpá-lo (segunda passada sobre os mesmos retângulos)
+     */
+    void resumeRect(const ScreenRect& rect) const {
+        scissorTo(rect);
+    }
+
+    void endUpdate() {
+        if (!updating) {
+            return;
+        }
+        glPopAttrib();
+        glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previousFramebuffer));
+        updating = false;
+    }
+
+    /**
+     * @brief Copia a camada para a tela (opaca, sem blending)
+     *
+     * Espera a projeção 2D da janela (glOrtho com Y para baixo, em pixels).
+     */
+    void present() const {
+        if (!texture) {
+            return;
+        }
+
+        glPushAttrib(GL_COLOR_BUFFER_BIT | GL_ENABLE_BIT | GL_TEXTURE_BIT);
+        glDisable(GL_BLEND);
+        glEnable(GL_TEXTURE_2D);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+
+        // Linha 0 da textura é a base da janela
+        RenderCounters::add(RenderCounter::IMMEDIATE_BLOCKS);
+        RenderCounters::add(RenderCounter::TRIANGLES, 2);
+        glBegin(GL_QUADS);
+            glTexCoord2f(0.0f, 1.0f); glVertex2i(0, 0);
+            glTexCoord2f(1.0f, 1.0f); glVertex2i(width, 0);
+            glTexCoord2f(1.0f, 0.0f); glVertex2i(width, height);
+            glTexCoord2f(0.0f, 0.0f); glVertex2i(0, height);
+        glEnd();
+
+        glPopAttrib();
+    }
+
+    void release() {
+        if (framebuffer && ShaderUtils::hasFramebufferObjects()) {
+            glDeleteFramebuffers(1, &framebuffer);
+        }
+        if (texture) {
+            glDeleteTextures(1, &texture);
+        }
+        framebuffer = 0;
+        texture = 0;
+        width = 0;
+        height = 0;
+        contentValid = false;
+    }
+};
+
+#endif // EDITOR_LAYER_H
@@ -10,8 +10,10 @@
 #include "data_structures.h"
 #include "polygon_manager.h"
 #include "graphics_renderer.h"
+#include "frame_scheduler.h"
 #include <GL/glut.h>
 #include <iostream>
+#include <algorithm>
 
 enum class AppMode;
 
@@ -34,6 +36,14 @@ private:
     // Alvo de cor para modo 3D
     ColorTarget currentColorTarget;
 
+    // Arraste de polígono salvo (Ctrl + botão esquerdo)
+    PolygonPick dragTarget;
+    bool isDraggingWholePolygon;
+    Point2D lastDragPoint;
+
+    static const int VERTEX_PICK_TOLERANCE = 6;
+    static const int EDGE_PICK_TOLERANCE = 4;
+
 public:
     EventHandler(PolygonManager* polygonMgr, GraphicsRenderer* graphicsRend, ApplicationState* appState, 
                  WindowDimensions* windowDims, AppMode* mode = nullptr,
@@ -43,7 +53,8 @@ public:
           currentMode(mode), selectedColorIndex(12), windowDimensions(windowDims), needsRedraw(false),
           onLightingChange(lightingCb), onProjectionChange(projectionCb),
           onObjectColorChange(objectColorCb), onLightColorChange(lightColorCb),
-          currentColorTarget(ColorTarget::OBJECT) {
+          currentColorTarget(ColorTarget::OBJECT),
+          isDraggingWholePolygon(false) {
     }
     
     void updateWindowDimensions(WindowDimensions* newDimensions) {
@@ -78,7 +89,57 @@ public:
             }
         }
         
-        glutPostRedisplay();
+        FrameScheduler::getInstance().requestRedraw();
+    }
+
+    /**
+     * @brief Começa a arrastar o vértice salvo sob o cursor ou, na falta dele, o polígono da aresta
+     * @return true se algo foi pego
+     */
+    bool beginSavedPolygonDrag(int mouseX, int mouseY) {
+        Point2D point(mouseX, mouseY);
+        dragTarget = polygonManager->pickSavedVertex(point, VERTEX_PICK_TOLERANCE);
+        isDraggingWholePolygon = false;
+        if (!dragTarget.isValid()) {
+            dragTarget = polygonManager->pickSavedEdge(point, EDGE_PICK_TOLERANCE);
+            isDraggingWholePolygon = dragTarget.isValid();
+        }
+        lastDragPoint = point;
+        return dragTarget.isValid();
+    }
+
+    /**
+     * @brief Leva o vértice (ou o polígono inteiro) até o cursor, sem sair da área de desenho
+     * @return true se a geometria mudou
+     */
+    bool updateSavedPolygonDrag(int mouseX, int mouseY) {
+        if (!dragTarget.isValid() || !windowDimensions) {
+            return false;
+        }
+        Point2D point(std::min(std::max(mouseX, 0), windowDimensions->drawingAreaWidth - 1),
+                      std::min(std::max(mouseY, 0), windowDimensions->drawingAreaHeight - 1));
+        if (point == lastDragPoint) {
+            return false;
+        }
+
+        if (isDraggingWholePolygon) {
+            polygonManager->translateSavedPolygon(dragTarget.polygonIndex,
+                                                  point.coordinateX - lastDragPoint.coordinateX,
+                                                  point.coordinateY - lastDragPoint.coordinateY);
+        } else {
+            polygonManager->moveSavedVertex(dragTarget.polygonIndex, dragTarget.elementIndex, point);
+        }
+        lastDragPoint = point;
+        return true;
+    }
+
+    void endSavedPolygonDrag() {
+        dragTarget = PolygonPick();
+        isDraggingWholePolygon = false;
+    }
+
+    bool isDraggingSavedPolygon() const {
+        return dragTarget.isValid();
     }
 
     void handleKeyboardInput(char keyCode) {
@@ -110,6 +171,9 @@ public:
             case '1': case '2': case '3': case '4': case '5': case '6':
                 polygonManager->applyPresetFillColor(keyCode - '0');
                 break;
+            case 'b': case 'B':
+                graphicsRenderer->toggleBackend();
+                break;
             case 's': case 'S':
                 if (polygonManager->canBeFilled()) {
                     bool isFilled = (*currentApplicationState == ApplicationState::POLYGON_FILLED);
@@ -121,7 +185,7 @@ public:
                 break;
         }
         
-        glutPostRedisplay();
+        FrameScheduler::getInstance().requestRedraw();
     }
 
     void renderInterface() {
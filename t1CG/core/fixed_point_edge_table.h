@@ -0,0 +1,249 @@
+/**
+ * @file fixed_point_edge_table.h
+ * @brief AET em ponto fixo 16.16 com incremento e arredondamento vetorizados (SSE2/AVX2)
+ * @author Sistema de Preenchimento ET/AET
+ * @date 2025
+ */
+
+#ifndef FIXED_POINT_EDGE_TABLE_H
+#define FIXED_POINT_EDGE_TABLE_H
+
+#include "data_structures.h"
+#include "simd_utils.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+typedef int32_t Fixed16;
+
+const int FIXED_SHIFT = 16;
+const Fixed16 FIXED_ONE = 1 << FIXED_SHIFT;
+const Fixed16 FIXED_HALF = FIXED_ONE >> 1;
+
+// Maior coordenada (em pixels) representável sem overflow ao acumular X em 16.16
+const int FIXED_MAX_COORDINATE = 30000;
+
+/**
+ * @brief Converte um valor em ponto flutuante para 16.16 (arredondando)
+ */
+inline Fixed16 toFixed16(double value) {
+    return static_cast<Fixed16>(std::llround(value * FIXED_ONE));
+}
+
+/**
+ * @brief Avança X de todas as arestas: currentX[i] += stepX[i]
+ */
+inline void advanceFixedEdges(Fixed16* currentX, const Fixed16* stepX, size_t count) {
+    size_t index = 0;
+#if defined(CG_SIMD_AVX2)
+    for (; index + 8 <= count; index += 8) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(currentX + index));
+        __m256i step = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(stepX + index));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(currentX + index), _mm256_add_epi32(x, step));
+    }
+#endif
+#if defined(CG_SIMD_SSE2)
+    for (; index + 4 <= count; index += 4) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(currentX + index));
+        __m128i step = _mm_loadu_si128(reinterpret_cast<const __m128i*>(stepX + index));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(currentX + index), _mm_add_epi32(x, step));
+    }
+#endif
+    for (; index < count; ++index) {
+        currentX[index] += stepX[index];
+    }
+}
+
+/**
+ * @brief Converte X em 16.16 para os extremos inteiros dos spans
+ *
+ * Reproduz static_cast<int>(x + 0.5) da versão em double: soma meio pixel e
+ * trunca em direção ao zero (valores negativos recebem FIXED_ONE - 1 antes do shift).
+ */
+inline void roundFixedEdges(const Fixed16* currentX, int* roundedX, size_t count) {
+    size_t index = 0;
+#if defined(CG_SIMD_AVX2)
+    const __m256i half8 = _mm256_set1_epi32(FIXED_HALF);
+    const __m256i bias8 = _mm256_set1_epi32(FIXED_ONE - 1);
+    for (; index + 8 <= count; index += 8) {
+        __m256i x = _mm256_add_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(currentX + index)), half8);
+        __m256i negativeBias = _mm256_and_si256(_mm256_srai_epi32(x, 31), bias8);
+        x = _mm256_srai_epi32(_mm256_add_epi32(x, negativeBias), FIXED_SHIFT);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(roundedX + index), x);
+    }
+#endif
+#if defined(CG_SIMD_SSE2)
+    const __m128i half4 = _mm_set1_epi32(FIXED_HALF);
+    const __m128i bias4 = _mm_set1_epi32(FIXED_ONE - 1);
+    for (; index + 4 <= count; index += 4) {
+        __m128i x = _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(currentX + index)), half4);
+        __m128i negativeBias = _mm_and_si128(_mm_srai_epi32(x, 31), bias4);
+        x = _mm_srai_epi32(_mm_add_epi32(x, negativeBias), FIXED_SHIFT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(roundedX + index), x);
+    }
+#endif
+    for (; index < count; ++index) {
+        Fixed16 x = currentX[index] + FIXED_HALF;
+        if (x < 0) {
+            x += FIXED_ONE - 1;
+        }
+        roundedX[index] = x >> FIXED_SHIFT;
+    }
+}
+
+/**
+ * @class FixedPointActiveEdgeTable
+ * @brief AET em layout SoA (X, passo e Y máximo em vetores separados) para o kernel SIMD
+ */
+class FixedPointActiveEdgeTable {
+private:
+    std::vector<Fixed16> currentX;
+    std::vector<Fixed16> stepX;
+    std::vector<int> maximumY;
+    std::vector<int> roundedX;
+
+    struct PendingEdge {
+        Fixed16 currentX;
+        Fixed16 stepX;
+        int maximumY;
+    };
+    std::vector<PendingEdge> pendingEdges;
+
+    void swapEdges(size_t first, size_t second) {
+        std::swap(currentX[first], currentX[second]);
+        std::swap(stepX[first], stepX[second]);
+        std::swap(maximumY[first], maximumY[second]);
+    }
+
+public:
+    void reserve(size_t edgeCount) {
+        currentX.reserve(edgeCount);
+        stepX.reserve(edgeCount);
+        maximumY.reserve(edgeCount);
+        roundedX.resize(edgeCount);
+    }
+
+    size_t size() const {
+        return currentX.size();
+    }
+
+    bool empty() const {
+        return currentX.empty();
+    }
+
+    /**
+     * @brief Converte e insere as arestas que começam na scanline atual
+     *
+     * Pressupõe a AET já ordenada (restoreOrder): as arestas novas são ordenadas
+     * entre si e intercaladas de trás para frente, em O(E + k).
+     */
+    void insert(const EdgeData* newEdgesBegin, const EdgeData* newEdgesEnd) {
+        insertAtScanLine(newEdgesBegin, newEdgesEnd, INT_MIN);
+    }
+
+    /**
+     * @brief Insere arestas que começaram antes da scanline informada, já avançadas até ela
+     * @param scanLine Scanline atual; INT_MIN insere as arestas sem avançar
+     *
+     * O X é obtido por X0 + passo * (scanLine - minimumY) em inteiros, o que dá
+     * exatamente o mesmo valor de somar o passo scanline a scanline.
+     */
+    void insertAtScanLine(const EdgeData* newEdgesBegin, const EdgeData* newEdgesEnd, int scanLine) {
+        size_t newCount = static_cast<size_t>(newEdgesEnd - newEdgesBegin);
+        if (newCount == 0) {
+            return;
+        }
+        
+        pendingEdges.clear();
+        for (const EdgeData* edge = newEdgesBegin; edge != newEdgesEnd; ++edge) {
+            Fixed16 step = toFixed16(edge->inverseSlope);
+            Fixed16 x = toFixed16(edge->currentX);
+            if (scanLine != INT_MIN && scanLine > edge->minimumY) {
+                x = static_cast<Fixed16>(static_cast<uint32_t>(x) +
+                    static_cast<uint32_t>(static_cast<int64_t>(step) * (scanLine - edge->minimumY)));
+            }
+            pendingEdges.push_back(PendingEdge{ x, step, edge->maximumY });
+        }
+        std::sort(pendingEdges.begin(), pendingEdges.end(),
+            [](const PendingEdge& edge1, const PendingEdge& edge2) {
+                return edge1.currentX < edge2.currentX;
+            });
+        
+        size_t oldCount = currentX.size();
+        currentX.resize(oldCount + newCount);
+        stepX.resize(oldCount + newCount);
+        maximumY.resize(oldCount + newCount);
+        
+        size_t readOld = oldCount;
+        size_t readNew = newCount;
+        size_t write = oldCount + newCount;
+        while (readNew > 0) {
+            --write;
+            if (readOld > 0 && currentX[readOld - 1] > pendingEdges[readNew - 1].currentX) {
+                --readOld;
+                currentX[write] = currentX[readOld];
+                stepX[write] = stepX[readOld];
+                maximumY[write] = maximumY[readOld];
+            } else {
+                --readNew;
+                currentX[write] = pendingEdges[readNew].currentX;
+                stepX[write] = pendingEdges[readNew].stepX;
+                maximumY[write] = pendingEdges[readNew].maximumY;
+            }
+        }
+    }
+
+    /**
+     * @brief Insertion sort por X; linear quando nenhuma aresta cruzou outra
+     */
+    void restoreOrder() {
+        for (size_t edgeIndex = 1; edgeIndex < currentX.size(); ++edgeIndex) {
+            size_t insertIndex = edgeIndex;
+            while (insertIndex > 0 && currentX[insertIndex] < currentX[insertIndex - 1]) {
+                swapEdges(insertIndex, insertIndex - 1);
+                --insertIndex;
+            }
+        }
+    }
+
+    /**
+     * @brief Avança todas as arestas para a próxima scanline
+     */
+    void advance() {
+        advanceFixedEdges(currentX.data(), stepX.data(), currentX.size());
+    }
+
+    /**
+     * @brief Remove as arestas que terminam antes da scanline informada, preservando a ordem
+     */
+    void removeFinishedEdges(int scanLine) {
+        size_t keptCount = 0;
+        for (size_t edgeIndex = 0; edgeIndex < currentX.size(); ++edgeIndex) {
+            if (maximumY[edgeIndex] > scanLine) {
+                currentX[keptCount] = currentX[edgeIndex];
+                stepX[keptCount] = stepX[edgeIndex];
+                maximumY[keptCount] = maximumY[edgeIndex];
+                keptCount++;
+            }
+        }
+        currentX.resize(keptCount);
+        stepX.resize(keptCount);
+        maximumY.resize(keptCount);
+    }
+
+    /**
+     * @brief Calcula em lote os X inteiros de todas as arestas ativas
+     * @return Ponteiro para size() valores, válido até a próxima modificação da AET
+     */
+    const int* computeSpanEndpoints() {
+        if (roundedX.size() < currentX.size()) {
+            roundedX.resize(currentX.size());
+        }
+        roundFixedEdges(currentX.data(), roundedX.data(), currentX.size());
+        return roundedX.data();
+    }
+};
+
+#endif // FIXED_POINT_EDGE_TABLE_H
@@ -0,0 +1,457 @@
+/**
+ * @file frame_profiler.h
+ * @brief Tempo de CPU e de GPU por etapa do display(), com médias e percentis dos últimos quadros
+ * @author Sistema de Computação Gráfica
+ * @date 2025
+ */
+
+#ifndef FRAME_PROFILER_H
+#define FRAME_PROFILER_H
+
+#include "render_counters.h"
+#include "shader_utils.h"
+#include <GL/gl.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Etapas instrumentadas do display()
+ */
+enum class ProfileStage {
+    SAVED_POLYGONS = 0,   // Preenchimento e contorno dos polígonos salvos (2D)
+    CURRENT_POLYGON,      // Polígono em edição (2D)
+    UI,                   // UIManager::render
+    SCENE_3D,             // SceneManager::render
+    SWAP,                 // glutSwapBuffers
+    COUNT
+};
+
+/**
+ * @brief Média e percentis de uma série de tempos (ms)
+ */
+struct TimingSummary {
+    double average;
+    double median;
+    double percentile95;
+    double maximum;
+    int samples;
+
+    TimingSummary() : average(0.0), median(0.0), percentile95(0.0), maximum(0.0), samples(0) {}
+};
+
+/**
+ * @class FrameProfiler
+ * @brief Guarda, para cada um dos últimos HISTORY_SIZE quadros, o tempo de cada etapa e os RenderCounters
+ *
+ * A CPU é medida com high_resolution_clock. A GPU com uma consulta
+ * GL_TIME_ELAPSED por etapa, em QUERY_SETS conjuntos alternados: o resultado
+ * de um quadro só é lido quando seu conjunto volta a ser usado, dois quadros
+ * depois, e só se GL_QUERY_RESULT_AVAILABLE já diz que está pronto; caso
+ * contrário a amostra de GPU daquele quadro é descartada. Assim o profiler
+ * nunca espera pela GPU.
+ *
+ * Só uma consulta GL_TIME_ELAPSED pode estar ativa por vez, então etapas
+ * aninhadas medem só a CPU. Desligado (o padrão), cada escopo custa um teste.
+ */
+class FrameProfiler {
+public:
+    static const int STAGE_COUNT = static_cast<int>(ProfileStage::COUNT);
+    static const int COUNTER_COUNT = static_cast<int>(RenderCounter::COUNT);
+    static const int HISTORY_SIZE = 240;
+    static const int QUERY_SETS = 2;
+
+    /**
+     * @brief Um quadro; tempos negativos indicam etapa que não rodou (ou GPU sem resultado)
+     */
+    struct FrameRecord {
+        unsigned long frameNumber;
+        double frameCpuMs;
+        double cpuMs[STAGE_COUNT];
+        double gpuMs[STAGE_COUNT];
+        uint64_t counters[COUNTER_COUNT];
+    };
+
+private:
+    typedef std::chrono::high_resolution_clock Clock;
+
+    bool enabled;
+    bool queriesCreated;
+    GLuint queries[QUERY_SETS][STAGE_COUNT];
+    bool queryIssued[QUERY_SETS][STAGE_COUNT];
+    unsigned long queryFrame[QUERY_SETS];       // Quadro que usou cada conjunto
+    int activeGpuStage;                          // -1 se nenhuma consulta aberta
+
+    std::vector<FrameRecord> history;            // Anel indexado por frameNumber % HISTORY_SIZE
+    unsigned long frameNumber;                   // 0 = nenhum quadro ainda
+    unsigned long firstFrame;                    // Primeiro quadro desde que foi ligado
+    bool frameOpen;
+    Clock::time_point frameStart;
+    Clock::time_point stageStart[STAGE_COUNT];
+
+    FrameProfiler()
+        : enabled(false), queriesCreated(false), activeGpuStage(-1),
+          history(HISTORY_SIZE), frameNumber(0), firstFrame(1), frameOpen(false) {
+        for (int set = 0; set < QUERY_SETS; set++) {
+            queryFrame[set] = 0;
+            for (int stage = 0; stage < STAGE_COUNT; stage++) {
+                queries[set][stage] = 0;
+                queryIssued[set][stage] = false;
+            }
+        }
+    }
+
+    static double millisecondsBetween(Clock::time_point start, Clock::time_point end) {
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+    FrameRecord& recordOf(unsigned long frame) {
+        return history[frame % HISTORY_SIZE];
+    }
+
+    const FrameRecord& recordOf(unsigned long frame) const {
+        return history[frame % HISTORY_SIZE];
+    }
+
+    /**
+     * @brief Primeiro quadro ainda guardado no anel
+     */
+    unsigned long oldestFrame() const {
+        unsigned long oldest = frameNumber >= static_cast<unsigned long>(HISTORY_SIZE)
+                                   ? frameNumber - HISTORY_SIZE + 1 : 1;
+        return std::max(oldest, firstFrame);
+    }
+
+    /**
+     * @brief Lê (sem esperar) as consultas do conjunto antes de reutilizá-lo
+     */
+    void collectQuerySet(int set) {
+        unsigned long issuedFrame = queryFrame[set];
+        bool recordAlive = issuedFrame != 0 && issuedFrame >= oldestFrame();
+        for (int stage = 0; stage < STAGE_COUNT; stage++) {
+            if (!queryIssued[set][stage]) {
+                continue;
+            }
+            queryIssued[set][stage] = false;
+            GLint available = 0;
+            glGetQueryObjectiv(queries[set][stage], GL_QUERY_RESULT_AVAILABLE, &available);
+            if (available && recordAlive) {
+                uint64_t nanoseconds = 0;
+                glGetQueryObjectui64v(queries[set][stage], GL_QUERY_RESULT, &nanoseconds);
+                recordOf(issuedFrame).gpuMs[stage] = nanoseconds / 1.0e6;
+            }
+        }
+    }
+
+    static TimingSummary summarize(std::vector<double>& values) {
+        TimingSummary summary;
+        summary.samples = static_cast<int>(values.size());
+        if (values.empty()) {
+            return summary;
+        }
+        std::sort(values.begin(), values.end());
+        double total = 0.0;
+        for (double value : values) {
+            total += value;
+        }
+        size_t last = values.size() - 1;
+        summary.average = total / values.size();
+        summary.median = values[last / 2];
+        summary.percentile95 = values[static_cast<size_t>(last * 0.95 + 0.5)];
+        summary.maximum = values[last];
+        return summary;
+    }
+
+public:
+    static FrameProfiler& getInstance() {
+        static FrameProfiler instance;
+        return instance;
+    }
+
+    FrameProfiler(const FrameProfiler&) = delete;
+    FrameProfiler& operator=(const FrameProfiler&) = delete;
+
+    bool isEnabled() const { return enabled; }
+
+    /**
+     * @brief Liga ou desliga a coleta; ao ligar, o histórico recomeça
+     */
+    void setEnabled(bool value) {
+        if (value == enabled) {
+            return;
+        }
+        enabled = value;
+        if (enabled) {
+            firstFrame = frameNumber + 1;
+        } else {
+            if (activeGpuStage >= 0) {
+                glEndQuery(GL_TIME_ELAPSED);
+                activeGpuStage = -1;
+            }
+            for (int set = 0; set < QUERY_SETS; set++) {
+                for (int stage = 0; stage < STAGE_COUNT; stage++) {
+                    queryIssued[set][stage] = false;
+                }
+            }
+            frameOpen = false;
+        }
+    }
+
+    void toggle() { setEnabled(!enabled); }
+
+    /**
+     * @brief Abre o quadro: recolhe as consultas de dois quadros atrás e zera o registro
+     */
+    void beginFrame() {
+        if (!enabled) {
+            return;
+        }
+        if (!queriesCreated && ShaderUtils::hasTimerQueries()) {
+            glGenQueries(QUERY_SETS * STAGE_COUNT, &queries[0][0]);
+            queriesCreated = true;
+        }
+
+        frameNumber++;
+        int set = static_cast<int>(frameNumber % QUERY_SETS);
+        if (queriesCreated) {
+            collectQuerySet(set);
+        }
+        queryFrame[set] = frameNumber;
+
+        FrameRecord& record = recordOf(frameNumber);
+        record.frameNumber = frameNumber;
+        record.frameCpuMs = 0.0;
+        for (int stage = 0; stage < STAGE_COUNT; stage++) {
+            record.cpuMs[stage] = -1.0;
+            record.gpuMs[stage] = -1.0;
+        }
+        for (int counter = 0; counter < COUNTER_COUNT; counter++) {
+            record.counters[counter] = 0;
+        }
+        // O que foi contado fora de um quadro (extrusões, benchmarks) não entra no próximo
+        for (int counter = 0; counter < COUNTER_COUNT; counter++) {
+            RenderCounters::take(static_cast<RenderCounter>(counter));
+        }
+        frameOpen = true;
+        frameStart = Clock::now();
+    }
+
+    /**
+     * @brief Fecha o quadro: tempo total de CPU e contadores
+     */
+    void endFrame() {
+        if (!enabled || !frameOpen) {
+            return;
+        }
+        FrameRecord& record = recordOf(frameNumber);
+        record.frameCpuMs = millisecondsBetween(frameStart, Clock::now());
+        for (int counter = 0; counter < COUNTER_COUNT; counter++) {
+            record.counters[counter] = RenderCounters::take(static_cast<RenderCounter>(counter));
+        }
+        frameOpen = false;
+    }
+
+    void beginStage(ProfileStage stage) {
+        if (!enabled || !frameOpen) {
+            return;
+        }
+        int index = static_cast<int>(stage);
+        int set = static_cast<int>(frameNumber % QUERY_SETS);
+        if (queriesCreated && activeGpuStage < 0 && !queryIssued[set][index]) {
+            glBeginQuery(GL_TIME_ELAPSED, queries[set][index]);
+            activeGpuStage = index;
+        }
+        stageStart[index] = Clock::now();
+    }
+
+    void endStage(ProfileStage stage) {
+        if (!enabled || !frameOpen) {
+            return;
+        }
+        int index = static_cast<int>(stage);
+        double elapsed = millisecondsBetween(stageStart[index], Clock::now());
+        FrameRecord& record = recordOf(frameNumber);
+        record.cpuMs[index] = (record.cpuMs[index] < 0.0 ? 0.0 : record.cpuMs[index]) + elapsed;
+        if (activeGpuStage == index) {
+            glEndQuery(GL_TIME_ELAPSED);
+            queryIssued[static_cast<int>(frameNumber % QUERY_SETS)][index] = true;
+            activeGpuStage = -1;
+        }
+    }
+
+    /**
+     * @brief Quantos quadros completos há no histórico
+     */
+    int getSampleCount() const {
+        if (!enabled || frameNumber < firstFrame) {
+            return 0;
+        }
+        int count = static_cast<int>(frameNumber - oldestFrame() + 1);
+        return frameOpen ? count - 1 : count;
+    }
+
+    bool hasGpuTimings() const { return queriesCreated; }
+
+    /**
+     * @brief Estatísticas de CPU de uma etapa nos quadros em que ela rodou
+     */
+    TimingSummary getCpuSummary(ProfileStage stage) const {
+        return collectSummary(static_cast<int>(stage), false);
+    }
+
+    /**
+     * @brief Estatísticas de GPU de uma etapa nos quadros com resultado disponível
+     */
+    TimingSummary getGpuSummary(ProfileStage stage) const {
+        return collectSummary(static_cast<int>(stage), true);
+    }
+
+    /**
+     * @brief Estatísticas do tempo de CPU do quadro inteiro (beginFrame a endFrame)
+     */
+    TimingSummary getFrameSummary() const {
+        return collectSummary(-1, false);
+    }
+
+    /**
+     * @brief Média de um contador por quadro
+     */
+    double getCounterAverage(RenderCounter counter) const {
+        int samples = getSampleCount();
+        if (samples == 0) {
+            return 0.0;
+        }
+        double total = 0.0;
+        for (unsigned long frame = oldestFrame(); frame < oldestFrame() + samples; frame++) {
+            total += static_cast<double>(recordOf(frame).counters[static_cast<int>(counter)]);
+        }
+        return total / samples;
+    }
+
+    /**
+     * @brief Valor do contador no último quadro completo
+     */
+    uint64_t getLastCounter(RenderCounter counter) const {
+        int samples = getSampleCount();
+        if (samples == 0) {
+            return 0;
+        }
+        return recordOf(oldestFrame() + samples - 1).counters[static_cast<int>(counter)];
+    }
+
+    /**
+     * @brief Grava o histórico em CSV, um quadro por linha (etapa sem amostra fica vazia)
+     * @return false se o arquivo não pôde ser aberto ou não há amostras
+     */
+    bool writeCsv(const std::string& path) const {
+        int samples = getSampleCount();
+        if (samples == 0) {
+            return false;
+        }
+        FILE* file = std::fopen(path.c_str(), "w");
+        if (!file) {
+            return false;
+        }
+
+        std::fprintf(file, "quadro,quadro_cpu_ms");
+        for (int stage = 0; stage < STAGE_COUNT; stage++) {
+            const char* name = getStageName(static_cast<ProfileStage>(stage));
+            std::fprintf(file, ",%s_cpu_ms,%s_gpu_ms", name, name);
+        }
+        for (int counter = 0; counter < COUNTER_COUNT; counter++) {
+            std::fprintf(file, ",%s", getCounterColumn(static_cast<RenderCounter>(counter)));
+        }
+        std::fprintf(file, "\n");
+
+        for (unsigned long frame = oldestFrame(); frame < oldestFrame() + samples; frame++) {
+            const FrameRecord& record = recordOf(frame);
+            std::fprintf(file, "%lu,%.4f", record.frameNumber, record.frameCpuMs);
+            for (int stage = 0; stage < STAGE_COUNT; stage++) {
+                if (record.cpuMs[stage] >= 0.0) std::fprintf(file, ",%.4f", record.cpuMs[stage]);
+                else std::fprintf(file, ",");
+                if (record.gpuMs[stage] >= 0.0) std::fprintf(file, ",%.4f", record.gpuMs[stage]);
+                else std::fprintf(file, ",");
+            }
+            for (int counter = 0; counter < COUNTER_COUNT; counter++) {
+                std::fprintf(file, ",%llu", static_cast<unsigned long long>(record.counters[counter]));
+            }
+            std::fprintf(file, "\n");
+        }
+
+        std::fclose(file);
+        return true;
+    }
+
+    /**
+     * @brief Apaga as consultas (antes de destruir o contexto)
+     */
+    void release() {
+        setEnabled(false);
+        if (queriesCreated) {
+            glDeleteQueries(QUERY_SETS * STAGE_COUNT, &queries[0][0]);
+            queriesCreated = false;
+        }
+    }
+
+    static const char* getStageName(ProfileStage stage) {
+        switch (stage) {
+            case ProfileStage::SAVED_POLYGONS: return "poligonos_salvos";
+            case ProfileStage::CURRENT_POLYGON: return "poligono_atual";
+            case ProfileStage::UI: return "ui";
+            case ProfileStage::SCENE_3D: return "cena_3d";
+            case ProfileStage::SWAP: return "swap";
+            default: return "?";
+        }
+    }
+
+    static const char* getCounterColumn(RenderCounter counter) {
+        switch (counter) {
+            case RenderCounter::DRAW_CALLS: return "draw_calls";
+            case RenderCounter::IMMEDIATE_BLOCKS: return "blocos_glbegin";
+            case RenderCounter::TRIANGLES: return "triangulos";
+            case RenderCounter::SCANLINE_EDGES: return "arestas_et";
+            default: return "?";
+        }
+    }
+
+private:
+    TimingSummary collectSummary(int stage, bool gpu) const {
+        std::vector<double> values;
+        int samples = getSampleCount();
+        values.reserve(samples);
+        for (unsigned long frame = oldestFrame(); frame < oldestFrame() + samples; frame++) {
+            const FrameRecord& record = recordOf(frame);
+            double value = stage < 0 ? record.frameCpuMs : (gpu ? record.gpuMs[stage] : record.cpuMs[stage]);
+            if (value >= 0.0) {
+                values.push_back(value);
+            }
+        }
+        return summarize(values);
+    }
+};
+
+/**
+ * @class ProfileScope
+ * @brief Mede uma etapa do bloco em que é declarado
+ */
+class ProfileScope {
+private:
+    ProfileStage stage;
+
+public:
+    explicit ProfileScope(ProfileStage profiledStage) : stage(profiledStage) {
+        FrameProfiler::getInstance().beginStage(stage);
+    }
+
+    ~ProfileScope() {
+        FrameProfiler::getInstance().endStage(stage);
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+#endif // FRAME_PROFILER_H
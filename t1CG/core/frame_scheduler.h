@@ -0,0 +1,83 @@
+/**
+ * @file frame_scheduler.h
+ * @brief Agrupa pedidos de redesenho em um único frame, com limite de taxa de quadros
+ * @author Sistema de Computação Gráfica
+ * @date 2025
+ */
+
+#ifndef FRAME_SCHEDULER_H
+#define FRAME_SCHEDULER_H
+
+#include <GL/glut.h>
+#include <algorithm>
+
+/**
+ * @class FrameScheduler
+ * @brief Substitui glutPostRedisplay espalhado pelos callbacks por um pedido coalescido
+ *
+ * Quantos pedidos chegarem antes do próximo frame viram um só: o primeiro
+ * arma um glutTimerFunc para o instante em que o limite de FPS permite
+ * desenhar de novo, e os seguintes só marcam o pedido. Um display() que
+ * aconteça antes (exposição da janela, reshape) consome o pedido e o timer
+ * não posta nada.
+ */
+class FrameScheduler {
+private:
+    bool redrawPending;
+    bool timerArmed;
+    int lastFrameTime;      // ms (GLUT_ELAPSED_TIME) do último frame desenhado
+    int minimumFrameInterval;
+
+    FrameScheduler()
+        : redrawPending(false), timerArmed(false), lastFrameTime(-1000), minimumFrameInterval(16) {}
+
+    static void onTimer(int) {
+        FrameScheduler& scheduler = getInstance();
+        scheduler.timerArmed = false;
+        if (scheduler.redrawPending) {
+            glutPostRedisplay();
+        }
+    }
+
+public:
+    static FrameScheduler& getInstance() {
+        static FrameScheduler instance;
+        return instance;
+    }
+
+    FrameScheduler(const FrameScheduler&) = delete;
+    FrameScheduler& operator=(const FrameScheduler&) = delete;
+
+    /**
+     * @brief Limita a taxa de quadros (0 ou negativo desliga o limite)
+     */
+    void setFrameRateCap(int framesPerSecond) {
+        minimumFrameInterval = framesPerSecond > 0 ? 1000 / framesPerSecond : 0;
+    }
+
+    /**
+     * @brief Pede um novo frame; pedidos repetidos até o frame sair são ignorados
+     */
+    void requestRedraw() {
+        redrawPending = true;
+        if (timerArmed) {
+            return;
+        }
+        int now = glutGet(GLUT_ELAPSED_TIME);
+        int wait = std::max(0, lastFrameTime + minimumFrameInterval - now);
+        timerArmed = true;
+        glutTimerFunc(static_cast<unsigned int>(wait), onTimer, 0);
+    }
+
+    /**
+     * @brief Chamado no início do display(): o frame em andamento atende os pedidos pendentes
+     */
+    void beginFrame() {
+        redrawPending = false;
+        lastFrameTime = glutGet(GLUT_ELAPSED_TIME);
+    }
+
+    bool isRedrawPending() const { return redrawPending; }
+};
+
+#endif // FRAME_SCHEDULER_H
@@ -0,0 +1,121 @@
+/**
+ * @file frustum.h
+ * @brief Volumes envolventes (AABB + esfera) e teste contra os planos do frustum de visão
+ * @author Sistema de Computação Gráfica
+ * @date 2025
+ */
+
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include <cmath>
+#include <cstddef>
+
+/**
+ * @brief Caixa alinhada aos eixos e esfera envolvente, no espaço local do objeto
+ */
+struct BoundingVolume {
+    float minX, minY, minZ;
+    float maxX, maxY, maxZ;
+    float centerX, centerY, centerZ; // Centro da caixa (e da esfera)
+    float radius;                    // Meia diagonal da caixa
+    bool empty;
+
+    BoundingVolume()
+        : minX(0), minY(0), minZ(0), maxX(0), maxY(0), maxZ(0),
+          centerX(0), centerY(0), centerZ(0), radius(0), empty(true) {}
+
+    /**
+     * @brief Calcula caixa e esfera a partir de posições em arrays separados
+     */
+    static BoundingVolume fromPositions(const float* x, const float* y, const float* z, size_t count) {
+        BoundingVolume bounds;
+        if (count == 0) {
+            return bounds;
+        }
+        bounds.minX = bounds.maxX = x[0];
+        bounds.minY = bounds.maxY = y[0];
+        bounds.minZ = bounds.maxZ = z[0];
+        for (size_t i = 1; i < count; i++) {
+            bounds.minX = std::fmin(bounds.minX, x[i]); bounds.maxX = std::fmax(bounds.maxX, x[i]);
+            bounds.minY = std::fmin(bounds.minY, y[i]); bounds.maxY = std::fmax(bounds.maxY, y[i]);
+            bounds.minZ = std::fmin(bounds.minZ, z[i]); bounds.maxZ = std::fmax(bounds.maxZ, z[i]);
+        }
+        bounds.centerX = (bounds.minX + bounds.maxX) * 0.5f;
+        bounds.centerY = (bounds.minY + bounds.maxY) * 0.5f;
+        bounds.centerZ = (bounds.minZ + bounds.maxZ) * 0.5f;
+        float halfX = bounds.maxX - bounds.centerX;
+        float halfY = bounds.maxY - bounds.centerY;
+        float halfZ = bounds.maxZ - bounds.centerZ;
+        bounds.radius = std::sqrt(halfX * halfX + halfY * halfY + halfZ * halfZ);
+        bounds.empty = false;
+        return bounds;
+    }
+};
+
+/**
+ * @class ViewFrustum
+ * @brief Seis planos (esquerda, direita, baixo, cima, perto, longe) extraídos de projeção * modelview
+ *
+ * Extração de Gribb/Hartmann: cada plano é a soma ou diferença da quarta linha
+ * da matriz de recorte com uma das três primeiras. Com a modelview contendo só
+ * a câmera (gluLookAt), os planos ficam em coordenadas de mundo.
+ */
+class ViewFrustum {
+private:
+    float planes[6][4]; // a, b, c, d normalizados: a*x + b*y + c*z + d >= 0 dentro
+
+public:
+    ViewFrustum() {
+        // Sem matrizes ainda: planos que aceitam tudo
+        for (int plane = 0; plane < 6; plane++) {
+            planes[plane][0] = planes[plane][1] = planes[plane][2] = 0.0f;
+            planes[plane][3] = 1.0f;
+        }
+    }
+
+    /**
+     * @brief Extrai os planos de matrizes 4x4 em ordem de colunas (como glGetFloatv)
+     */
+    void extract(const float projection[16], const float modelview[16]) {
+        float clip[16];
+        for (int column = 0; column < 4; column++) {
+            for (int row = 0; row < 4; row++) {
+                clip[column * 4 + row] = projection[0 * 4 + row] * modelview[column * 4 + 0] +
+                                         projection[1 * 4 + row] * modelview[column * 4 + 1] +
+                                         projection[2 * 4 + row] * modelview[column * 4 + 2] +
+                                         projection[3 * 4 + row] * modelview[column * 4 + 3];
+            }
+        }
+
+        for (int plane = 0; plane < 6; plane++) {
+            int row = plane / 2;                      // 0: x, 1: y, 2: z
+            float sign = (plane % 2 == 0) ? 1.0f : -1.0f;
+            for (int component = 0; component < 4; component++) {
+                planes[plane][component] = clip[component * 4 + 3] + sign * clip[component * 4 + row];
+            }
+            float length = std::sqrt(planes[plane][0] * planes[plane][0] +
+                                     planes[plane][1] * planes[plane][1] +
+                                     planes[plane][2] * planes[plane][2]);
+            if (length > 0.0f) {
+                for (int component = 0; component < 4; component++) {
+                    planes[plane][component] /= length;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Verifica se a esfera (em coordenadas de mundo) toca o frustum
+     */
+    bool intersectsSphere(float x, float y, float z, float radius) const {
+        for (int plane = 0; plane < 6; plane++) {
+            if (planes[plane][0] * x + planes[plane][1] * y + planes[plane][2] * z + planes[plane][3] < -radius) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+#endif // FRUSTUM_H
@@ -0,0 +1,125 @@
+/**
+ * @file gl_state_cache.h
+ * @brief Cache do estado OpenGL usado pela cena 3D, para não repetir chamadas sem efeito
+ * @author Sistema de Computação Gráfica
+ * @date 2025
+ */
+
+#ifndef GL_STATE_CACHE_H
+#define GL_STATE_CACHE_H
+
+#include <GL/gl.h>
+#include "shader_utils.h"
+
+/**
+ * @class GLStateCache
+ * @brief Guarda o último valor enviado de algumas capacidades, do modelo de sombreamento e do programa
+ *
+ * Só funciona se todo código que altera esses estados passar por aqui. Depois
+ * de algo que os mude por fora (glPopAttrib de GL_ENABLE_BIT empilhado antes
+ * de uma mudança pelo cache, troca de contexto), chame invalidate().
+ */
+class GLStateCache {
+private:
+    enum TrackedCapability {
+        CAP_LIGHTING,
+        CAP_LIGHT0,
+        CAP_DEPTH_TEST,
+        CAP_NORMALIZE,
+        CAP_COUNT
+    };
+
+    enum KnownState : signed char {
+        STATE_UNKNOWN = -1,
+        STATE_DISABLED = 0,
+        STATE_ENABLED = 1
+    };
+
+    KnownState capabilities[CAP_COUNT];
+    GLenum shadeModel;     // 0: desconhecido
+    GLuint program;
+    bool programKnown;
+
+    GLStateCache() {
+        invalidate();
+    }
+
+    static int indexOf(GLenum capability) {
+        switch (capability) {
+            case GL_LIGHTING: return CAP_LIGHTING;
+            case GL_LIGHT0: return CAP_LIGHT0;
+            case GL_DEPTH_TEST: return CAP_DEPTH_TEST;
+            case GL_NORMALIZE: return CAP_NORMALIZE;
+            default: return -1;
+        }
+    }
+
+    void setCapability(GLenum capability, bool enabled) {
+        int index = indexOf(capability);
+        KnownState wanted = enabled ? STATE_ENABLED : STATE_DISABLED;
+        if (index >= 0 && capabilities[index] == wanted) {
+            return;
+        }
+        if (enabled) {
+            glEnable(capability);
+        } else {
+            glDisable(capability);
+        }
+        if (index >= 0) {
+            capabilities[index] = wanted;
+        }
+    }
+
+public:
+    static GLStateCache& getInstance() {
+        static GLStateCache instance;
+        return instance;
+    }
+
+    GLStateCache(const GLStateCache&) = delete;
+    GLStateCache& operator=(const GLStateCache&) = delete;
+
+    /**
+     * @brief glEnable, ignorado se a capacidade já estiver ligada (capacidades não rastreadas passam direto)
+     */
+    void enable(GLenum capability) { setCapability(capability, true); }
+
+    /**
+     * @brief glDisable, ignorado se a capacidade já estiver desligada
+     */
+    void disable(GLenum capability) { setCapability(capability, false); }
+
+    void setShadeModel(GLenum mode) {
+        if (shadeModel == mode) {
+            return;
+        }
+        glShadeModel(mode);
+        shadeModel = mode;
+    }
+
+    /**
+     * @brief glUseProgram, ignorado se o programa já estiver em uso ou sem suporte a shaders
+     */
+    void useProgram(GLuint newProgram) {
+        if (!glUseProgram || (programKnown && program == newProgram)) {
+            return;
+        }
+        glUseProgram(newProgram);
+        program = newProgram;
+        programKnown = true;
+    }
+
+    /**
+     * @brief Esquece tudo: a próxima chamada de cada estado sempre chega ao driver
+     */
+    void invalidate() {
+        for (int index = 0; index < CAP_COUNT; ++index) {
+            capabilities[index] = STATE_UNKNOWN;
+        }
+        shadeModel = 0;
+        program = 0;
+        programKnown = false;
+    }
+};
+
+#endif // GL_STATE_CACHE_H
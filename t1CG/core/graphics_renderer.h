@@ -13,16 +13,132 @@
 #include "data_structures.h"
 #include "polygon_fill_algorithm.h"
 #include "polygon_manager.h"
+#include "software_framebuffer.h"
+#include "parallel_scanline_fill.h"
+#include "render_counters.h"
+#include "damage_tracker.h"
+#include <algorithm>
 #include <string>
 #include <GL/glut.h>
 #include <GL/gl.h>
 
+/**
+ * @enum RenderBackend
+ * @brief Caminho usado para desenhar o preenchimento dos polígonos salvos
+ */
+enum class RenderBackend {
+    IMMEDIATE_MODE,               // Spans enviados como GL_LINES
+    SOFTWARE_FRAMEBUFFER,         // Spans rasterizados na CPU e enviados como uma textura por frame
+    SOFTWARE_FRAMEBUFFER_PARALLEL // Igual ao anterior, com a rasterização dividida em faixas entre threads
+};
+
+/**
+ * @brief Sink do laço ET/AET que emite os spans como GL_LINES em um único bloco glBegin/glEnd
+ *
+ * O bloco fica aberto enquanto o sink existir; nenhuma outra chamada GL deve
+ * acontecer nesse intervalo.
+ */
+class GLLineSpanSink {
+public:
+    explicit GLLineSpanSink(const ColorRGB& fillColor) {
+        glColor3f(fillColor.redComponent, fillColor.greenComponent, fillColor.blueComponent);
+        RenderCounters::add(RenderCounter::IMMEDIATE_BLOCKS);
+        glBegin(GL_LINES);
+    }
+
+    ~GLLineSpanSink() {
+        glEnd();
+    }
+
+    GLLineSpanSink(const GLLineSpanSink&) = delete;
+    GLLineSpanSink& operator=(const GLLineSpanSink&) = delete;
+
+    // Spans de um pixel (aresta ímpar) também viram uma linha [x, x + 1]
+    void span(int y, int xStart, int xEnd) {
+        glVertex2i(xStart, y);
+        glVertex2i(xEnd + 1, y);
+    }
+};
+
 class GraphicsRenderer {
 private:
     PolygonFillAlgorithm fillAlgorithm;
+    ParallelScanlineFill parallelFill;
+    RenderBackend backend;
+    SoftwareFramebuffer framebuffer;
+    unsigned long rasterizedRevision; // Revisão dos polígonos salvos presente no framebuffer
+    bool hasRasterizedRevision;
+
+    /**
+     * @brief Rasteriza os preenchimentos na CPU (só quando a cena muda) e desenha a textura
+     */
+    void renderSavedFillsToFramebuffer(const std::vector<PolygonManager::SavedPolygon>& savedPolygons,
+                                       int maxHeight,
+                                       int maxWidth,
+                                       unsigned long revision) {
+        bool resized = framebuffer.resize(maxWidth, maxHeight);
+        
+        if (resized || !hasRasterizedRevision || revision != rasterizedRevision) {
+            framebuffer.clear();
+            if (backend == RenderBackend::SOFTWARE_FRAMEBUFFER_PARALLEL) {
+                parallelFill.rasterize(savedPolygons, framebuffer, maxHeight, maxWidth);
+            } else {
+                for (const auto& savedPolygon : savedPolygons) {
+                    if (!savedPolygon.isFilled) {
+                        continue;
+                    }
+                    uint32_t color = SoftwareFramebuffer::packColor(savedPolygon.configuration.fillColor);
+                    if (savedPolygon.hasSpanCache(maxHeight, maxWidth)) {
+                        framebuffer.fillSpans(savedPolygon.fillSpans, color);
+                    } else {
+                        FramebufferSpanSink sink(framebuffer, color);
+                        fillAlgorithm.scanPolygon(savedPolygon.vertices, maxHeight, maxWidth, sink);
+                    }
+                }
+            }
+            rasterizedRevision = revision;
+            hasRasterizedRevision = true;
+        }
+        
+        framebuffer.upload();
+        framebuffer.draw();
+    }
 
 public:
-    GraphicsRenderer() {}
+    GraphicsRenderer()
+        : fillAlgorithm(AETOrderingMode::INCREMENTAL, EdgeSteppingMode::FLOATING_POINT),
+          parallelFill(AETOrderingMode::INCREMENTAL, EdgeSteppingMode::FIXED_POINT),
+          backend(RenderBackend::IMMEDIATE_MODE),
+          rasterizedRevision(0), hasRasterizedRevision(false) {}
+
+    /**
+     * @brief Define o backend de preenchimento dos polígonos salvos
+     */
+    void setBackend(RenderBackend newBackend) {
+        backend = newBackend;
+        hasRasterizedRevision = false;
+    }
+
+    RenderBackend getBackend() const {
+        return backend;
+    }
+
+    /**
+     * @brief Alterna em ciclo: modo imediato, framebuffer em CPU, framebuffer em CPU paralelo
+     */
+    void toggleBackend() {
+        switch (backend) {
+            case RenderBackend::IMMEDIATE_MODE:
+                setBackend(RenderBackend::SOFTWARE_FRAMEBUFFER);
+                break;
+            case RenderBackend::SOFTWARE_FRAMEBUFFER:
+                setBackend(RenderBackend::SOFTWARE_FRAMEBUFFER_PARALLEL);
+                break;
+            default:
+                setBackend(RenderBackend::IMMEDIATE_MODE);
+                break;
+        }
+    }
 
     void renderPolygon(const std::vector<Point2D>& polygonVertices, 
                       const PolygonConfiguration& configuration,
@@ -34,6 +150,7 @@ public:
         glColor3f(configuration.lineColor.redComponent, configuration.lineColor.greenComponent, configuration.lineColor.blueComponent);
         glLineWidth(configuration.lineThickness);
         
+        RenderCounters::add(RenderCounter::IMMEDIATE_BLOCKS);
         glBegin(isPolygonClosed ? GL_LINE_LOOP : GL_LINE_STRIP);
         // Garante que a cor da linha seja aplicada
         glColor3f(configuration.lineColor.redComponent, configuration.lineColor.greenComponent, configuration.lineColor.blueComponent);
@@ -52,8 +169,9 @@ public:
         }
         
         glColor3f(1.0f, 1.0f, 0.0f);
-        glPointSize(6.0f);
+        glPointSize(VERTEX_MARKER_SIZE);
         
+        RenderCounters::add(RenderCounter::IMMEDIATE_BLOCKS);
         glBegin(GL_POINTS);
         for (const Point2D& vertex : polygonVertices) {
             glVertex2i(vertex.coordinateX, vertex.coordinateY);
@@ -71,7 +189,32 @@ public:
             return;
         }
         
-        fillAlgorithm.fillPolygon(polygonVertices, fillColor, maxHeight, maxWidth);
+        GLLineSpanSink sink(fillColor);
+        fillAlgorithm.scanPolygon(polygonVertices, maxHeight, maxWidth, sink);
+    }
+
+    /**
+     * @brief Desenha uma lista de spans pré-calculada (cache dos polígonos salvos)
+     * @param clip Se informado, só as linhas [clip->minY, clip->maxY] são enviadas
+     */
+    void drawSpans(const SpanList& spans, const ColorRGB& fillColor, const ScreenRect* clip = nullptr) const {
+        const Span* first = spans.data();
+        const Span* last = spans.data() + spans.size();
+        if (clip) {
+            // Spans estão em ordem crescente de Y
+            first = std::lower_bound(first, last, clip->minY,
+                [](const Span& span, int scanLine) { return span.y < scanLine; });
+            last = std::upper_bound(first, last, clip->maxY,
+                [](int scanLine, const Span& span) { return scanLine < span.y; });
+        }
+        if (first == last) {
+            return;
+        }
+        
+        GLLineSpanSink sink(fillColor);
+        for (const Span* span = first; span != last; ++span) {
+            sink.span(span->y, span->xStart, span->xEnd);
+        }
     }
 
     // renderText removed
@@ -85,14 +228,50 @@ public:
 
     // UI Rendering methods removed (Migrated to Qt)
 
+    /**
+     * @brief Desenha os polígonos salvos
+     * @param revision Revisão dos polígonos salvos (PolygonManager::getSavedPolygonsRevision);
+     *        permite ao backend de framebuffer pular a rasterização quando nada mudou
+     *
+     * Nos backends SOFTWARE_FRAMEBUFFER* todos os preenchimentos ficam em uma única
+     * textura, desenhada antes de contornos e vértices.
+     *
+     * @param clip Se informado (redesenho parcial sob glScissor), polígonos cuja caixa
+     *        não toca o retângulo são pulados e os spans ficam nas linhas dele
+     */
     void renderSavedPolygons(const std::vector<PolygonManager::SavedPolygon>& savedPolygons, 
                            int maxHeight, 
-                           int maxWidth) const {
+                           int maxWidth,
+                           unsigned long revision,
+                           const ScreenRect* clip = nullptr) {
+        auto outsideClip = [clip](const PolygonManager::SavedPolygon& savedPolygon) {
+            return clip && !savedPolygon.bounds.expanded(PolygonManager::damagePadding(savedPolygon.configuration)).intersects(*clip);
+        };
+        
+        if (backend != RenderBackend::IMMEDIATE_MODE) {
+            renderSavedFillsToFramebuffer(savedPolygons, maxHeight, maxWidth, revision);
+            for (const auto& savedPolygon : savedPolygons) {
+                if (outsideClip(savedPolygon)) {
+                    continue;
+                }
+                renderPolygon(savedPolygon.vertices, savedPolygon.configuration, true);
+                renderPolygonVertices(savedPolygon.vertices, savedPolygon.configuration.showVertices);
+            }
+            return;
+        }
+        
         for (const auto& savedPolygon : savedPolygons) {
+            if (outsideClip(savedPolygon)) {
+                continue;
+            }
             renderPolygon(savedPolygon.vertices, savedPolygon.configuration, true);
             
             if (savedPolygon.isFilled) {
-                fillPolygon(savedPolygon.vertices, savedPolygon.configuration.fillColor, maxHeight, maxWidth);
+                if (savedPolygon.hasSpanCache(maxHeight, maxWidth)) {
+                    drawSpans(savedPolygon.fillSpans, savedPolygon.configuration.fillColor, clip);
+                } else {
+                    fillPolygon(savedPolygon.vertices, savedPolygon.configuration.fillColor, maxHeight, maxWidth);
+                }
             }
             
             renderPolygonVertices(savedPolygon.vertices, savedPolygon.configuration.showVertices);
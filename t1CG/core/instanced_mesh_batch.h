@@ -0,0 +1,186 @@
+/**
+ * @file instanced_mesh_batch.h
+ * @brief Várias cópias de uma mesma malha, com matriz e cor por cópia, em um único draw
+ * @author Sistema de Computação Gráfica
+ * @date 2025
+ */
+
+#ifndef INSTANCED_MESH_BATCH_H
+#define INSTANCED_MESH_BATCH_H
+
+#include <cmath>
+#include <vector>
+#include <GL/gl.h>
+#include "data_structures.h"
+#include "gl_state_cache.h"
+#include "object_3d.h"
+#include "shader_utils.h"
+
+/**
+ * @brief Programa instanciado já linkado e os locais dos seus atributos por cópia
+ */
+struct InstancedProgram {
+    GLuint program;
+    GLint transformLocation;
+    GLint colorLocation;
+
+    InstancedProgram() : program(0), transformLocation(-1), colorLocation(-1) {}
+
+    bool isValid() const {
+        return program && transformLocation >= 0 && colorLocation >= 0;
+    }
+};
+
+/**
+ * @class InstancedMeshBatch
+ * @brief Lista de cópias (InstanceData) de um Object3D e o VBO que as leva para a GPU
+ *
+ * Com instancing disponível, desenha todas as cópias com um
+ * glDrawElementsInstanced; sem ele, recorre a um laço de glMultMatrixf e
+ * Object3D::draw com o material trocado por cópia.
+ */
+class InstancedMeshBatch {
+private:
+    Object3D* mesh; // Sem posse
+    std::vector<InstanceData> instances;
+    GLuint instanceBuffer;
+    bool instancesDirty;
+
+    /**
+     * @brief c = a * b para matrizes 3x3 em ordem de linhas
+     */
+    static void multiply3x3(const float a[9], const float b[9], float c[9]) {
+        for (int row = 0; row < 3; row++) {
+            for (int column = 0; column < 3; column++) {
+                c[row * 3 + column] = a[row * 3 + 0] * b[0 * 3 + column] +
+                                      a[row * 3 + 1] * b[1 * 3 + column] +
+                                      a[row * 3 + 2] * b[2 * 3 + column];
+            }
+        }
+    }
+
+    void uploadInstances() {
+        if (!instanceBuffer) {
+            glGenBuffers(1, &instanceBuffer);
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+        glBufferData(GL_ARRAY_BUFFER, instances.size() * sizeof(InstanceData), instances.data(), GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        instancesDirty = false;
+    }
+
+    void drawLoop(MeshVariant variant) {
+        // GL_LIGHTING_BIT guarda o material da cena, trocado a cada cópia
+        glPushAttrib(GL_LIGHTING_BIT);
+        for (const InstanceData& instance : instances) {
+            GLfloat ambient[] = { instance.color[0] * 0.3f, instance.color[1] * 0.3f, instance.color[2] * 0.3f, instance.color[3] };
+            glMaterialfv(GL_FRONT, GL_AMBIENT, ambient);
+            glMaterialfv(GL_FRONT, GL_DIFFUSE, instance.color);
+
+            glPushMatrix();
+            glMultMatrixf(instance.transform);
+            mesh->draw(variant);
+            glPopMatrix();
+        }
+        glPopAttrib();
+    }
+
+public:
+    explicit InstancedMeshBatch(Object3D* object = nullptr)
+        : mesh(object), instanceBuffer(0), instancesDirty(true) {}
+
+    ~InstancedMeshBatch() {
+        if (instanceBuffer && ShaderUtils::hasBufferObjects()) {
+            glDeleteBuffers(1, &instanceBuffer);
+        }
+    }
+
+    // O VBO de instâncias pertence a um único lote
+    InstancedMeshBatch(const InstancedMeshBatch&) = delete;
+    InstancedMeshBatch& operator=(const InstancedMeshBatch&) = delete;
+
+    void setMesh(Object3D* object) { mesh = object; }
+    Object3D* getMesh() const { return mesh; }
+    size_t size() const { return instances.size(); }
+
+    void reserve(size_t instanceCount) {
+        instances.reserve(instanceCount);
+    }
+
+    void clear() {
+        instances.clear();
+        instancesDirty = true;
+    }
+
+    /**
+     * @brief Adiciona uma cópia com a mesma convenção de Object3D::draw
+     * @param position Translação
+     * @param rotation Ângulos de Euler em graus, aplicados como glRotatef em X, Y e Z
+     * @param scale Escala por eixo
+     * @param color Cor difusa (a ambiente é 30% dela, como o material da cena)
+     */
+    void addInstance(const Vector3D& position, const Vector3D& rotation, const Vector3D& scale,
+                     const ColorRGB& color) {
+        const float degreesToRadians = 3.14159265f / 180.0f;
+        float cx = std::cos(rotation.x * degreesToRadians), sx = std::sin(rotation.x * degreesToRadians);
+        float cy = std::cos(rotation.y * degreesToRadians), sy = std::sin(rotation.y * degreesToRadians);
+        float cz = std::cos(rotation.z * degreesToRadians), sz = std::sin(rotation.z * degreesToRadians);
+
+        const float rotationX[9] = { 1, 0, 0,   0, cx, -sx,   0, sx, cx };
+        const float rotationY[9] = { cy, 0, sy,   0, 1, 0,   -sy, 0, cy };
+        const float rotationZ[9] = { cz, -sz, 0,   sz, cz, 0,   0, 0, 1 };
+        float rotationXY[9], rotationXYZ[9];
+        multiply3x3(rotationX, rotationY, rotationXY);
+        multiply3x3(rotationXY, rotationZ, rotationXYZ);
+
+        // M = T * Rx * Ry * Rz * S, em ordem de colunas
+        InstanceData instance;
+        const float axisScale[3] = { scale.x, scale.y, scale.z };
+        for (int column = 0; column < 3; column++) {
+            for (int row = 0; row < 3; row++) {
+                instance.transform[column * 4 + row] = rotationXYZ[row * 3 + column] * axisScale[column];
+            }
+            instance.transform[column * 4 + 3] = 0.0f;
+        }
+        instance.transform[12] = position.x;
+        instance.transform[13] = position.y;
+        instance.transform[14] = position.z;
+        instance.transform[15] = 1.0f;
+
+        instance.color[0] = color.redComponent;
+        instance.color[1] = color.greenComponent;
+        instance.color[2] = color.blueComponent;
+        instance.color[3] = 1.0f;
+
+        instances.push_back(instance);
+        instancesDirty = true;
+    }
+
+    /**
+     * @brief Desenha todas as cópias
+     * @param variant Malha a usar (SMOOTH ou FLAT)
+     * @param program Programa instanciado; inválido força o laço de compatibilidade
+     *
+     * Deixa o programa 0 em uso ao final do caminho instanciado.
+     */
+    void draw(MeshVariant variant, const InstancedProgram& program) {
+        if (!mesh || instances.empty()) {
+            return;
+        }
+
+        if (!program.isValid() || !ShaderUtils::hasInstancing()) {
+            drawLoop(variant);
+            return;
+        }
+
+        if (instancesDirty) {
+            uploadInstances();
+        }
+        GLStateCache::getInstance().useProgram(program.program);
+        mesh->drawInstanced(variant, instanceBuffer, static_cast<GLsizei>(instances.size()),
+                            program.transformLocation, program.colorLocation);
+        GLStateCache::getInstance().useProgram(0);
+    }
+};
+
+#endif // INSTANCED_MESH_BATCH_H
@@ -0,0 +1,172 @@
+/**
+ * @file mesh_build_pipeline.h
+ * @brief Construção de malhas extrudadas em threads de trabalho, fora da thread do GLUT
+ * @author Sistema de Computação Gráfica
+ * @date 2025
+ */
+
+#ifndef MESH_BUILD_PIPELINE_H
+#define MESH_BUILD_PIPELINE_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "data_structures.h"
+#include "object_3d.h"
+#include "thread_utils.h"
+
+/**
+ * @brief Polígono 2D a ser extrudado, com uma identidade estável entre sincronizações
+ *
+ * Guarda uma cópia dos vértices: é o snapshot que segue para as threads de trabalho.
+ */
+struct ExtrusionSource {
+    unsigned long sourceId;
+    std::vector<Point2D> vertices;
+    float depth;
+
+    ExtrusionSource(unsigned long id, const std::vector<Point2D>& verts, float extrusionDepth)
+        : sourceId(id), vertices(verts), depth(extrusionDepth) {}
+};
+
+/**
+ * @class MeshBuildPipeline
+ * @brief Fila de extrusões processada por um pool de threads
+ *
+ * As threads só montam a geometria na CPU (triangulação, vértices, normais e
+ * variantes da malha); o upload para a GPU acontece na thread principal, no
+ * primeiro draw. Cada pedido carrega uma geração: resultados de gerações
+ * antigas continuam sendo entregues e cabe ao chamador descartá-los.
+ */
+class MeshBuildPipeline {
+public:
+    typedef std::unique_ptr<Object3D> (*BuildFunction)(const std::vector<Point2D>& vertices2D, float depth);
+
+    struct BuildResult {
+        unsigned long generation;
+        unsigned long sourceId;
+        uint64_t contentHash;
+        std::unique_ptr<Object3D> object;
+    };
+
+private:
+    struct BuildJob {
+        unsigned long generation;
+        uint64_t contentHash;
+        ExtrusionSource source;
+    };
+
+    BuildFunction buildFunction;
+    unsigned threadCount;
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable jobAvailable;
+    std::deque<BuildJob> queuedJobs;
+    std::vector<BuildResult> completedResults;
+    size_t jobsInFlight; // Na fila ou sendo processados
+    bool stopping;
+
+    void workerLoop() {
+        for (;;) {
+            std::unique_lock<std::mutex> lock(mutex);
+            jobAvailable.wait(lock, [this] { return stopping || !queuedJobs.empty(); });
+            if (stopping) {
+                return;
+            }
+            BuildJob job = std::move(queuedJobs.front());
+            queuedJobs.pop_front();
+            lock.unlock();
+
+            std::unique_ptr<Object3D> obj = buildFunction(job.source.vertices, job.source.depth);
+
+            lock.lock();
+            completedResults.push_back(BuildResult{ job.generation, job.source.sourceId, job.contentHash, std::move(obj) });
+            jobsInFlight--;
+        }
+    }
+
+    void startWorkers() {
+        while (workers.size() < threadCount) {
+            workers.emplace_back(&MeshBuildPipeline::workerLoop, this);
+        }
+    }
+
+public:
+    /**
+     * @param function Função (sem estado, segura para threads) que monta um objeto
+     * @param workerCount Threads de trabalho; 0 usa os núcleos disponíveis menos a thread do GLUT
+     */
+    explicit MeshBuildPipeline(BuildFunction function, unsigned workerCount = 0)
+        : buildFunction(function),
+          threadCount(workerCount ? workerCount
+                                  : (getWorkerThreadCount() > 1 ? getWorkerThreadCount() - 1 : 1)),
+          jobsInFlight(0), stopping(false) {}
+
+    ~MeshBuildPipeline() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        jobAvailable.notify_all();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    MeshBuildPipeline(const MeshBuildPipeline&) = delete;
+    MeshBuildPipeline& operator=(const MeshBuildPipeline&) = delete;
+
+    /**
+     * @brief Enfileira a extrusão de uma fonte (as threads são criadas no primeiro pedido)
+     */
+    void submit(unsigned long generation, const ExtrusionSource& source, uint64_t contentHash) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            startWorkers();
+            queuedJobs.push_back(BuildJob{ generation, contentHash, source });
+            jobsInFlight++;
+        }
+        jobAvailable.notify_one();
+    }
+
+    /**
+     * @brief Remove da fila os pedidos de gerações anteriores que ainda não começaram
+     */
+    void discardQueuedBefore(unsigned long generation) {
+        std::lock_guard<std::mutex> lock(mutex);
+        size_t before = queuedJobs.size();
+        std::deque<BuildJob> kept;
+        for (BuildJob& job : queuedJobs) {
+            if (job.generation >= generation) {
+                kept.push_back(std::move(job));
+            }
+        }
+        queuedJobs.swap(kept);
+        jobsInFlight -= before - queuedJobs.size();
+    }
+
+    /**
+     * @brief Retira os resultados prontos desde a última chamada (não bloqueia)
+     */
+    std::vector<BuildResult> takeCompleted() {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<BuildResult> results;
+        results.swap(completedResults);
+        return results;
+    }
+
+    /**
+     * @brief Indica se há pedidos na fila, em processamento ou resultados ainda não retirados
+     */
+    bool isBusy() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return jobsInFlight > 0 || !completedResults.empty();
+    }
+};
+
+#endif // MESH_BUILD_PIPELINE_H
@@ -8,10 +8,19 @@
 #ifndef OBJECT_3D_H
 #define OBJECT_3D_H
 
+#include <algorithm>
 #include <vector>
 #include <cmath>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
 #include <GL/gl.h>
 #include "data_structures.h"
+#include "frustum.h"
+#include "render_counters.h"
+#include "shader_utils.h"
+#include "simd_utils.h"
+#include "thread_utils.h"
 
 struct Vector3D {
     float x, y, z;
@@ -38,25 +47,312 @@ struct Vector3D {
     }
 };
 
-struct Vertex3D {
-    float x, y, z;
-    Vector3D normal; // Normal do vértice (para Gouraud/Phong)
+/**
+ * @enum MeshVariant
+ * @brief Versão da malha na GPU usada para desenhar o objeto
+ */
+enum class MeshVariant {
+    SMOOTH, // Vértices compartilhados com normais médias (Gouraud/Phong)
+    FLAT    // Vértices duplicados por triângulo com a normal da face
+};
 
-    Vertex3D(float _x = 0, float _y = 0, float _z = 0) : x(_x), y(_y), z(_z) {}
+/**
+ * @brief Atributos de uma cópia em desenho instanciado (layout do buffer de instâncias)
+ *
+ * transform é uma matriz 4x4 em ordem de colunas, como a do glMultMatrixf.
+ */
+struct InstanceData {
+    GLfloat transform[16];
+    GLfloat color[4];
 };
 
-struct Face {
-    std::vector<int> vertexIndices; // Índices dos vértices na lista do objeto
-    Vector3D normal; // Normal da face (para Flat)
+/**
+ * @brief Produtos vetoriais em lote: n[i] = a[i] x b[i] (componentes em arrays separados)
+ */
+inline void crossProducts(const float* ax, const float* ay, const float* az,
+                          const float* bx, const float* by, const float* bz,
+                          float* nx, float* ny, float* nz, size_t count) {
+    size_t i = 0;
+#if defined(CG_SIMD_SSE2)
+    for (; i + 4 <= count; i += 4) {
+        __m128 x1 = _mm_loadu_ps(ax + i), y1 = _mm_loadu_ps(ay + i), z1 = _mm_loadu_ps(az + i);
+        __m128 x2 = _mm_loadu_ps(bx + i), y2 = _mm_loadu_ps(by + i), z2 = _mm_loadu_ps(bz + i);
+        _mm_storeu_ps(nx + i, _mm_sub_ps(_mm_mul_ps(y1, z2), _mm_mul_ps(z1, y2)));
+        _mm_storeu_ps(ny + i, _mm_sub_ps(_mm_mul_ps(z1, x2), _mm_mul_ps(x1, z2)));
+        _mm_storeu_ps(nz + i, _mm_sub_ps(_mm_mul_ps(x1, y2), _mm_mul_ps(y1, x2)));
+    }
+#endif
+    for (; i < count; i++) {
+        nx[i] = ay[i] * bz[i] - az[i] * by[i];
+        ny[i] = az[i] * bx[i] - ax[i] * bz[i];
+        nz[i] = ax[i] * by[i] - ay[i] * bx[i];
+    }
+}
 
-    Face() {}
-    Face(const std::vector<int>& indices) : vertexIndices(indices) {}
+/**
+ * @brief Normaliza vetores em lote; vetores nulos continuam nulos
+ *
+ * A versão SSE usa rsqrt (12 bits) refinado por um passo de Newton-Raphson,
+ * sem sqrt nem divisões.
+ */
+inline void normalizeVectors(float* x, float* y, float* z, size_t count) {
+    size_t i = 0;
+#if defined(CG_SIMD_SSE2)
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 three = _mm_set1_ps(3.0f);
+    const __m128 zero = _mm_setzero_ps();
+    for (; i + 4 <= count; i += 4) {
+        __m128 vx = _mm_loadu_ps(x + i), vy = _mm_loadu_ps(y + i), vz = _mm_loadu_ps(z + i);
+        __m128 lengthSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)), _mm_mul_ps(vz, vz));
+        __m128 estimate = _mm_rsqrt_ps(lengthSquared);
+        // r' = 0.5 * r * (3 - l² * r²)
+        estimate = _mm_mul_ps(_mm_mul_ps(half, estimate),
+                              _mm_sub_ps(three, _mm_mul_ps(lengthSquared, _mm_mul_ps(estimate, estimate))));
+        estimate = _mm_and_ps(estimate, _mm_cmpgt_ps(lengthSquared, zero));
+        _mm_storeu_ps(x + i, _mm_mul_ps(vx, estimate));
+        _mm_storeu_ps(y + i, _mm_mul_ps(vy, estimate));
+        _mm_storeu_ps(z + i, _mm_mul_ps(vz, estimate));
+    }
+#endif
+    for (; i < count; i++) {
+        float length = std::sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]);
+        if (length > 0) {
+            float inverseLength = 1.0f / length;
+            x[i] *= inverseLength;
+            y[i] *= inverseLength;
+            z[i] *= inverseLength;
+        }
+    }
+}
+
+/**
+ * @brief Arrays contíguos de um Object3D, sem posse (gravação e carga de cenas)
+ *
+ * Posições, normais e normais de face em SoA ([0] = X, [1] = Y, [2] = Z);
+ * interleaved/indices são as variantes prontas para a GPU, indexadas por MeshVariant.
+ */
+struct MeshGeometryView {
+    size_t vertexCount;
+    size_t faceCount;
+    size_t faceIndexCount;
+    const float* positions[3];
+    const float* normals[3];
+    const int* faceIndices;
+    const int* faceOffsets;      // faceCount + 1 entradas
+    const float* faceNormals[3];
+    size_t interleavedCount[2];  // Floats (6 por vértice)
+    size_t indexCount[2];
+    const GLfloat* interleaved[2];
+    const GLuint* indices[2];
 };
 
+/**
+ * @class Object3D
+ * @brief Malha poligonal em layout compacto
+ *
+ * Posições e normais ficam em structure-of-arrays (um vetor por componente) e
+ * as faces em um único vetor de índices, com o início de cada face em
+ * faceOffsets; nenhuma face aloca memória própria.
+ */
 class Object3D {
+private:
+    // --- Vértices (SoA) ---
+    std::vector<float> positionX, positionY, positionZ;
+    std::vector<float> normalX, normalY, normalZ; // Normais dos vértices (Gouraud/Phong)
+
+    // --- Faces: face f usa faceIndices[faceOffsets[f] .. faceOffsets[f + 1]) ---
+    std::vector<int> faceIndices;
+    std::vector<int> faceOffsets;
+    std::vector<float> faceNormalX, faceNormalY, faceNormalZ; // Normais das faces (Flat)
+
+    // Malha pronta para a GPU: vértices intercalados (posição + normal) e índices de triângulos
+    struct MeshBuffers {
+        std::vector<GLfloat> interleaved;
+        std::vector<GLuint> indices;
+        GLuint vertexBuffer;
+        GLuint indexBuffer;
+        GLsizei indexCount;
+
+        MeshBuffers() : vertexBuffer(0), indexBuffer(0), indexCount(0) {}
+    };
+
+    MeshBuffers meshes[2]; // Indexado por MeshVariant
+    bool meshBuilt; // Variantes montadas a partir da geometria atual
+    bool meshDirty; // Variantes mudaram desde o último upload
+    bool meshArraysReleased; // Variantes só existem na GPU (enviadas direto de um arquivo mapeado)
+
+    BoundingVolume bounds; // Espaço local; recalculado junto com a malha
+    bool boundsValid;
+
+    // Versões mais leves da mesma malha, da mais fina para a mais grossa; desenhadas
+    // com a transformação e a cor deste objeto (a transformação delas é ignorada)
+    struct LodLevel {
+        float geometricError; // Desvio máximo em relação a esta malha, em unidades locais
+        std::unique_ptr<Object3D> mesh;
+    };
+    std::vector<LodLevel> lodLevels;
+
+    static void pushVertex(std::vector<GLfloat>& interleaved, float x, float y, float z,
+                           float nx, float ny, float nz) {
+        interleaved.push_back(x);
+        interleaved.push_back(y);
+        interleaved.push_back(z);
+        interleaved.push_back(nx);
+        interleaved.push_back(ny);
+        interleaved.push_back(nz);
+    }
+
+    /**
+     * @brief Monta as duas variantes, triangulando as faces em leque a partir do primeiro vértice
+     */
+    void buildMeshVariants() {
+        MeshBuffers& smooth = meshes[static_cast<int>(MeshVariant::SMOOTH)];
+        MeshBuffers& flat = meshes[static_cast<int>(MeshVariant::FLAT)];
+        smooth.interleaved.clear();
+        smooth.indices.clear();
+        flat.interleaved.clear();
+        flat.indices.clear();
+
+        size_t vertexCount = positionX.size();
+        smooth.interleaved.reserve(vertexCount * 6);
+        for (size_t v = 0; v < vertexCount; v++) {
+            pushVertex(smooth.interleaved, positionX[v], positionY[v], positionZ[v], normalX[v], normalY[v], normalZ[v]);
+        }
+
+        size_t triangleCount = 0;
+        for (size_t f = 0; f + 1 < faceOffsets.size(); f++) {
+            int cornerCount = faceOffsets[f + 1] - faceOffsets[f];
+            if (cornerCount >= 3) {
+                triangleCount += cornerCount - 2;
+            }
+        }
+        smooth.indices.reserve(triangleCount * 3);
+        flat.indices.reserve(triangleCount * 3);
+        flat.interleaved.reserve(triangleCount * 18);
+
+        for (size_t f = 0; f + 1 < faceOffsets.size(); f++) {
+            const int* corners = faceIndices.data() + faceOffsets[f];
+            int cornerCount = faceOffsets[f + 1] - faceOffsets[f];
+            for (int i = 1; i + 1 < cornerCount; i++) {
+                int triangle[3] = { corners[0], corners[i], corners[i + 1] };
+                for (int corner : triangle) {
+                    smooth.indices.push_back(corner);
+                    flat.indices.push_back(static_cast<GLuint>(flat.interleaved.size() / 6));
+                    pushVertex(flat.interleaved, positionX[corner], positionY[corner], positionZ[corner],
+                               faceNormalX[f], faceNormalY[f], faceNormalZ[f]);
+                }
+            }
+        }
+
+        bounds = BoundingVolume::fromPositions(positionX.data(), positionY.data(), positionZ.data(), vertexCount);
+        boundsValid = true;
+        meshBuilt = true;
+        meshDirty = true;
+        meshArraysReleased = false;
+    }
+    /**
+     * @brief Envia as variantes para seus buffers
+     */
+    void uploadMesh() {
+        for (MeshBuffers& mesh : meshes) {
+            if (!mesh.vertexBuffer) {
+                glGenBuffers(1, &mesh.vertexBuffer);
+                glGenBuffers(1, &mesh.indexBuffer);
+            }
+            glBindBuffer(GL_ARRAY_BUFFER, mesh.vertexBuffer);
+            glBufferData(GL_ARRAY_BUFFER, mesh.interleaved.size() * sizeof(GLfloat), mesh.interleaved.data(), GL_STATIC_DRAW);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.indexBuffer);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, mesh.indices.size() * sizeof(GLuint), mesh.indices.data(), GL_STATIC_DRAW);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+            mesh.indexCount = static_cast<GLsizei>(mesh.indices.size());
+        }
+        meshDirty = false;
+    }
+
+    /**
+     * @brief Garante a variante na GPU e liga seus buffers e ponteiros de vértice/normal
+     * @return Malha ligada, ou nullptr se estiver vazia (nada fica ligado)
+     */
+    const MeshBuffers* bindMesh(MeshVariant variant) {
+        if (!meshBuilt) {
+            buildMeshVariants();
+        }
+        if (meshDirty) {
+            uploadMesh();
+        }
+
+        const MeshBuffers& mesh = meshes[static_cast<int>(variant)];
+        if (mesh.indexCount == 0) {
+            return nullptr;
+        }
+
+        const GLsizei stride = 6 * sizeof(GLfloat);
+        glBindBuffer(GL_ARRAY_BUFFER, mesh.vertexBuffer);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.indexBuffer);
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glEnableClientState(GL_NORMAL_ARRAY);
+        glVertexPointer(3, GL_FLOAT, stride, reinterpret_cast<const void*>(0));
+        glNormalPointer(GL_FLOAT, stride, reinterpret_cast<const void*>(3 * sizeof(GLfloat)));
+        return &mesh;
+    }
+
+    static void unbindMesh() {
+        glDisableClientState(GL_NORMAL_ARRAY);
+        glDisableClientState(GL_VERTEX_ARRAY);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    /**
+     * @brief Desenha a variante escolhida com um único glDrawElements
+     */
+    void drawMesh(MeshVariant variant) {
+        const MeshBuffers* mesh = bindMesh(variant);
+        if (!mesh) {
+            return;
+        }
+        glDrawElements(GL_TRIANGLES, mesh->indexCount, GL_UNSIGNED_INT, reinterpret_cast<const void*>(0));
+        RenderCounters::add(RenderCounter::DRAW_CALLS);
+        RenderCounters::add(RenderCounter::TRIANGLES, mesh->indexCount / 3);
+        unbindMesh();
+    }
+
+    /**
+     * @brief Aplica position, rotation e scale à matriz corrente
+     */
+    void applyTransform() const {
+        glTranslatef(position.x, position.y, position.z);
+        glRotatef(rotation.x, 1.0f, 0.0f, 0.0f);
+        glRotatef(rotation.y, 0.0f, 1.0f, 0.0f);
+        glRotatef(rotation.z, 0.0f, 0.0f, 1.0f);
+        glScalef(scale.x, scale.y, scale.z);
+    }
+
+    /**
+     * @brief Caminho imediato (sem buffer objects): um glBegin(GL_POLYGON) por face
+     */
+    void drawImmediate(MeshVariant variant) const {
+        // Usar GL_POLYGON para suportar faces com > 3 vértices (como quads da extrusão)
+        RenderCounters::add(RenderCounter::IMMEDIATE_BLOCKS, faceOffsets.size() - 1);
+        RenderCounters::add(RenderCounter::TRIANGLES, faceIndices.size() - 2 * (faceOffsets.size() - 1));
+        for (size_t f = 0; f + 1 < faceOffsets.size(); f++) {
+            glBegin(GL_POLYGON);
+            glNormal3f(faceNormalX[f], faceNormalY[f], faceNormalZ[f]); // Normal da face (Flat)
+            
+            for (int k = faceOffsets[f]; k < faceOffsets[f + 1]; k++) {
+                int idx = faceIndices[k];
+                // Para Gouraud/Phong, enviamos a normal do vértice. Para Flat, NÃO enviamos (usa a da face)
+                if (variant == MeshVariant::SMOOTH) {
+                    glNormal3f(normalX[idx], normalY[idx], normalZ[idx]);
+                }
+                glVertex3f(positionX[idx], positionY[idx], positionZ[idx]);
+            }
+            glEnd();
+        }
+    }
+
 public:
-    std::vector<Vertex3D> vertices;
-    std::vector<Face> faces;
     ColorRGB color;
     
     // Transformações
@@ -64,78 +360,522 @@ public:
     Vector3D rotation; // Euler angles (x, y, z)
     Vector3D scale;
 
-    Object3D() : position(0,0,0), rotation(0,0,0), scale(1,1,1), color(1.0f, 1.0f, 1.0f) {}
+    Object3D() : faceOffsets(1, 0), meshBuilt(false), meshDirty(true), meshArraysReleased(false),
+                 boundsValid(false), color(1.0f, 1.0f, 1.0f), position(0,0,0), rotation(0,0,0), scale(1,1,1) {}
+
+    ~Object3D() {
+        for (MeshBuffers& mesh : meshes) {
+            if (mesh.vertexBuffer && ShaderUtils::hasBufferObjects()) {
+                glDeleteBuffers(1, &mesh.vertexBuffer);
+                glDeleteBuffers(1, &mesh.indexBuffer);
+            }
+        }
+    }
+
+    // Os buffers pertencem a um único objeto
+    Object3D(const Object3D&) = delete;
+    Object3D& operator=(const Object3D&) = delete;
+
+    /**
+     * @brief Reserva espaço para a geometria (evita realocações durante a montagem)
+     */
+    void reserve(size_t vertexCount, size_t faceCount, size_t indexCount) {
+        positionX.reserve(vertexCount);
+        positionY.reserve(vertexCount);
+        positionZ.reserve(vertexCount);
+        normalX.reserve(vertexCount);
+        normalY.reserve(vertexCount);
+        normalZ.reserve(vertexCount);
+        faceOffsets.reserve(faceCount + 1);
+        faceNormalX.reserve(faceCount);
+        faceNormalY.reserve(faceCount);
+        faceNormalZ.reserve(faceCount);
+        faceIndices.reserve(indexCount);
+    }
+
+    /**
+     * @brief Adiciona um vértice
+     * @return Índice do novo vértice
+     */
+    int addVertex(float x, float y, float z) {
+        positionX.push_back(x);
+        positionY.push_back(y);
+        positionZ.push_back(z);
+        normalX.push_back(0.0f);
+        normalY.push_back(0.0f);
+        normalZ.push_back(0.0f);
+        meshBuilt = false;
+        boundsValid = false;
+        return static_cast<int>(positionX.size()) - 1;
+    }
 
-    void addVertex(float x, float y, float z) {
-        vertices.emplace_back(x, y, z);
+    /**
+     * @brief Adiciona uma face com count vértices (copiados para o vetor único de índices)
+     */
+    void addFace(const int* indices, int count) {
+        faceIndices.insert(faceIndices.end(), indices, indices + count);
+        faceOffsets.push_back(static_cast<int>(faceIndices.size()));
+        faceNormalX.push_back(0.0f);
+        faceNormalY.push_back(0.0f);
+        faceNormalZ.push_back(0.0f);
+        meshBuilt = false;
     }
 
     void addFace(const std::vector<int>& indices) {
-        faces.emplace_back(indices);
+        addFace(indices.data(), static_cast<int>(indices.size()));
     }
 
-    void calculateNormals() {
-        // 1. Calcular normais das faces
-        for (auto& face : faces) {
-            if (face.vertexIndices.size() < 3) continue;
-            
-            Vector3D v0(vertices[face.vertexIndices[0]].x, vertices[face.vertexIndices[0]].y, vertices[face.vertexIndices[0]].z);
-            Vector3D v1(vertices[face.vertexIndices[1]].x, vertices[face.vertexIndices[1]].y, vertices[face.vertexIndices[1]].z);
-            Vector3D v2(vertices[face.vertexIndices[2]].x, vertices[face.vertexIndices[2]].y, vertices[face.vertexIndices[2]].z);
+    void addTriangle(int a, int b, int c) {
+        const int indices[3] = { a, b, c };
+        addFace(indices, 3);
+    }
+
+    void addQuad(int a, int b, int c, int d) {
+        const int indices[4] = { a, b, c, d };
+        addFace(indices, 4);
+    }
+
+    size_t getVertexCount() const { return positionX.size(); }
+    size_t getFaceCount() const { return faceOffsets.size() - 1; }
+
+    Vector3D getVertexPosition(int index) const {
+        return Vector3D(positionX[index], positionY[index], positionZ[index]);
+    }
 
-            Vector3D edge1 = v1 - v0;
-            Vector3D edge2 = v2 - v0;
-            face.normal = Vector3D::cross(edge1, edge2);
-            face.normal.normalize();
+    Vector3D getVertexNormal(int index) const {
+        return Vector3D(normalX[index], normalY[index], normalZ[index]);
+    }
+
+    Vector3D getFaceNormal(size_t face) const {
+        return Vector3D(faceNormalX[face], faceNormalY[face], faceNormalZ[face]);
+    }
+
+    int getFaceVertexCount(size_t face) const {
+        return faceOffsets[face + 1] - faceOffsets[face];
+    }
+
+    const int* getFaceVertices(size_t face) const {
+        return faceIndices.data() + faceOffsets[face];
+    }
+
+    /**
+     * @brief Monta e envia as variantes da malha agora, em vez de no primeiro draw
+     *
+     * Precisa de um contexto OpenGL atual; sem buffer objects não faz nada.
+     */
+    void uploadToGpu() {
+        if (!ShaderUtils::hasBufferObjects()) {
+            return;
+        }
+        if (!meshBuilt) {
+            buildMeshVariants();
         }
+        if (meshDirty) {
+            uploadMesh();
+        }
+        for (LodLevel& level : lodLevels) {
+            level.mesh->uploadToGpu();
+        }
+    }
 
-        // 2. Calcular normais dos vértices (média das normais das faces adjacentes)
-        // Resetar normais dos vértices
-        for (auto& v : vertices) {
-            v.normal = Vector3D(0, 0, 0);
+    /**
+     * @brief Acrescenta um nível de detalhe mais grosso que os já existentes
+     * @param mesh Malha simplificada, no mesmo espaço local desta
+     * @param geometricError Desvio máximo em relação a esta malha, em unidades locais
+     */
+    void addLodLevel(std::unique_ptr<Object3D> mesh, float geometricError) {
+        if (mesh) {
+            lodLevels.push_back(LodLevel{ geometricError, std::move(mesh) });
         }
+    }
+
+    /**
+     * @brief Quantidade de níveis, contando a malha completa (nível 0)
+     */
+    size_t getLodLevelCount() const { return lodLevels.size() + 1; }
+
+    /**
+     * @brief Nível mais grosso cujo desvio, projetado na tela, não passa de maxPixelError
+     * @param pixelsPerUnit Pixels por unidade de mundo na distância do objeto
+     */
+    size_t selectLodLevel(float pixelsPerUnit, float maxPixelError) const {
+        float localToPixels = pixelsPerUnit * std::max(std::fabs(scale.x), std::max(std::fabs(scale.y), std::fabs(scale.z)));
+        size_t level = 0;
+        while (level < lodLevels.size() && lodLevels[level].geometricError * localToPixels <= maxPixelError) {
+            level++;
+        }
+        return level;
+    }
 
-        // Acumular normais das faces
-        for (const auto& face : faces) {
-            for (int idx : face.vertexIndices) {
-                vertices[idx].normal = vertices[idx].normal + face.normal;
+    /**
+     * @brief Malha do nível (a própria para 0 ou fora do intervalo)
+     */
+    Object3D& getLodMesh(size_t level) {
+        return (level == 0 || level > lodLevels.size()) ? *this : *lodLevels[level - 1].mesh;
+    }
+
+    /**
+     * @brief Desvio do nível em relação a esta malha (0 para o nível 0 ou fora do intervalo)
+     */
+    float getLodError(size_t level) const {
+        return (level == 0 || level > lodLevels.size()) ? 0.0f : lodLevels[level - 1].geometricError;
+    }
+
+    /**
+     * @brief Ponteiros para toda a geometria, incluindo as duas variantes da malha
+     *
+     * Monta as variantes na CPU se ainda não existirem (ou se só estiverem na GPU);
+     * a view vale até a próxima alteração do objeto.
+     */
+    MeshGeometryView getGeometryView() {
+        if (!meshBuilt || meshArraysReleased) {
+            bool uploaded = meshBuilt && !meshDirty;
+            buildMeshVariants();
+            if (uploaded) {
+                meshDirty = false; // Os buffers já têm esse conteúdo
             }
         }
 
-        // Normalizar
-        for (auto& v : vertices) {
-            v.normal.normalize();
+        MeshGeometryView view;
+        view.vertexCount = positionX.size();
+        view.faceCount = getFaceCount();
+        view.faceIndexCount = faceIndices.size();
+        view.positions[0] = positionX.data();
+        view.positions[1] = positionY.data();
+        view.positions[2] = positionZ.data();
+        view.normals[0] = normalX.data();
+        view.normals[1] = normalY.data();
+        view.normals[2] = normalZ.data();
+        view.faceIndices = faceIndices.data();
+        view.faceOffsets = faceOffsets.data();
+        view.faceNormals[0] = faceNormalX.data();
+        view.faceNormals[1] = faceNormalY.data();
+        view.faceNormals[2] = faceNormalZ.data();
+        for (int variant = 0; variant < 2; variant++) {
+            view.interleavedCount[variant] = meshes[variant].interleaved.size();
+            view.indexCount[variant] = meshes[variant].indices.size();
+            view.interleaved[variant] = meshes[variant].interleaved.data();
+            view.indices[variant] = meshes[variant].indices.data();
         }
+        return view;
     }
 
-    void draw(bool useFlatShading = false) const {
+    /**
+     * @brief Substitui a geometria pela da view, sem recalcular normais nem variantes
+     *
+     * Os arrays SoA são copiados em bloco. Com buffer objects, as variantes vão
+     * direto da view para a GPU (sem cópia na CPU); sem eles, ou se a view não
+     * trouxer variantes, elas são montadas no primeiro draw. Precisa de um
+     * contexto OpenGL atual.
+     */
+    void loadGeometry(const MeshGeometryView& view) {
+        positionX.assign(view.positions[0], view.positions[0] + view.vertexCount);
+        positionY.assign(view.positions[1], view.positions[1] + view.vertexCount);
+        positionZ.assign(view.positions[2], view.positions[2] + view.vertexCount);
+        normalX.assign(view.normals[0], view.normals[0] + view.vertexCount);
+        normalY.assign(view.normals[1], view.normals[1] + view.vertexCount);
+        normalZ.assign(view.normals[2], view.normals[2] + view.vertexCount);
+        faceIndices.assign(view.faceIndices, view.faceIndices + view.faceIndexCount);
+        faceOffsets.assign(view.faceOffsets, view.faceOffsets + view.faceCount + 1);
+        faceNormalX.assign(view.faceNormals[0], view.faceNormals[0] + view.faceCount);
+        faceNormalY.assign(view.faceNormals[1], view.faceNormals[1] + view.faceCount);
+        faceNormalZ.assign(view.faceNormals[2], view.faceNormals[2] + view.faceCount);
+        boundsValid = false;
+
+        bool hasVariants = view.indexCount[0] > 0 && view.indexCount[1] > 0;
+        if (!ShaderUtils::hasBufferObjects() || !hasVariants) {
+            meshBuilt = false;
+            meshDirty = true;
+            return;
+        }
+
+        for (int variant = 0; variant < 2; variant++) {
+            MeshBuffers& mesh = meshes[variant];
+            std::vector<GLfloat>().swap(mesh.interleaved);
+            std::vector<GLuint>().swap(mesh.indices);
+            if (!mesh.vertexBuffer) {
+                glGenBuffers(1, &mesh.vertexBuffer);
+                glGenBuffers(1, &mesh.indexBuffer);
+            }
+            glBindBuffer(GL_ARRAY_BUFFER, mesh.vertexBuffer);
+            glBufferData(GL_ARRAY_BUFFER, view.interleavedCount[variant] * sizeof(GLfloat), view.interleaved[variant], GL_STATIC_DRAW);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.indexBuffer);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, view.indexCount[variant] * sizeof(GLuint), view.indices[variant], GL_STATIC_DRAW);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+            mesh.indexCount = static_cast<GLsizei>(view.indexCount[variant]);
+        }
+        meshBuilt = true;
+        meshDirty = false;
+        meshArraysReleased = true;
+    }
+
+    /**
+     * @brief Força a remontagem da malha no próximo draw
+     */
+    void markGeometryDirty() {
+        meshBuilt = false;
+        boundsValid = false;
+    }
+
+    /**
+     * @brief Caixa e esfera envolventes no espaço local (calculadas sob demanda se a geometria mudou)
+     */
+    const BoundingVolume& getBounds() {
+        if (!boundsValid) {
+            bounds = BoundingVolume::fromPositions(positionX.data(), positionY.data(), positionZ.data(), positionX.size());
+            boundsValid = true;
+        }
+        return bounds;
+    }
+
+    /**
+     * @brief Esfera envolvente em coordenadas de mundo, aplicando position/rotation/scale
+     * @return false se o objeto não tiver vértices
+     *
+     * O centro passa pela mesma sequência de draw() (escala, Rz, Ry, Rx,
+     * translação); o raio cresce pela maior escala absoluta.
+     */
+    bool getWorldBoundingSphere(Vector3D& center, float& radius) {
+        const BoundingVolume& local = getBounds();
+        if (local.empty) {
+            return false;
+        }
+
+        const float degreesToRadians = 3.14159265f / 180.0f;
+        float x = local.centerX * scale.x, y = local.centerY * scale.y, z = local.centerZ * scale.z;
+        float angle = rotation.z * degreesToRadians;
+        float rx = x * std::cos(angle) - y * std::sin(angle);
+        float ry = x * std::sin(angle) + y * std::cos(angle);
+        x = rx; y = ry;
+        angle = rotation.y * degreesToRadians;
+        rx = x * std::cos(angle) + z * std::sin(angle);
+        float rz = -x * std::sin(angle) + z * std::cos(angle);
+        x = rx; z = rz;
+        angle = rotation.x * degreesToRadians;
+        ry = y * std::cos(angle) - z * std::sin(angle);
+        rz = y * std::sin(angle) + z * std::cos(angle);
+        y = ry; z = rz;
+
+        center = Vector3D(x + position.x, y + position.y, z + position.z);
+        radius = local.radius * std::max(std::fabs(scale.x), std::max(std::fabs(scale.y), std::fabs(scale.z)));
+        return true;
+    }
+
+    /**
+     * @brief Calcula as normais das faces e dos vértices
+     *
+     * Faces e vértices são processados em blocos independentes (em paralelo para
+     * malhas grandes): produto vetorial e normalização em lote via SSE, e as
+     * normais dos vértices por gather sobre a adjacência vértice -> faces, sem
+     * escrita concorrente.
+     */
+    void calculateNormals() {
+        size_t faceCount = getFaceCount();
+        size_t vertexCount = getVertexCount();
+        const size_t blockSize = 4096;
+        const bool runParallel = faceCount >= 4 * blockSize;
+
+        auto forEachBlock = [&](size_t itemCount, const auto& processBlock) {
+            size_t blockCount = (itemCount + blockSize - 1) / blockSize;
+            auto runBlock = [&](size_t block) {
+                processBlock(block * blockSize, std::min(itemCount, (block + 1) * blockSize));
+            };
+            if (runParallel) {
+                parallelFor(blockCount, runBlock);
+            } else {
+                for (size_t block = 0; block < blockCount; block++) {
+                    runBlock(block);
+                }
+            }
+        };
+
+        // 1. Calcular normais das faces (três primeiros vértices de cada face)
+        std::vector<float> edges(faceCount * 6);
+        forEachBlock(faceCount, [&](size_t first, size_t last) {
+            float* e1x = edges.data() + first;
+            float* e1y = e1x + faceCount;
+            float* e1z = e1y + faceCount;
+            float* e2x = e1z + faceCount;
+            float* e2y = e2x + faceCount;
+            float* e2z = e2y + faceCount;
+            for (size_t f = first; f < last; f++) {
+                size_t local = f - first;
+                if (getFaceVertexCount(f) < 3) {
+                    e1x[local] = e1y[local] = e1z[local] = e2x[local] = e2y[local] = e2z[local] = 0.0f;
+                    continue;
+                }
+                const int* corners = getFaceVertices(f);
+                int c0 = corners[0], c1 = corners[1], c2 = corners[2];
+                e1x[local] = positionX[c1] - positionX[c0];
+                e1y[local] = positionY[c1] - positionY[c0];
+                e1z[local] = positionZ[c1] - positionZ[c0];
+                e2x[local] = positionX[c2] - positionX[c0];
+                e2y[local] = positionY[c2] - positionY[c0];
+                e2z[local] = positionZ[c2] - positionZ[c0];
+            }
+            crossProducts(e1x, e1y, e1z, e2x, e2y, e2z,
+                          faceNormalX.data() + first, faceNormalY.data() + first, faceNormalZ.data() + first,
+                          last - first);
+            normalizeVectors(faceNormalX.data() + first, faceNormalY.data() + first, faceNormalZ.data() + first,
+                             last - first);
+        });
+
+        // 2. Adjacência vértice -> faces (CSR), em ordem crescente de face
+        std::vector<int> adjacencyOffsets(vertexCount + 1, 0);
+        for (int idx : faceIndices) {
+            adjacencyOffsets[idx + 1]++;
+        }
+        for (size_t v = 0; v < vertexCount; v++) {
+            adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+        }
+        std::vector<int> adjacentFaces(faceIndices.size());
+        std::vector<int> fillPosition(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (size_t f = 0; f < faceCount; f++) {
+            for (int k = faceOffsets[f]; k < faceOffsets[f + 1]; k++) {
+                adjacentFaces[fillPosition[faceIndices[k]]++] = static_cast<int>(f);
+            }
+        }
+
+        // 3. Normais dos vértices: média das normais das faces adjacentes (gather + normalização)
+        forEachBlock(vertexCount, [&](size_t first, size_t last) {
+            for (size_t v = first; v < last; v++) {
+                float sumX = 0.0f, sumY = 0.0f, sumZ = 0.0f;
+                for (int k = adjacencyOffsets[v]; k < adjacencyOffsets[v + 1]; k++) {
+                    int f = adjacentFaces[k];
+                    sumX += faceNormalX[f];
+                    sumY += faceNormalY[f];
+                    sumZ += faceNormalZ[f];
+                }
+                normalX[v] = sumX;
+                normalY[v] = sumY;
+                normalZ[v] = sumZ;
+            }
+            normalizeVectors(normalX.data() + first, normalY.data() + first, normalZ.data() + first, last - first);
+        });
+
+        // 3. Montar as variantes SMOOTH e FLAT uma única vez
+        buildMeshVariants();
+    }
+    /**
+     * @brief Desenha o objeto
+     * @param variant Malha a usar: normais de vértice (SMOOTH) ou de face (FLAT)
+     *
+     * @param lodLevel Nível de detalhe (0 = malha completa; veja selectLodLevel)
+     *
+     * Com buffer objects disponíveis, a variante só escolhe qual VBO/IBO é ligado.
+     */
+    void draw(MeshVariant variant = MeshVariant::SMOOTH, size_t lodLevel = 0) {
         glPushMatrix();
-        glTranslatef(position.x, position.y, position.z);
-        glRotatef(rotation.x, 1.0f, 0.0f, 0.0f);
-        glRotatef(rotation.y, 0.0f, 1.0f, 0.0f);
-        glRotatef(rotation.z, 0.0f, 0.0f, 1.0f);
-        glScalef(scale.x, scale.y, scale.z);
+        applyTransform();
 
         glColor3f(color.redComponent, color.greenComponent, color.blueComponent);
 
-        // Usar GL_POLYGON para suportar faces com > 3 vértices (como quads da extrusão)
-        for (const auto& face : faces) {
-            glBegin(GL_POLYGON);
-            glNormal3f(face.normal.x, face.normal.y, face.normal.z); // Normal da face (Flat)
-            
-            for (int idx : face.vertexIndices) {
-                const auto& v = vertices[idx];
-                // Para Gouraud/Phong, enviamos a normal do vértice. Para Flat, NÃO enviamos (usa a da face)
-                if (!useFlatShading) {
-                    glNormal3f(v.normal.x, v.normal.y, v.normal.z);
-                }
-                glVertex3f(v.x, v.y, v.z);
+        Object3D& mesh = getLodMesh(lodLevel);
+        if (ShaderUtils::hasBufferObjects()) {
+            mesh.drawMesh(variant);
+        } else {
+            mesh.drawImmediate(variant);
+        }
+
+        glPopMatrix();
+    }
+
+    /**
+     * @brief Desenha várias cópias da malha com um único glDrawElementsInstanced
+     * @param variant Malha a usar (SMOOTH ou FLAT)
+     * @param instanceBuffer VBO com instanceCount registros InstanceData
+     * @param instanceCount Quantidade de cópias
+     * @param transformLocation Atributo mat4 do shader (ocupa 4 locais consecutivos)
+     * @param colorLocation Atributo vec4 com a cor da cópia
+     *
+     * A matriz de cada cópia é composta com a transformação do próprio objeto.
+     * Exige ShaderUtils::hasInstancing() e o programa instanciado já em uso.
+     */
+    void drawInstanced(MeshVariant variant, GLuint instanceBuffer, GLsizei instanceCount,
+                       GLint transformLocation, GLint colorLocation) {
+        if (instanceCount <= 0 || transformLocation < 0 || colorLocation < 0) {
+            return;
+        }
+
+        glPushMatrix();
+        applyTransform();
+
+        const MeshBuffers* mesh = bindMesh(variant);
+        if (mesh) {
+            const GLsizei stride = sizeof(InstanceData);
+            glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+            for (GLuint column = 0; column < 4; column++) {
+                GLuint location = static_cast<GLuint>(transformLocation) + column;
+                glEnableVertexAttribArray(location);
+                glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, stride,
+                                      reinterpret_cast<const void*>(column * 4 * sizeof(GLfloat)));
+                glVertexAttribDivisor(location, 1);
             }
-            glEnd();
+            glEnableVertexAttribArray(colorLocation);
+            glVertexAttribPointer(colorLocation, 4, GL_FLOAT, GL_FALSE, stride,
+                                  reinterpret_cast<const void*>(16 * sizeof(GLfloat)));
+            glVertexAttribDivisor(colorLocation, 1);
+
+            glDrawElementsInstanced(GL_TRIANGLES, mesh->indexCount, GL_UNSIGNED_INT,
+                                    reinterpret_cast<const void*>(0), instanceCount);
+            RenderCounters::add(RenderCounter::DRAW_CALLS);
+            RenderCounters::add(RenderCounter::TRIANGLES, static_cast<uint64_t>(mesh->indexCount / 3) * instanceCount);
+
+            // Divisor volta a 0: o estado de atributos é global ao contexto
+            for (GLuint column = 0; column < 4; column++) {
+                glVertexAttribDivisor(static_cast<GLuint>(transformLocation) + column, 0);
+                glDisableVertexAttribArray(static_cast<GLuint>(transformLocation) + column);
+            }
+            glVertexAttribDivisor(colorLocation, 0);
+            glDisableVertexAttribArray(colorLocation);
+            unbindMesh();
         }
 
         glPopMatrix();
     }
 };
 
+/**
+ * @class VertexWelder
+ * @brief Reaproveita vértices de um Object3D com a mesma posição (quantizada)
+ *
+ * Usado quando a geometria chega como triângulos soltos: cada canto é procurado
+ * em uma tabela hash de posições antes de virar um vértice novo.
+ */
+class VertexWelder {
+private:
+    Object3D& object;
+    float inverseTolerance;
+    std::unordered_map<uint64_t, int> indexByPosition;
+
+    uint64_t quantize(float x, float y, float z) const {
+        // 21 bits por eixo (com sinal) cobrem ±2^20 passos de tolerância
+        auto axis = [this](float value) -> uint64_t {
+            long long step = std::llround(value * inverseTolerance);
+            return static_cast<uint64_t>(step) & 0x1FFFFFu;
+        };
+        return axis(x) | (axis(y) << 21) | (axis(z) << 42);
+    }
+
+public:
+    /**
+     * @param target Objeto que recebe os vértices
+     * @param tolerance Distância abaixo da qual duas posições são o mesmo vértice
+     */
+    explicit VertexWelder(Object3D& target, float tolerance = 1e-4f)
+        : object(target), inverseTolerance(1.0f / tolerance) {}
+
+    /**
+     * @brief Retorna o índice de um vértice na posição, criando-o se ainda não existir
+     */
+    int addVertex(float x, float y, float z) {
+        auto inserted = indexByPosition.emplace(quantize(x, y, z), static_cast<int>(object.getVertexCount()));
+        if (inserted.second) {
+            object.addVertex(x, y, z);
+        }
+        return inserted.first->second;
+    }
+};
+
 #endif // OBJECT_3D_H
@@ -9,8 +9,115 @@
 #define POLYGON_FILL_ALGORITHM_H
 
 #include "data_structures.h"
+#include "fixed_point_edge_table.h"
+#include "render_counters.h"
 #include <algorithm>
-#include <GL/gl.h> // Adicionado para chamadas OpenGL
+#include <cstdlib>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @enum AETOrderingMode
+ * @brief Estratégia usada para manter a AET ordenada por X a cada scanline
+ */
+enum class AETOrderingMode {
+    FULL_SORT,   // std::sort completo da AET em toda scanline
+    INCREMENTAL  // Merge das arestas novas + insertion sort (quase ordenado) após o incremento de X
+};
+
+/**
+ * @enum EdgeSteppingMode
+ * @brief Representação numérica usada para avançar as arestas ao gerar spans
+ *
+ * FLOATING_POINT é o padrão: no benchmark ele venceu o 16.16 na maioria dos
+ * casos, então o ponto fixo só é usado quando pedido explicitamente (como faz
+ * ParallelScanlineFill, em que semear as faixas em double custaria caro).
+ */
+enum class EdgeSteppingMode {
+    FLOATING_POINT, // currentX/inverseSlope em double
+    FIXED_POINT     // DDA inteiro 16.16 com kernel SIMD (sempre com ordenação incremental)
+};
+
+/*
+ * Sinks do laço ET/AET
+ *
+ * O laço de PolygonFillAlgorithm é um template sobre a política de saída
+ * (resolvida em tempo de compilação, então a chamada por span é inline).
+ * Um sink de spans implementa
+ *
+ *     void span(int y, int xStart, int xEnd);
+ *
+ * e recebe os spans já arredondados e recortados a [0, maxWidth), em ordem
+ * crescente de Y (como generateSpans). Um sink de trapézios implementa
+ *
+ *     void trapezoid(int y, double leftX, double rightX, double leftNextX, double rightNextX);
+ *
+ * e recebe cada par de arestas da AET sem arredondar nem recortar, com o X
+ * na scanline y e na seguinte; esse caminho é sempre em double.
+ *
+ * Os sinks que dependem de OpenGL ou do framebuffer moram com quem desenha
+ * (GraphicsRenderer, SoftwareFramebuffer).
+ */
+
+namespace ScanlineSinkTraits {
+template <typename Sink, typename = void>
+struct EmitsTrapezoids : std::false_type {};
+
+template <typename Sink>
+struct EmitsTrapezoids<Sink, decltype(void(&Sink::trapezoid))> : std::true_type {};
+}
+
+/**
+ * @brief Acumula os spans em uma SpanList (generateSpans e o cache dos polígonos salvos)
+ */
+class SpanListSink {
+private:
+    SpanList& spans;
+
+public:
+    explicit SpanListSink(SpanList& output) : spans(output) {}
+
+    void span(int y, int xStart, int xEnd) {
+        spans.emplace_back(y, xStart, xEnd);
+    }
+};
+
+/**
+ * @brief Só conta spans e pixels, sem guardar nada (benchmarks e conferência de resultados)
+ */
+class CountingSpanSink {
+public:
+    size_t spanCount;
+    size_t pixelCount;
+
+    CountingSpanSink() : spanCount(0), pixelCount(0) {}
+
+    void span(int, int xStart, int xEnd) {
+        spanCount++;
+        pixelCount += static_cast<size_t>(xEnd - xStart + 1);
+    }
+};
+
+/**
+ * @brief Transforma cada faixa de 1 pixel entre duas arestas em 2 triângulos (generateTriangulation)
+ */
+class TriangulationSink {
+private:
+    std::vector<std::vector<Point2D>>& triangles;
+
+public:
+    explicit TriangulationSink(std::vector<std::vector<Point2D>>& output) : triangles(output) {}
+
+    void trapezoid(int y, double leftX, double rightX, double leftNextX, double rightNextX) {
+        // T1: (x1, y), (x2, y), (x1', y + 1); T2: (x2, y), (x2', y + 1), (x1', y + 1)
+        Point2D p1(static_cast<int>(leftX), y);
+        Point2D p2(static_cast<int>(rightX), y);
+        Point2D p3(static_cast<int>(leftNextX), y + 1);
+        Point2D p4(static_cast<int>(rightNextX), y + 1);
+        triangles.push_back({p1, p2, p3});
+        triangles.push_back({p2, p4, p3});
+    }
+};
 
 /**
  * @class PolygonFillAlgorithm
@@ -18,6 +125,9 @@
  */
 class PolygonFillAlgorithm {
 private:
+    AETOrderingMode orderingMode;
+    EdgeSteppingMode steppingMode;
+
     /**
      * @brief Calcula o inverso da inclinação entre dois pontos
      * @param point1 Primeiro ponto da aresta
@@ -35,19 +145,107 @@ private:
         return deltaX / deltaY;
     }
 
+    static bool isLeftOf(const EdgeData& edge1, const EdgeData& edge2) {
+        return edge1.currentX < edge2.currentX;
+    }
+
+    /**
+     * @brief Reordena a AET por X com insertion sort
+     *
+     * Entre scanlines consecutivas as arestas só trocam de ordem quando se cruzam,
+     * então a AET já chega quase ordenada e o custo fica O(E) no caso comum.
+     */
+    static void restoreActiveEdgeOrder(std::vector<EdgeData>& activeEdgeTable) {
+        for (size_t edgeIndex = 1; edgeIndex < activeEdgeTable.size(); ++edgeIndex) {
+            if (!isLeftOf(activeEdgeTable[edgeIndex], activeEdgeTable[edgeIndex - 1])) {
+                continue;
+            }
+            
+            EdgeData movingEdge = activeEdgeTable[edgeIndex];
+            size_t insertIndex = edgeIndex;
+            while (insertIndex > 0 && isLeftOf(movingEdge, activeEdgeTable[insertIndex - 1])) {
+                activeEdgeTable[insertIndex] = activeEdgeTable[insertIndex - 1];
+                --insertIndex;
+            }
+            activeEdgeTable[insertIndex] = movingEdge;
+        }
+    }
+
+    /**
+     * @brief Insere as arestas que começam na scanline atual e deixa a AET ordenada por X
+     * @param activeEdgeTable AET da scanline atual
+     * @param newEdgesBegin Início do intervalo de arestas vindas da ET
+     * @param newEdgesEnd Fim do intervalo de arestas vindas da ET
+     */
+    void updateActiveEdgeTable(std::vector<EdgeData>& activeEdgeTable,
+                               const EdgeData* newEdgesBegin,
+                               const EdgeData* newEdgesEnd) const {
+        if (orderingMode == AETOrderingMode::FULL_SORT) {
+            activeEdgeTable.insert(activeEdgeTable.end(), newEdgesBegin, newEdgesEnd);
+            std::sort(activeEdgeTable.begin(), activeEdgeTable.end(), isLeftOf);
+            return;
+        }
+        
+        // A AET veio da scanline anterior já ordenada; só cruzamentos podem ter mudado a ordem
+        restoreActiveEdgeOrder(activeEdgeTable);
+        
+        if (newEdgesBegin == newEdgesEnd) {
+            return;
+        }
+        
+        // Merge das arestas novas (poucas) com a AET já ordenada
+        size_t previousSize = activeEdgeTable.size();
+        activeEdgeTable.insert(activeEdgeTable.end(), newEdgesBegin, newEdgesEnd);
+        std::sort(activeEdgeTable.begin() + previousSize, activeEdgeTable.end(), isLeftOf);
+        std::inplace_merge(activeEdgeTable.begin(), activeEdgeTable.begin() + previousSize,
+                           activeEdgeTable.end(), isLeftOf);
+    }
+
 public:
     /**
-     * @brief Constrói a Edge Table (ET) a partir dos vértices do polígono
+     * @brief Construtor
+     * @param mode Estratégia de ordenação da AET
+     */
+    explicit PolygonFillAlgorithm(AETOrderingMode mode = AETOrderingMode::INCREMENTAL,
+                                  EdgeSteppingMode stepping = EdgeSteppingMode::FLOATING_POINT)
+        : orderingMode(mode), steppingMode(stepping) {}
+
+    /**
+     * @brief Define a estratégia de ordenação da AET
+     */
+    void setOrderingMode(AETOrderingMode mode) {
+        orderingMode = mode;
+    }
+
+    AETOrderingMode getOrderingMode() const {
+        return orderingMode;
+    }
+
+    /**
+     * @brief Define a representação numérica usada em generateSpans
+     */
+    void setSteppingMode(EdgeSteppingMode stepping) {
+        steppingMode = stepping;
+    }
+
+    EdgeSteppingMode getSteppingMode() const {
+        return steppingMode;
+    }
+
+    /**
+     * @brief Constrói a lista plana de arestas do polígono (sem buckets)
      * @param polygonVertices Vetor com os vértices do polígono
      * @param maxHeight Altura máxima da área de desenho
-     * @return Edge Table organizada por coordenada Y
+     * @return Arestas com minimumY dentro de [0, maxHeight), na ordem dos vértices
      */
-    EdgeTable buildEdgeTable(const std::vector<Point2D>& polygonVertices, int maxHeight) const {
-        EdgeTable edgeTable(maxHeight);
+    std::vector<EdgeData> buildEdgeList(const std::vector<Point2D>& polygonVertices, int maxHeight) const {
+        std::vector<EdgeData> edgeList;
         
         if (polygonVertices.size() < 2) {
-            return edgeTable;
+            return edgeList;
         }
+        
+        edgeList.reserve(polygonVertices.size());
 
         for (size_t vertexIndex = 0; vertexIndex < polygonVertices.size(); ++vertexIndex) {
             Point2D currentVertex = polygonVertices[vertexIndex];
@@ -59,7 +257,7 @@ public:
                 double initX = static_cast<double>(currentVertex.coordinateX);
                 
                 if (minY >= 0 && minY < maxHeight) {
-                    edgeTable[minY].push_back(
+                    edgeList.push_back(
                         EdgeData(maxY, initX, 0.0, minY)
                     );
                 }
@@ -105,87 +303,255 @@ public:
             }
 
             if (minimumY >= 0 && minimumY < maxHeight) {
-                edgeTable[minimumY].push_back(
+                edgeList.push_back(
                     EdgeData(maximumY, initialX, inverseSlope, minimumY)
                 );
             }
         }
 
+        return edgeList;
+    }
+
+    /**
+     * @brief Constrói a Edge Table (ET) a partir dos vértices do polígono
+     * @param polygonVertices Vetor com os vértices do polígono
+     * @param maxHeight Altura máxima da área de desenho
+     * @return Edge Table organizada por coordenada Y
+     */
+    EdgeTable buildEdgeTable(const std::vector<Point2D>& polygonVertices, int maxHeight) const {
+        EdgeTable edgeTable(maxHeight);
+        
+        for (const EdgeData& edge : buildEdgeList(polygonVertices, maxHeight)) {
+            edgeTable[edge.minimumY].push_back(edge);
+        }
+        
+        return edgeTable;
+    }
+
+    /**
+     * @brief Constrói a Edge Table compacta, limitada ao intervalo [minY, maxY] do polígono
+     * @param polygonVertices Vetor com os vértices do polígono
+     * @param maxHeight Altura máxima da área de desenho
+     * @return Arestas ordenadas por minimumY (cada "bucket" é um intervalo contíguo)
+     */
+    SparseEdgeTable buildSparseEdgeTable(const std::vector<Point2D>& polygonVertices, int maxHeight) const {
+        SparseEdgeTable edgeTable;
+        edgeTable.edges = buildEdgeList(polygonVertices, maxHeight);
+        RenderCounters::add(RenderCounter::SCANLINE_EDGES, edgeTable.edges.size());
+        
+        if (edgeTable.edges.empty()) {
+            return edgeTable;
+        }
+        
+        // stable_sort preserva a ordem dos vértices dentro de cada bucket, como na ET clássica
+        std::stable_sort(edgeTable.edges.begin(), edgeTable.edges.end(),
+            [](const EdgeData& edge1, const EdgeData& edge2) {
+                return edge1.minimumY < edge2.minimumY;
+            });
+        
+        edgeTable.minY = edgeTable.edges.front().minimumY;
+        edgeTable.maxY = edgeTable.edges.front().maximumY;
+        for (const EdgeData& edge : edgeTable.edges) {
+            edgeTable.maxY = std::max(edgeTable.maxY, edge.maximumY);
+        }
+        
         return edgeTable;
     }
 
     /**
-     * @brief Executa o algoritmo de preenchimento ET/AET
+     * @brief Executa o algoritmo ET/AET entregando os spans a um sink
      * @param polygonVertices Vetor com os vértices do polígono
-     * @param fillColor Cor do preenchimento
      * @param maxHeight Altura máxima da área de desenho
      * @param maxWidth Largura máxima da área de desenho
+     * @param sink Sink de spans (ver "Sinks do laço ET/AET")
      */
-    void fillPolygon(const std::vector<Point2D>& polygonVertices, 
-                    const ColorRGB& fillColor, 
-                    int maxHeight,
-                    int maxWidth) const {
+    template <typename Sink>
+    void scanPolygon(const std::vector<Point2D>& polygonVertices,
+                     int maxHeight,
+                     int maxWidth,
+                     Sink& sink) const {
         if (polygonVertices.size() < 3) {
             return;
         }
         
-        EdgeTable edgeTable = buildEdgeTable(polygonVertices, maxHeight);
-        
-        int currentScanLine = 0;
-        while (currentScanLine < edgeTable.size() && edgeTable[currentScanLine].empty()) {
-            currentScanLine++;
+        SparseEdgeTable edgeTable = buildSparseEdgeTable(polygonVertices, maxHeight);
+        scanBand(edgeTable, edgeTable.minY, edgeTable.maxY + 1, maxHeight, maxWidth, sink);
+    }
+
+    /**
+     * @brief Executa o algoritmo ET/AET e retorna os spans preenchidos
+     * @param polygonVertices Vetor com os vértices do polígono
+     * @param maxHeight Altura máxima da área de desenho
+     * @param maxWidth Largura máxima da área de desenho
+     * @return Lista de spans já recortados aos limites, em ordem crescente de Y
+     */
+    SpanList generateSpans(const std::vector<Point2D>& polygonVertices,
+                           int maxHeight,
+                           int maxWidth) const {
+        SpanList spans;
+        SpanListSink sink(spans);
+        scanPolygon(polygonVertices, maxHeight, maxWidth, sink);
+        return spans;
+    }
+
+    /**
+     * @brief Percorre uma faixa horizontal [bandStartY, bandEndY) da ET entregando os spans a um sink
+     * @param edgeTable ET compacta do polígono
+     * @param bandStartY Primeira scanline da faixa
+     * @param bandEndY Scanline logo após a última da faixa
+     * @param maxHeight Altura máxima da área de desenho
+     * @param maxWidth Largura máxima da área de desenho
+     * @param sink Sink de spans; recebe os da faixa em ordem crescente de Y
+     *
+     * A AET inicial sai da lista de arestas que cruzam bandStartY, sem rodar o laço
+     * ET/AET (ordenação, spans) nas scanlines anteriores; faixas diferentes podem
+     * rodar em threads diferentes sobre a mesma ET (somente leitura), cada uma com
+     * seu sink. No ponto fixo o X em bandStartY é calculado direto (soma inteira é
+     * exata); em double cada aresta ainda soma inverseSlope linha a linha desde
+     * minimumY, porque currentX + inverseSlope * n arredonda diferente da soma
+     * repetida e os spans deixariam de bater com os de generateSpans.
+     */
+    template <typename Sink>
+    void scanBand(const SparseEdgeTable& edgeTable,
+                  int bandStartY,
+                  int bandEndY,
+                  int maxHeight,
+                  int maxWidth,
+                  Sink& sink) const {
+        if (edgeTable.empty()) {
+            return;
         }
         
-        if (currentScanLine >= edgeTable.size()) {
+        bandStartY = std::max(bandStartY, edgeTable.minY);
+        bandEndY = std::min(bandEndY, std::min(edgeTable.maxY + 1, maxHeight));
+        scanRows(edgeTable, bandStartY, bandEndY, maxWidth, sink);
+    }
+
+    /**
+     * @brief Gera os spans de uma faixa horizontal [bandStartY, bandEndY) da ET
+     * @param spans Saída: spans da faixa são acrescentados em ordem crescente de Y
+     * @see scanBand
+     */
+    void generateSpansInBand(const SparseEdgeTable& edgeTable,
+                             int bandStartY,
+                             int bandEndY,
+                             int maxHeight,
+                             int maxWidth,
+                             SpanList& spans) const {
+        SpanListSink sink(spans);
+        scanBand(edgeTable, bandStartY, bandEndY, maxHeight, maxWidth, sink);
+    }
+
+    /**
+     * @brief Verifica se as arestas cabem na faixa do ponto fixo 16.16 sem overflow
+     *
+     * Confere o X nas duas pontas: uma aresta que começa perto de 0 ainda pode
+     * chegar a um vértice distante na última scanline. Toda aresta inserida avança
+     * ao menos uma vez, mesmo a que termina na própria linha de entrada.
+     */
+    static bool fitsFixedPointRange(const SparseEdgeTable& edgeTable) {
+        for (const EdgeData& edge : edgeTable.edges) {
+            double endX = edge.currentX + edge.inverseSlope * std::max(edge.maximumY - edge.minimumY, 1);
+            if (std::abs(edge.currentX) > FIXED_MAX_COORDINATE ||
+                std::abs(endX) > FIXED_MAX_COORDINATE ||
+                std::abs(edge.inverseSlope) > FIXED_MAX_COORDINATE ||
+                std::abs(edge.maximumY) > FIXED_MAX_COORDINATE) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    /**
+     * @brief Seleciona as arestas que atravessam a primeira scanline de uma faixa
+     * @param crossingEdges Saída: arestas com minimumY < bandStartY < maximumY, ainda sem avançar
+     * @return Índice da primeira aresta da ET com minimumY >= bandStartY
+     */
+    static size_t collectCrossingEdges(const SparseEdgeTable& edgeTable, int bandStartY,
+                                       std::vector<EdgeData>& crossingEdges) {
+        size_t edgeIndex = 0;
+        for (; edgeIndex < edgeTable.edges.size() && edgeTable.edges[edgeIndex].minimumY < bandStartY; ++edgeIndex) {
+            if (edgeTable.edges[edgeIndex].maximumY > bandStartY) {
+                crossingEdges.push_back(edgeTable.edges[edgeIndex]);
+            }
+        }
+        return edgeIndex;
+    }
+
+    /**
+     * @brief Núcleo do laço: escolhe a representação numérica e percorre [bandStartY, bandEndY)
+     *
+     * Sinks de trapézios sempre usam o laço em double (precisam de currentX e
+     * inverseSlope crus); sinks de spans seguem steppingMode.
+     */
+    template <typename Sink>
+    void scanRows(const SparseEdgeTable& edgeTable,
+                  int bandStartY,
+                  int bandEndY,
+                  int maxWidth,
+                  Sink& sink) const {
+        if (edgeTable.empty() || bandStartY >= bandEndY) {
             return;
         }
         
-        std::vector<EdgeData> activeEdgeTable;
+        std::vector<EdgeData> crossingEdges;
+        size_t firstPendingEdge = collectCrossingEdges(edgeTable, bandStartY, crossingEdges);
         
-        glColor3f(fillColor.redComponent, fillColor.greenComponent, fillColor.blueComponent);
+        if constexpr (!ScanlineSinkTraits::EmitsTrapezoids<Sink>::value) {
+            if (steppingMode == EdgeSteppingMode::FIXED_POINT && fitsFixedPointRange(edgeTable)) {
+                scanRowsFixedPoint(edgeTable, crossingEdges, firstPendingEdge, bandStartY, bandEndY, maxWidth, sink);
+                return;
+            }
+        }
         
-        while (currentScanLine < edgeTable.size() || !activeEdgeTable.empty()) {
+        // Mesma sequência de somas do laço serial (não a multiplicação), para que os spans saiam idênticos
+        for (EdgeData& edge : crossingEdges) {
+            for (int scanLine = edge.minimumY; scanLine < bandStartY; ++scanLine) {
+                edge.currentX += edge.inverseSlope;
+            }
+        }
+        std::sort(crossingEdges.begin(), crossingEdges.end(), isLeftOf);
+        scanRowsFloatingPoint(edgeTable, crossingEdges, firstPendingEdge, bandStartY, bandEndY, maxWidth, sink);
+    }
+
+    /**
+     * @brief Laço ET/AET em double de uma faixa
+     */
+    template <typename Sink>
+    void scanRowsFloatingPoint(const SparseEdgeTable& edgeTable,
+                               std::vector<EdgeData>& activeEdgeTable,
+                               size_t nextEdgeIndex,
+                               int bandStartY,
+                               int bandEndY,
+                               int maxWidth,
+                               Sink& sink) const {
+        int currentScanLine = bandStartY;
+        const size_t edgeCount = edgeTable.edges.size();
+        activeEdgeTable.reserve(edgeCount);
+        
+        while ((nextEdgeIndex < edgeCount || !activeEdgeTable.empty()) && currentScanLine < bandEndY) {
             
-            if (currentScanLine < edgeTable.size() && !edgeTable[currentScanLine].empty()) {
-                for (const EdgeData& edge : edgeTable[currentScanLine]) {
-                    activeEdgeTable.push_back(edge);
+            // AET vazia: salta direto para a próxima scanline que tem arestas
+            if (activeEdgeTable.empty() && edgeTable.edges[nextEdgeIndex].minimumY > currentScanLine) {
+                currentScanLine = edgeTable.edges[nextEdgeIndex].minimumY;
+                if (currentScanLine >= bandEndY) {
+                    break;
                 }
             }
             
-            std::sort(activeEdgeTable.begin(), activeEdgeTable.end(), 
-                [](const EdgeData& edge1, const EdgeData& edge2) {
-                    return edge1.currentX < edge2.currentX;
-                });
+            size_t bucketEnd = nextEdgeIndex;
+            while (bucketEnd < edgeCount && edgeTable.edges[bucketEnd].minimumY == currentScanLine) {
+                bucketEnd++;
+            }
+            updateActiveEdgeTable(activeEdgeTable,
+                                  edgeTable.edges.data() + nextEdgeIndex,
+                                  edgeTable.edges.data() + bucketEnd);
+            nextEdgeIndex = bucketEnd;
             
-            if (activeEdgeTable.size() >= 2) {
-                glBegin(GL_LINES); // Usar linhas para preencher o span horizontal
-                for (size_t edgeIndex = 0; edgeIndex < activeEdgeTable.size() - 1; edgeIndex += 2) {
-                    int x1 = static_cast<int>(activeEdgeTable[edgeIndex].currentX + 0.5);
-                    int x2 = static_cast<int>(activeEdgeTable[edgeIndex + 1].currentX + 0.5);
-                    
-                    if (x1 > x2) {
-                        std::swap(x1, x2);
-                    }
-                    
-                    // Clamping
-                    if (x1 < 0) x1 = 0;
-                    if (x2 >= maxWidth) x2 = maxWidth - 1;
-                    
-                    if (x1 <= x2 && currentScanLine >= 0 && currentScanLine < maxHeight) {
-                         glVertex2i(x1, currentScanLine);
-                         glVertex2i(x2 + 1, currentScanLine); 
-                    }
-                }
-                glEnd();
-                
-                if (activeEdgeTable.size() % 2 == 1) {
-                    int x = static_cast<int>(activeEdgeTable[activeEdgeTable.size() - 1].currentX + 0.5);
-                    if (x >= 0 && x < maxWidth && currentScanLine >= 0 && currentScanLine < maxHeight) {
-                        glBegin(GL_POINTS);
-                        glVertex2i(x, currentScanLine);
-                        glEnd();
-                    }
-                }
+            if (activeEdgeTable.size() >= 2 && currentScanLine >= 0) {
+                emitScanLine(activeEdgeTable, currentScanLine, maxWidth, sink,
+                             ScanlineSinkTraits::EmitsTrapezoids<Sink>());
             }
             
             currentScanLine++;
@@ -201,106 +567,152 @@ public:
                     }),
                 activeEdgeTable.end()
             );
-            
-            if (activeEdgeTable.empty() && currentScanLine >= edgeTable.size()) {
-                break;
-            }
         }
     }
+
     /**
-     * @brief Gera uma triangulação do polígono usando o algoritmo ET/AET (Scanline)
-     * @param polygonVertices Vetor com os vértices do polígono
-     * @param maxHeight Altura máxima da área de desenho
-     * @return Vetor de triângulos, onde cada triângulo é um vetor de 3 Point2D
+     * @brief Spans de uma scanline da AET em double (sinks de spans)
      */
-    std::vector<std::vector<Point2D>> generateTriangulation(const std::vector<Point2D>& polygonVertices, int maxHeight) const {
-        std::vector<std::vector<Point2D>> triangles;
-        
-        if (polygonVertices.size() < 3) {
-            return triangles;
+    template <typename Sink>
+    static void emitScanLine(const std::vector<EdgeData>& activeEdgeTable, int currentScanLine,
+                             int maxWidth, Sink& sink, std::false_type) {
+        for (size_t edgeIndex = 0; edgeIndex < activeEdgeTable.size() - 1; edgeIndex += 2) {
+            int x1 = static_cast<int>(activeEdgeTable[edgeIndex].currentX + 0.5);
+            int x2 = static_cast<int>(activeEdgeTable[edgeIndex + 1].currentX + 0.5);
+            
+            if (x1 > x2) {
+                std::swap(x1, x2);
+            }
+            
+            // Clamping
+            if (x1 < 0) x1 = 0;
+            if (x2 >= maxWidth) x2 = maxWidth - 1;
+            
+            if (x1 <= x2) {
+                sink.span(currentScanLine, x1, x2);
+            }
         }
         
-        EdgeTable edgeTable = buildEdgeTable(polygonVertices, maxHeight);
-        
-        int currentScanLine = 0;
-        while (currentScanLine < edgeTable.size() && edgeTable[currentScanLine].empty()) {
-            currentScanLine++;
+        // Aresta ímpar restante vira um span de um único pixel
+        if (activeEdgeTable.size() % 2 == 1) {
+            int x = static_cast<int>(activeEdgeTable[activeEdgeTable.size() - 1].currentX + 0.5);
+            if (x >= 0 && x < maxWidth) {
+                sink.span(currentScanLine, x, x);
+            }
         }
-        
-        if (currentScanLine >= edgeTable.size()) {
-            return triangles;
+    }
+
+    /**
+     * @brief Trapézios de altura 1 entre os pares de arestas da scanline (sinks de trapézios)
+     *
+     * Uma aresta ímpar restante não forma par e é ignorada.
+     */
+    template <typename Sink>
+    static void emitScanLine(const std::vector<EdgeData>& activeEdgeTable, int currentScanLine,
+                             int, Sink& sink, std::true_type) {
+        for (size_t edgeIndex = 0; edgeIndex + 1 < activeEdgeTable.size(); edgeIndex += 2) {
+            const EdgeData& left = activeEdgeTable[edgeIndex];
+            const EdgeData& right = activeEdgeTable[edgeIndex + 1];
+            sink.trapezoid(currentScanLine, left.currentX, right.currentX,
+                           left.currentX + left.inverseSlope, right.currentX + right.inverseSlope);
         }
+    }
+
+    /**
+     * @brief Laço ET/AET de uma faixa com DDA inteiro 16.16
+     *
+     * A AET fica em SoA e, a cada scanline, todas as arestas são arredondadas
+     * e avançadas em lote pelo kernel SIMD; não há double no laço principal.
+     */
+    template <typename Sink>
+    void scanRowsFixedPoint(const SparseEdgeTable& edgeTable,
+                            const std::vector<EdgeData>& crossingEdges,
+                            size_t nextEdgeIndex,
+                            int bandStartY,
+                            int bandEndY,
+                            int maxWidth,
+                            Sink& sink) const {
+        int currentScanLine = bandStartY;
+        const size_t edgeCount = edgeTable.edges.size();
         
-        std::vector<EdgeData> activeEdgeTable;
+        FixedPointActiveEdgeTable activeEdgeTable;
+        activeEdgeTable.reserve(edgeCount);
+        activeEdgeTable.insertAtScanLine(crossingEdges.data(), crossingEdges.data() + crossingEdges.size(), bandStartY);
         
-        while (currentScanLine < edgeTable.size() || !activeEdgeTable.empty()) {
+        while ((nextEdgeIndex < edgeCount || !activeEdgeTable.empty()) && currentScanLine < bandEndY) {
             
-            // 1. Mover arestas da ET para AET
-            if (currentScanLine < edgeTable.size() && !edgeTable[currentScanLine].empty()) {
-                for (const EdgeData& edge : edgeTable[currentScanLine]) {
-                    activeEdgeTable.push_back(edge);
+            if (activeEdgeTable.empty() && edgeTable.edges[nextEdgeIndex].minimumY > currentScanLine) {
+                currentScanLine = edgeTable.edges[nextEdgeIndex].minimumY;
+                if (currentScanLine >= bandEndY) {
+                    break;
                 }
             }
             
-            // 2. Ordenar AET por X
-            std::sort(activeEdgeTable.begin(), activeEdgeTable.end(), 
-                [](const EdgeData& edge1, const EdgeData& edge2) {
-                    return edge1.currentX < edge2.currentX;
-                });
-            
-            // 3. Gerar triângulos (trapezoides degenerados) para os spans
-            // A ideia é conectar o span atual com o span da próxima linha (ou anterior)
-            // Mas para simplificar e garantir robustez, vamos gerar "faixas" de 1 pixel de altura
-            // Isso gera muitos triângulos, mas resolve o problema de concavidade e auto-interseção
-            // Otimização: Poderíamos tentar agrupar linhas, mas a lógica de mudança de topologia é complexa.
+            size_t bucketEnd = nextEdgeIndex;
+            while (bucketEnd < edgeCount && edgeTable.edges[bucketEnd].minimumY == currentScanLine) {
+                bucketEnd++;
+            }
+            activeEdgeTable.restoreOrder();
+            activeEdgeTable.insert(edgeTable.edges.data() + nextEdgeIndex,
+                                   edgeTable.edges.data() + bucketEnd);
+            nextEdgeIndex = bucketEnd;
             
-            if (activeEdgeTable.size() >= 2) {
-                for (size_t i = 0; i < activeEdgeTable.size() - 1; i += 2) {
-                    double x1_start = activeEdgeTable[i].currentX;
-                    double x2_start = activeEdgeTable[i+1].currentX;
-                    
-                    // Previsão do próximo X (para formar o quad/triângulos)
-                    double x1_end = x1_start + activeEdgeTable[i].inverseSlope;
-                    double x2_end = x2_start + activeEdgeTable[i+1].inverseSlope;
-                    
-                    // Criar 2 triângulos para representar esse trapézio de altura 1
-                    // T1: (x1_start, y), (x2_start, y), (x1_end, y+1)
-                    // T2: (x2_start, y), (x2_end, y+1), (x1_end, y+1)
+            size_t activeCount = activeEdgeTable.size();
+            if (activeCount >= 2 && currentScanLine >= 0) {
+                const int* endpoints = activeEdgeTable.computeSpanEndpoints();
+                
+                for (size_t edgeIndex = 0; edgeIndex < activeCount - 1; edgeIndex += 2) {
+                    int x1 = endpoints[edgeIndex];
+                    int x2 = endpoints[edgeIndex + 1];
                     
-                    Point2D p1((int)x1_start, currentScanLine);
-                    Point2D p2((int)x2_start, currentScanLine);
-                    Point2D p3((int)x1_end, currentScanLine + 1);
-                    Point2D p4((int)x2_end, currentScanLine + 1);
+                    if (x1 > x2) {
+                        std::swap(x1, x2);
+                    }
                     
-                    // Adiciona T1
-                    triangles.push_back({p1, p2, p3});
+                    if (x1 < 0) x1 = 0;
+                    if (x2 >= maxWidth) x2 = maxWidth - 1;
                     
-                    // Adiciona T2
-                    triangles.push_back({p2, p4, p3});
+                    if (x1 <= x2) {
+                        sink.span(currentScanLine, x1, x2);
+                    }
+                }
+                
+                if (activeCount % 2 == 1) {
+                    int x = endpoints[activeCount - 1];
+                    if (x >= 0 && x < maxWidth) {
+                        sink.span(currentScanLine, x, x);
+                    }
                 }
             }
             
-            // 4. Incrementar Y e X
             currentScanLine++;
-            
-            for (EdgeData& edge : activeEdgeTable) {
-                edge.currentX += edge.inverseSlope;
-            }
-            
-            // 5. Remover arestas que terminaram
-            activeEdgeTable.erase(
-                std::remove_if(activeEdgeTable.begin(), activeEdgeTable.end(), 
-                    [currentScanLine](const EdgeData& edge) { 
-                        return edge.maximumY <= currentScanLine; 
-                    }),
-                activeEdgeTable.end()
-            );
-            
-            if (activeEdgeTable.empty() && currentScanLine >= edgeTable.size()) {
-                break;
-            }
+            activeEdgeTable.advance();
+            activeEdgeTable.removeFinishedEdges(currentScanLine);
+        }
+    }
+
+public:
+    /**
+     * @brief Gera uma triangulação do polígono usando o algoritmo ET/AET (Scanline)
+     * @param polygonVertices Vetor com os vértices do polígono
+     * @param maxHeight Altura máxima da área de desenho
+     * @return Vetor de triângulos, onde cada triângulo é um vetor de 3 Point2D
+     *
+     * Cada par de arestas vira uma faixa de 1 pixel de altura (2 triângulos), do
+     * topo ao fim do polígono: resolve concavidade e auto-interseção ao custo de
+     * muitos triângulos.
+     */
+    std::vector<std::vector<Point2D>> generateTriangulation(const std::vector<Point2D>& polygonVertices, int maxHeight) const {
+        std::vector<std::vector<Point2D>> triangles;
+        
+        if (polygonVertices.size() < 3) {
+            return triangles;
         }
         
+        SparseEdgeTable edgeTable = buildSparseEdgeTable(polygonVertices, maxHeight);
+        TriangulationSink sink(triangles);
+        // Sem recorte em maxHeight: as faixas vão até a última aresta terminar
+        scanRows(edgeTable, edgeTable.minY, edgeTable.maxY + 1, 0, sink);
         return triangles;
     }
 };
@@ -9,6 +9,10 @@
 #define POLYGON_MANAGER_H
 
 #include "data_structures.h"
+#include "polygon_fill_algorithm.h"
+#include "polygon_spatial_index.h"
+#include "damage_tracker.h"
+#include <cmath>
 #include <vector>
 
 /**
@@ -27,24 +31,104 @@ public:
         PolygonConfiguration configuration;
         bool isFilled;
         
+        // Cache dos spans do preenchimento: o ET/AET roda uma vez e cada frame só reproduz os spans
+        SpanList fillSpans;
+        int spanCacheHeight; // Limites usados na geração do cache (-1 = cache inválido)
+        int spanCacheWidth;
+        
+        // Identidade estável (não muda ao editar); chave dos caches derivados, como a extrusão 3D
+        unsigned long id;
+        
+        ScreenRect bounds; // Caixa dos vértices (sem a espessura da linha)
+        
         SavedPolygon(const std::vector<Point2D>& verts, const PolygonConfiguration& config, bool filled)
-            : vertices(verts), configuration(config), isFilled(filled) {}
+            : vertices(verts), configuration(config), isFilled(filled),
+              spanCacheHeight(-1), spanCacheWidth(-1), id(0), bounds(ScreenRect::boundsOf(verts)) {}
+        
+        /**
+         * @brief Verifica se o cache de spans é válido para os limites informados
+         */
+        bool hasSpanCache(int maxHeight, int maxWidth) const {
+            return spanCacheHeight == maxHeight && spanCacheWidth == maxWidth;
+        }
     };
     
 private:
     std::vector<SavedPolygon> savedPolygons;
+    PolygonFillAlgorithm fillAlgorithm;
+    int spanCacheHeight;
+    int spanCacheWidth;
+    unsigned long savedPolygonsRevision; // Incrementado a cada mudança nos polígonos salvos
+    unsigned long nextPolygonId;
+    PolygonSpatialIndex spatialIndex;      // Vértices e arestas dos polígonos salvos, atualizado a cada edição
+    DamageTracker damage;                  // Regiões da área de desenho alteradas desde o último redesenho
+
+    void damageSavedPolygon(const SavedPolygon& savedPolygon) {
+        damage.addRect(savedPolygon.bounds.expanded(damagePadding(savedPolygon.configuration)));
+    }
+
+    void damageCurrentPolygon() {
+        damage.addBounds(polygonVertices, damagePadding(visualConfiguration));
+    }
+
+    /**
+     * @brief Troca os vértices de um polígono salvo atualizando índice, caches e caixa (sem marcar dano)
+     */
+    void replaceSavedPolygonVertices(size_t polygonIndex, const std::vector<Point2D>& newVertices) {
+        SavedPolygon& savedPolygon = savedPolygons[polygonIndex];
+        spatialIndex.removePolygon(static_cast<int>(polygonIndex), savedPolygon.vertices);
+        savedPolygon.vertices = newVertices;
+        savedPolygon.bounds = ScreenRect::boundsOf(newVertices);
+        spatialIndex.addPolygon(static_cast<int>(polygonIndex), newVertices);
+        rebuildSpanCache(savedPolygon);
+        savedPolygonsRevision++;
+    }
+
+    /**
+     * @brief Recalcula o cache de spans de um polígono salvo
+     * @param savedPolygon Polígono cujo cache será reconstruído
+     */
+    void rebuildSpanCache(SavedPolygon& savedPolygon) const {
+        savedPolygon.fillSpans.clear();
+        if (savedPolygon.isFilled) {
+            savedPolygon.fillSpans = fillAlgorithm.generateSpans(savedPolygon.vertices, spanCacheHeight, spanCacheWidth);
+        }
+        savedPolygon.spanCacheHeight = spanCacheHeight;
+        savedPolygon.spanCacheWidth = spanCacheWidth;
+    }
 
 public:
+    /**
+     * @brief Folga em volta das coordenadas para cobrir a espessura da linha e os marcadores de vértice
+     */
+    static int damagePadding(const PolygonConfiguration& configuration) {
+        return static_cast<int>(std::ceil(std::max(configuration.lineThickness, VERTEX_MARKER_SIZE) / 2.0f)) + 2;
+    }
+
     /**
      * @brief Construtor da classe PolygonManager
      */
-    PolygonManager() : isPolygonClosed(false) {}
+    PolygonManager() : isPolygonClosed(false),
+                       fillAlgorithm(AETOrderingMode::INCREMENTAL, EdgeSteppingMode::FLOATING_POINT),
+                       spanCacheHeight(WINDOW_HEIGHT), spanCacheWidth(WINDOW_WIDTH),
+                       savedPolygonsRevision(0), nextPolygonId(1) {
+        spatialIndex.reset(spanCacheWidth, spanCacheHeight);
+    }
 
     /**
      * @brief Adiciona um novo vértice ao polígono
      * @param newVertex Ponto a ser adicionado como vértice
      */
     void addVertex(const Point2D& newVertex) {
+        int padding = damagePadding(visualConfiguration);
+        if (!polygonVertices.empty()) {
+            if (isPolygonClosed) {
+                damage.addEdge(polygonVertices.back(), polygonVertices.front(), padding); // A aresta de fechamento some
+            }
+            damage.addEdge(polygonVertices.back(), newVertex, padding);
+        } else {
+            damage.addEdge(newVertex, newVertex, padding);
+        }
         polygonVertices.push_back(newVertex);
         isPolygonClosed = false;
     }
@@ -54,6 +138,12 @@ public:
      */
     void removeLastVertex() {
         if (!polygonVertices.empty()) {
+            int padding = damagePadding(visualConfiguration);
+            const Point2D& removed = polygonVertices.back();
+            damage.addEdge(polygonVertices[polygonVertices.size() > 1 ? polygonVertices.size() - 2 : 0], removed, padding);
+            if (isPolygonClosed) {
+                damage.addEdge(removed, polygonVertices.front(), padding);
+            }
             polygonVertices.pop_back();
             isPolygonClosed = false;
         }
@@ -64,6 +154,9 @@ public:
      */
     void closePolygon() {
         if (polygonVertices.size() >= 3) {
+            if (!isPolygonClosed) {
+                damage.addEdge(polygonVertices.back(), polygonVertices.front(), damagePadding(visualConfiguration));
+            }
             isPolygonClosed = true;
         }
     }
@@ -72,6 +165,7 @@ public:
      * @brief Limpa todos os vértices do polígono
      */
     void clearPolygon() {
+        damageCurrentPolygon();
         polygonVertices.clear();
         isPolygonClosed = false;
     }
@@ -116,6 +210,7 @@ public:
      */
     void setLineColor(float redComponent, float greenComponent, float blueComponent) {
         visualConfiguration.lineColor = ColorRGB(redComponent, greenComponent, blueComponent);
+        damageCurrentPolygon();
     }
 
     /**
@@ -126,6 +221,7 @@ public:
      */
     void setFillColor(float redComponent, float greenComponent, float blueComponent) {
         visualConfiguration.fillColor = ColorRGB(redComponent, greenComponent, blueComponent);
+        damageCurrentPolygon();
     }
 
     /**
@@ -133,7 +229,9 @@ public:
      * @param thickness Nova espessura das linhas
      */
     void setLineThickness(float thickness) {
+        damageCurrentPolygon(); // Com a espessura antiga, caso diminua
         visualConfiguration.lineThickness = thickness;
+        damageCurrentPolygon();
     }
 
     /**
@@ -142,6 +240,7 @@ public:
      */
     void setShowVertices(bool shouldShow) {
         visualConfiguration.showVertices = shouldShow;
+        damageCurrentPolygon();
     }
 
     /**
@@ -194,11 +293,13 @@ public:
      * @param increase true para aumentar, false para diminuir
      */
     void adjustLineThickness(bool increase) {
+        damageCurrentPolygon();
         if (increase) {
             visualConfiguration.lineThickness = std::min(10.0f, visualConfiguration.lineThickness + 1.0f);
         } else {
             visualConfiguration.lineThickness = std::max(1.0f, visualConfiguration.lineThickness - 1.0f);
         }
+        damageCurrentPolygon();
     }
 
     /**
@@ -206,6 +307,7 @@ public:
      */
     void toggleVertexVisibility() {
         visualConfiguration.showVertices = !visualConfiguration.showVertices;
+        damageCurrentPolygon();
     }
 
     /**
@@ -215,9 +317,65 @@ public:
     void saveCurrentPolygon(bool isFilled = false) {
         if (polygonVertices.size() >= 3 && isPolygonClosed) {
             savedPolygons.push_back(SavedPolygon(polygonVertices, visualConfiguration, isFilled));
+            savedPolygons.back().id = nextPolygonId++;
+            rebuildSpanCache(savedPolygons.back());
+            spatialIndex.addPolygon(static_cast<int>(savedPolygons.size() - 1), polygonVertices);
+            damageSavedPolygon(savedPolygons.back());
+            savedPolygonsRevision++;
         }
     }
 
+    /**
+     * @brief Substitui os vértices de um polígono salvo e invalida seu cache de spans
+     * @param polygonIndex Índice do polígono salvo
+     * @param newVertices Novos vértices
+     */
+    void setSavedPolygonVertices(size_t polygonIndex, const std::vector<Point2D>& newVertices) {
+        if (polygonIndex >= savedPolygons.size()) {
+            return;
+        }
+        damageSavedPolygon(savedPolygons[polygonIndex]);
+        replaceSavedPolygonVertices(polygonIndex, newVertices);
+        damageSavedPolygon(savedPolygons[polygonIndex]);
+    }
+
+    /**
+     * @brief Substitui a configuração visual de um polígono salvo
+     * @param polygonIndex Índice do polígono salvo
+     * @param newConfiguration Nova configuração
+     *
+     * A geometria dos spans não depende de cor nem espessura, então o cache é mantido.
+     */
+    void setSavedPolygonConfiguration(size_t polygonIndex, const PolygonConfiguration& newConfiguration) {
+        if (polygonIndex >= savedPolygons.size()) {
+            return;
+        }
+        damageSavedPolygon(savedPolygons[polygonIndex]);
+        savedPolygons[polygonIndex].configuration = newConfiguration;
+        damageSavedPolygon(savedPolygons[polygonIndex]);
+        savedPolygonsRevision++;
+    }
+
+    /**
+     * @brief Define os limites de recorte dos caches de spans, reconstruindo-os se mudarem
+     * @param maxHeight Altura máxima da área de desenho
+     * @param maxWidth Largura máxima da área de desenho
+     */
+    void setSpanCacheBounds(int maxHeight, int maxWidth) {
+        if (maxHeight == spanCacheHeight && maxWidth == spanCacheWidth) {
+            return;
+        }
+        spanCacheHeight = maxHeight;
+        spanCacheWidth = maxWidth;
+        spatialIndex.reset(maxWidth, maxHeight);
+        for (size_t i = 0; i < savedPolygons.size(); i++) {
+            rebuildSpanCache(savedPolygons[i]);
+            spatialIndex.addPolygon(static_cast<int>(i), savedPolygons[i].vertices);
+        }
+        damage.invalidateAll();
+        savedPolygonsRevision++;
+    }
+
     /**
      * @brief Retorna uma referência constante aos polígonos salvos
      * @return Referência constante ao vetor de polígonos salvos
@@ -231,11 +389,102 @@ public:
      */
     void clearSavedPolygons() {
         savedPolygons.clear();
+        spatialIndex.clear();
+        damage.invalidateAll();
+        savedPolygonsRevision++;
+    }
+
+    /**
+     * @brief Substitui todos os polígonos salvos (carga de uma cena)
+     * @param polygons Novos polígonos; recebem ids novos e caches de spans recalculados
+     */
+    void loadSavedPolygons(std::vector<SavedPolygon>&& polygons) {
+        savedPolygons = std::move(polygons);
+        spatialIndex.reset(spanCacheWidth, spanCacheHeight);
+        for (size_t i = 0; i < savedPolygons.size(); i++) {
+            savedPolygons[i].id = nextPolygonId++;
+            savedPolygons[i].bounds = ScreenRect::boundsOf(savedPolygons[i].vertices);
+            rebuildSpanCache(savedPolygons[i]);
+            spatialIndex.addPolygon(static_cast<int>(i), savedPolygons[i].vertices);
+        }
+        damage.invalidateAll();
+        savedPolygonsRevision++;
+    }
+
+    /**
+     * @brief Áreas alteradas por qualquer edição dos polígonos (salvos ou o atual)
+     *
+     * Quem redesenha consome e limpa; mudanças que o gerenciador não vê (como o
+     * estado de preenchimento do polígono atual) são marcadas por quem as faz.
+     */
+    DamageTracker& getDamage() {
+        return damage;
+    }
+
+    /**
+     * @brief Retorna a revisão atual dos polígonos salvos (muda a cada alteração)
+     */
+    unsigned long getSavedPolygonsRevision() const {
+        return savedPolygonsRevision;
     }
 
     size_t getSavedPolygonCount() const {
         return savedPolygons.size();
     }
+
+    /**
+     * @brief Vértice salvo mais próximo de um ponto
+     * @param point Posição do cursor
+     * @param tolerance Distância máxima em pixels
+     * @return Polígono e vértice; inválido se nenhum estiver perto
+     */
+    PolygonPick pickSavedVertex(const Point2D& point, int tolerance) const {
+        return spatialIndex.pickVertex(savedPolygons, point, tolerance);
+    }
+
+    /**
+     * @brief Aresta salva mais próxima de um ponto (elementIndex é o vértice onde ela começa)
+     */
+    PolygonPick pickSavedEdge(const Point2D& point, int tolerance) const {
+        return spatialIndex.pickEdge(savedPolygons, point, tolerance);
+    }
+
+    /**
+     * @brief Move um vértice de um polígono salvo
+     */
+    void moveSavedVertex(size_t polygonIndex, size_t vertexIndex, const Point2D& newPosition) {
+        if (polygonIndex >= savedPolygons.size() || vertexIndex >= savedPolygons[polygonIndex].vertices.size()) {
+            return;
+        }
+        std::vector<Point2D> vertices = savedPolygons[polygonIndex].vertices;
+        
+        // Só os triângulos (anterior, vértice, seguinte) antes e depois mudam, contorno e preenchimento
+        size_t count = vertices.size();
+        ScreenRect changed;
+        for (const Point2D& point : { vertices[(vertexIndex + count - 1) % count], vertices[vertexIndex],
+                                      vertices[(vertexIndex + 1) % count], newPosition }) {
+            changed.include(point.coordinateX, point.coordinateY);
+        }
+        damage.addRect(changed.expanded(damagePadding(savedPolygons[polygonIndex].configuration)));
+        
+        vertices[vertexIndex] = newPosition;
+        replaceSavedPolygonVertices(polygonIndex, vertices);
+    }
+
+    /**
+     * @brief Desloca todos os vértices de um polígono salvo
+     */
+    void translateSavedPolygon(size_t polygonIndex, int deltaX, int deltaY) {
+        if (polygonIndex >= savedPolygons.size() || (deltaX == 0 && deltaY == 0)) {
+            return;
+        }
+        std::vector<Point2D> vertices = savedPolygons[polygonIndex].vertices;
+        for (Point2D& vertex : vertices) {
+            vertex.coordinateX += deltaX;
+            vertex.coordinateY += deltaY;
+        }
+        setSavedPolygonVertices(polygonIndex, vertices);
+    }
 };
 
 #endif // POLYGON_MANAGER_H
\ No newline at end of file
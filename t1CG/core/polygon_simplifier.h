@@ -0,0 +1,132 @@
+/**
+ * @file polygon_simplifier.h
+ * @brief Simplificação de contornos fechados por Douglas-Peucker, para os níveis de detalhe das extrusões
+ * @author Sistema de Computação Gráfica
+ * @date 2025
+ */
+
+#ifndef POLYGON_SIMPLIFIER_H
+#define POLYGON_SIMPLIFIER_H
+
+#include "data_structures.h"
+#include <utility>
+#include <vector>
+
+/**
+ * @class PolygonSimplifier
+ * @brief Remove vértices que desviam menos que uma tolerância do contorno simplificado
+ *
+ * O resultado é um subconjunto dos vértices de entrada, na mesma ordem; nenhum
+ * ponto da entrada fica a mais de tolerance pixels do contorno resultante. O
+ * contorno é dividido em duas cadeias entre o vértice 0 e o vértice mais
+ * distante dele, e cada cadeia é simplificada com uma pilha explícita (sem
+ * recursão, para contornos grandes).
+ */
+class PolygonSimplifier {
+private:
+    /**
+     * @brief Quadrado da distância de p ao segmento [a, b]
+     */
+    static double distanceToSegmentSquared(const Point2D& p, const Point2D& a, const Point2D& b) {
+        double dx = b.coordinateX - a.coordinateX;
+        double dy = b.coordinateY - a.coordinateY;
+        double px = p.coordinateX - a.coordinateX;
+        double py = p.coordinateY - a.coordinateY;
+        double lengthSquared = dx * dx + dy * dy;
+        if (lengthSquared > 0.0) {
+            double t = (px * dx + py * dy) / lengthSquared;
+            if (t >= 1.0) {
+                px -= dx;
+                py -= dy;
+            } else if (t > 0.0) {
+                px -= t * dx;
+                py -= t * dy;
+            }
+        }
+        return px * px + py * py;
+    }
+
+    /**
+     * @brief Marca em keep os vértices que a cadeia first..last (índices módulo n) precisa manter
+     */
+    static void simplifyChain(const std::vector<Point2D>& vertices, size_t first, size_t last,
+                              double toleranceSquared, std::vector<char>& keep) {
+        const size_t n = vertices.size();
+        std::vector<std::pair<size_t, size_t>> pending;
+        pending.push_back(std::make_pair(first, last));
+
+        while (!pending.empty()) {
+            size_t start = pending.back().first;
+            size_t end = pending.back().second;
+            pending.pop_back();
+
+            const Point2D& a = vertices[start % n];
+            const Point2D& b = vertices[end % n];
+            // Empates ficam com o vértice mais perto do meio da cadeia: serrilhados regulares
+            // (todos à mesma distância) dividiriam a cadeia um vértice por vez, em O(n^2)
+            const size_t middle = start + (end - start) / 2;
+            double farthestDistance = -1.0;
+            size_t farthest = start;
+            for (size_t i = start + 1; i < end; i++) {
+                double distance = distanceToSegmentSquared(vertices[i % n], a, b);
+                if (distance > farthestDistance ||
+                    (distance == farthestDistance && (i > middle ? i - middle : middle - i) <
+                                                     (farthest > middle ? farthest - middle : middle - farthest))) {
+                    farthestDistance = distance;
+                    farthest = i;
+                }
+            }
+
+            if (farthestDistance > toleranceSquared) {
+                keep[farthest % n] = 1;
+                pending.push_back(std::make_pair(start, farthest));
+                pending.push_back(std::make_pair(farthest, end));
+            }
+        }
+    }
+
+public:
+    /**
+     * @brief Simplifica um contorno fechado
+     * @param vertices Contorno (o último vértice liga ao primeiro)
+     * @param tolerance Desvio máximo permitido, nas unidades dos vértices
+     * @return Vértices mantidos; pode ter menos de 3 se o contorno se reduzir a um segmento
+     */
+    static std::vector<Point2D> simplifyClosed(const std::vector<Point2D>& vertices, float tolerance) {
+        const size_t n = vertices.size();
+        if (n <= 3 || tolerance <= 0.0f) {
+            return vertices;
+        }
+
+        // Segunda âncora: o vértice mais distante do primeiro
+        size_t anchor = 0;
+        double anchorDistance = 0.0;
+        for (size_t i = 1; i < n; i++) {
+            double distance = distanceToSegmentSquared(vertices[i], vertices[0], vertices[0]);
+            if (distance > anchorDistance) {
+                anchorDistance = distance;
+                anchor = i;
+            }
+        }
+        if (anchor == 0) {
+            return std::vector<Point2D>(1, vertices[0]); // Todos os vértices no mesmo ponto
+        }
+
+        std::vector<char> keep(n, 0);
+        keep[0] = 1;
+        keep[anchor] = 1;
+        double toleranceSquared = static_cast<double>(tolerance) * tolerance;
+        simplifyChain(vertices, 0, anchor, toleranceSquared, keep);
+        simplifyChain(vertices, anchor, n, toleranceSquared, keep); // n volta ao vértice 0
+
+        std::vector<Point2D> simplified;
+        for (size_t i = 0; i < n; i++) {
+            if (keep[i]) {
+                simplified.push_back(vertices[i]);
+            }
+        }
+        return simplified;
+    }
+};
+
+#endif // POLYGON_SIMPLIFIER_H
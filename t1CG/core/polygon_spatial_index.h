@@ -0,0 +1,155 @@
+/**
+ * @file polygon_spatial_index.h
+ * @brief Índice espacial dos vértices e arestas dos polígonos salvos, para picking no editor
+ * @author Sistema de Computação Gráfica
+ * @date 2025
+ */
+
+#ifndef POLYGON_SPATIAL_INDEX_H
+#define POLYGON_SPATIAL_INDEX_H
+
+#include "data_structures.h"
+#include "spatial_grid.h"
+#include <algorithm>
+#include <vector>
+
+/**
+ * @brief Um vértice (ou a aresta que começa nele) de um polígono salvo
+ */
+struct PolygonPick {
+    int polygonIndex;
+    int elementIndex;  // Vértice, ou aresta elementIndex -> elementIndex + 1
+
+    PolygonPick(int polygon = -1, int element = -1) : polygonIndex(polygon), elementIndex(element) {}
+
+    bool isValid() const { return polygonIndex >= 0 && elementIndex >= 0; }
+};
+
+/**
+ * @class PolygonSpatialIndex
+ * @brief Duas grades uniformes: uma com os vértices e outra com a caixa de cada aresta
+ *
+ * O índice não guarda coordenadas, só (polígono, elemento); as consultas
+ * recebem a lista de polígonos para medir distâncias. Mudanças em um
+ * polígono são aplicadas tirando e recolocando só as entradas dele.
+ */
+class PolygonSpatialIndex {
+public:
+    static constexpr float CELL_SIZE = 32.0f;
+
+private:
+    UniformGrid<PolygonPick> vertexGrid;
+    UniformGrid<PolygonPick> edgeGrid;
+
+    static void edgeBounds(const std::vector<Point2D>& vertices, size_t edge,
+                           float& minX, float& minY, float& maxX, float& maxY) {
+        const Point2D& from = vertices[edge];
+        const Point2D& to = vertices[(edge + 1) % vertices.size()];
+        minX = static_cast<float>(std::min(from.coordinateX, to.coordinateX));
+        maxX = static_cast<float>(std::max(from.coordinateX, to.coordinateX));
+        minY = static_cast<float>(std::min(from.coordinateY, to.coordinateY));
+        maxY = static_cast<float>(std::max(from.coordinateY, to.coordinateY));
+    }
+
+    static long long squaredDistanceToSegment(const Point2D& point, const Point2D& from, const Point2D& to) {
+        long long dx = to.coordinateX - from.coordinateX;
+        long long dy = to.coordinateY - from.coordinateY;
+        long long px = point.coordinateX - from.coordinateX;
+        long long py = point.coordinateY - from.coordinateY;
+        long long lengthSquared = dx * dx + dy * dy;
+        if (lengthSquared == 0) {
+            return px * px + py * py;
+        }
+        double t = static_cast<double>(px * dx + py * dy) / lengthSquared;
+        t = std::min(1.0, std::max(0.0, t));
+        double ex = px - t * dx;
+        double ey = py - t * dy;
+        return static_cast<long long>(ex * ex + ey * ey);
+    }
+
+public:
+    /**
+     * @brief Esvazia o índice e ajusta a área coberta (a área de desenho)
+     */
+    void reset(int width, int height) {
+        vertexGrid.reset(0.0f, 0.0f, static_cast<float>(width), static_cast<float>(height), CELL_SIZE);
+        edgeGrid.reset(0.0f, 0.0f, static_cast<float>(width), static_cast<float>(height), CELL_SIZE);
+    }
+
+    void clear() {
+        vertexGrid.clear();
+        edgeGrid.clear();
+    }
+
+    void addPolygon(int polygonIndex, const std::vector<Point2D>& vertices) {
+        for (size_t i = 0; i < vertices.size(); i++) {
+            PolygonPick entry(polygonIndex, static_cast<int>(i));
+            vertexGrid.insertPoint(entry, static_cast<float>(vertices[i].coordinateX),
+                                   static_cast<float>(vertices[i].coordinateY));
+            float minX, minY, maxX, maxY;
+            edgeBounds(vertices, i, minX, minY, maxX, maxY);
+            edgeGrid.insert(entry, minX, minY, maxX, maxY);
+        }
+    }
+
+    /**
+     * @brief Tira as entradas de um polígono
+     * @param vertices Vértices com que ele foi adicionado (definem as células a limpar)
+     */
+    void removePolygon(int polygonIndex, const std::vector<Point2D>& vertices) {
+        auto belongs = [polygonIndex](const PolygonPick& entry) { return entry.polygonIndex == polygonIndex; };
+        for (size_t i = 0; i < vertices.size(); i++) {
+            float x = static_cast<float>(vertices[i].coordinateX);
+            float y = static_cast<float>(vertices[i].coordinateY);
+            vertexGrid.removeIf(x, y, x, y, belongs);
+            float minX, minY, maxX, maxY;
+            edgeBounds(vertices, i, minX, minY, maxX, maxY);
+            edgeGrid.removeIf(minX, minY, maxX, maxY, belongs);
+        }
+    }
+
+    /**
+     * @brief Vértice mais próximo do ponto dentro da tolerância
+     * @param polygons Lista indexada por polygonIndex com o membro vertices
+     */
+    template <typename PolygonList>
+    PolygonPick pickVertex(const PolygonList& polygons, const Point2D& point, int tolerance) const {
+        PolygonPick best;
+        long long bestDistance = static_cast<long long>(tolerance) * tolerance;
+        vertexGrid.forEachNear(static_cast<float>(point.coordinateX), static_cast<float>(point.coordinateY),
+                               static_cast<float>(tolerance), [&](const PolygonPick& entry) {
+            const Point2D& vertex = polygons[entry.polygonIndex].vertices[entry.elementIndex];
+            long long dx = vertex.coordinateX - point.coordinateX;
+            long long dy = vertex.coordinateY - point.coordinateY;
+            long long distance = dx * dx + dy * dy;
+            if (distance <= bestDistance) {
+                bestDistance = distance;
+                best = entry;
+            }
+        });
+        return best;
+    }
+
+    /**
+     * @brief Aresta mais próxima do ponto dentro da tolerância
+     */
+    template <typename PolygonList>
+    PolygonPick pickEdge(const PolygonList& polygons, const Point2D& point, int tolerance) const {
+        PolygonPick best;
+        long long bestDistance = static_cast<long long>(tolerance) * tolerance;
+        edgeGrid.forEachNear(static_cast<float>(point.coordinateX), static_cast<float>(point.coordinateY),
+                             static_cast<float>(tolerance), [&](const PolygonPick& entry) {
+            const std::vector<Point2D>& vertices = polygons[entry.polygonIndex].vertices;
+            const Point2D& from = vertices[entry.elementIndex];
+            const Point2D& to = vertices[(entry.elementIndex + 1) % vertices.size()];
+            long long distance = squaredDistanceToSegment(point, from, to);
+            if (distance <= bestDistance) {
+                bestDistance = distance;
+                best = entry;
+            }
+        });
+        return best;
+    }
+};
+
+#endif // POLYGON_SPATIAL_INDEX_H
@@ -0,0 +1,247 @@
+/**
+ * @file polygon_triangulator.h
+ * @brief Triangulação de polígonos simples por ear clipping (O(n) triângulos para n vértices)
+ * @author Sistema de Preenchimento ET/AET
+ * @date 2025
+ */
+
+#ifndef POLYGON_TRIANGULATOR_H
+#define POLYGON_TRIANGULATOR_H
+
+#include "data_structures.h"
+#include "polygon_fill_algorithm.h"
+#include <algorithm>
+#include <vector>
+
+/**
+ * @class PolygonTriangulator
+ * @brief Divide um polígono simples (côncavo ou convexo) em n - 2 triângulos
+ *
+ * Os triângulos saem com área orientada positiva nas coordenadas de entrada,
+ * a mesma convenção de PolygonFillAlgorithm::generateTriangulation. Polígonos
+ * com auto-interseção não são simples: nesse caso triangulate() recorre às
+ * faixas da scanline, que tratam qualquer contorno pela regra par-ímpar.
+ */
+class PolygonTriangulator {
+private:
+    /**
+     * @brief Produto vetorial (b - a) x (c - a), em inteiros de 64 bits (sem erro de arredondamento)
+     */
+    static long long cross(const Point2D& a, const Point2D& b, const Point2D& c) {
+        return static_cast<long long>(b.coordinateX - a.coordinateX) * (c.coordinateY - a.coordinateY) -
+               static_cast<long long>(b.coordinateY - a.coordinateY) * (c.coordinateX - a.coordinateX);
+    }
+
+    static bool samePosition(const Point2D& a, const Point2D& b) {
+        return a.coordinateX == b.coordinateX && a.coordinateY == b.coordinateY;
+    }
+
+    /**
+     * @brief Verifica se p está dentro ou sobre a borda do triângulo (a, b, c) orientado positivamente
+     */
+    static bool isInsideTriangle(const Point2D& p, const Point2D& a, const Point2D& b, const Point2D& c) {
+        return cross(a, b, p) >= 0 && cross(b, c, p) >= 0 && cross(c, a, p) >= 0;
+    }
+
+    /**
+     * @brief Verifica se p está na caixa delimitadora do segmento [a, b]
+     */
+    static bool isWithinBounds(const Point2D& p, const Point2D& a, const Point2D& b) {
+        return p.coordinateX >= std::min(a.coordinateX, b.coordinateX) && p.coordinateX <= std::max(a.coordinateX, b.coordinateX) &&
+               p.coordinateY >= std::min(a.coordinateY, b.coordinateY) && p.coordinateY <= std::max(a.coordinateY, b.coordinateY);
+    }
+
+    /**
+     * @brief Testa se os segmentos [p1, p2] e [q1, q2] se cruzam ou se tocam
+     */
+    static bool segmentsIntersect(const Point2D& p1, const Point2D& p2, const Point2D& q1, const Point2D& q2) {
+        if (std::max(p1.coordinateX, p2.coordinateX) < std::min(q1.coordinateX, q2.coordinateX) ||
+            std::max(q1.coordinateX, q2.coordinateX) < std::min(p1.coordinateX, p2.coordinateX) ||
+            std::max(p1.coordinateY, p2.coordinateY) < std::min(q1.coordinateY, q2.coordinateY) ||
+            std::max(q1.coordinateY, q2.coordinateY) < std::min(p1.coordinateY, p2.coordinateY)) {
+            return false;
+        }
+
+        long long d1 = cross(q1, q2, p1);
+        long long d2 = cross(q1, q2, p2);
+        long long d3 = cross(p1, p2, q1);
+        long long d4 = cross(p1, p2, q2);
+
+        if (((d1 > 0 && d2 < 0) || (d1 < 0 && d2 > 0)) &&
+            ((d3 > 0 && d4 < 0) || (d3 < 0 && d4 > 0))) {
+            return true;
+        }
+
+        // Casos colineares: um extremo sobre o outro segmento
+        return (d1 == 0 && isWithinBounds(p1, q1, q2)) || (d2 == 0 && isWithinBounds(p2, q1, q2)) ||
+               (d3 == 0 && isWithinBounds(q1, p1, p2)) || (d4 == 0 && isWithinBounds(q2, p1, p2));
+    }
+
+    /**
+     * @brief Índices do contorno sem vértices repetidos em sequência (inclusive último == primeiro)
+     */
+    static std::vector<int> buildOutline(const std::vector<Point2D>& polygonVertices) {
+        std::vector<int> outline;
+        outline.reserve(polygonVertices.size());
+        for (size_t vertexIndex = 0; vertexIndex < polygonVertices.size(); ++vertexIndex) {
+            if (outline.empty() || !samePosition(polygonVertices[outline.back()], polygonVertices[vertexIndex])) {
+                outline.push_back(static_cast<int>(vertexIndex));
+            }
+        }
+        while (outline.size() > 1 && samePosition(polygonVertices[outline.back()], polygonVertices[outline.front()])) {
+            outline.pop_back();
+        }
+        return outline;
+    }
+
+    /**
+     * @brief Verifica se arestas não adjacentes do contorno se cruzam (O(n²) com rejeição por caixa)
+     */
+    static bool isSimple(const std::vector<Point2D>& polygonVertices, const std::vector<int>& outline) {
+        size_t count = outline.size();
+        for (size_t first = 0; first < count; ++first) {
+            const Point2D& a1 = polygonVertices[outline[first]];
+            const Point2D& a2 = polygonVertices[outline[(first + 1) % count]];
+            for (size_t second = first + 2; second < count; ++second) {
+                if (first == 0 && second == count - 1) {
+                    continue; // Arestas adjacentes pelo fechamento do contorno
+                }
+                const Point2D& b1 = polygonVertices[outline[second]];
+                const Point2D& b2 = polygonVertices[outline[(second + 1) % count]];
+                if (segmentsIntersect(a1, a2, b1, b2)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+public:
+    /**
+     * @brief Triangula um polígono simples por ear clipping
+     * @param polygonVertices Vértices do polígono, em qualquer orientação
+     * @param triangleIndices Saída: trios de índices em polygonVertices, com área orientada positiva
+     * @return false se o polígono for degenerado ou tiver auto-interseção
+     */
+    static bool triangulateIndices(const std::vector<Point2D>& polygonVertices, std::vector<int>& triangleIndices) {
+        triangleIndices.clear();
+
+        std::vector<int> outline = buildOutline(polygonVertices);
+        if (outline.size() < 3 || !isSimple(polygonVertices, outline)) {
+            return false;
+        }
+
+        long long doubledArea = 0;
+        for (size_t vertexIndex = 0; vertexIndex < outline.size(); ++vertexIndex) {
+            const Point2D& current = polygonVertices[outline[vertexIndex]];
+            const Point2D& next = polygonVertices[outline[(vertexIndex + 1) % outline.size()]];
+            doubledArea += static_cast<long long>(current.coordinateX) * next.coordinateY -
+                           static_cast<long long>(next.coordinateX) * current.coordinateY;
+        }
+        if (doubledArea == 0) {
+            return false;
+        }
+        if (doubledArea < 0) {
+            std::reverse(outline.begin(), outline.end());
+        }
+
+        // Lista circular duplamente ligada sobre as posições do contorno
+        int remaining = static_cast<int>(outline.size());
+        std::vector<int> previous(remaining);
+        std::vector<int> next(remaining);
+        for (int position = 0; position < remaining; ++position) {
+            previous[position] = (position + remaining - 1) % remaining;
+            next[position] = (position + 1) % remaining;
+        }
+
+        auto vertexAt = [&](int position) -> const Point2D& {
+            return polygonVertices[outline[position]];
+        };
+
+        auto isEar = [&](int position) {
+            const Point2D& a = vertexAt(previous[position]);
+            const Point2D& b = vertexAt(position);
+            const Point2D& c = vertexAt(next[position]);
+            if (cross(a, b, c) <= 0) {
+                return false;
+            }
+            // Só vértices não convexos podem estar dentro de uma orelha
+            for (int other = next[next[position]]; other != previous[position]; other = next[other]) {
+                const Point2D& p = vertexAt(other);
+                if (cross(vertexAt(previous[other]), p, vertexAt(next[other])) > 0) {
+                    continue;
+                }
+                if (samePosition(p, a) || samePosition(p, b) || samePosition(p, c)) {
+                    continue;
+                }
+                if (isInsideTriangle(p, a, b, c)) {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        triangleIndices.reserve(static_cast<size_t>(remaining - 2) * 3);
+
+        int current = 0;
+        int stepsWithoutEar = 0;
+        while (remaining > 3) {
+            int before = previous[current];
+            int after = next[current];
+
+            // Vértices colineares não contribuem com área: são descartados sem gerar triângulo
+            bool collinear = cross(vertexAt(before), vertexAt(current), vertexAt(after)) == 0;
+
+            if (collinear || isEar(current)) {
+                if (!collinear) {
+                    triangleIndices.push_back(outline[before]);
+                    triangleIndices.push_back(outline[current]);
+                    triangleIndices.push_back(outline[after]);
+                }
+                next[before] = after;
+                previous[after] = before;
+                remaining--;
+                stepsWithoutEar = 0;
+                current = before;
+            } else {
+                if (++stepsWithoutEar > remaining) {
+                    triangleIndices.clear();
+                    return false;
+                }
+                current = after;
+            }
+        }
+
+        if (cross(vertexAt(previous[current]), vertexAt(current), vertexAt(next[current])) > 0) {
+            triangleIndices.push_back(outline[previous[current]]);
+            triangleIndices.push_back(outline[current]);
+            triangleIndices.push_back(outline[next[current]]);
+        }
+        return !triangleIndices.empty();
+    }
+
+    /**
+     * @brief Triangula o polígono, recorrendo à scanline quando o ear clipping não se aplica
+     * @param polygonVertices Vértices do polígono
+     * @param maxHeight Altura máxima usada pelo fallback de scanline
+     * @return Vetor de triângulos, cada um com 3 Point2D e área orientada positiva
+     */
+    static std::vector<std::vector<Point2D>> triangulate(const std::vector<Point2D>& polygonVertices, int maxHeight) {
+        std::vector<int> triangleIndices;
+        if (!triangulateIndices(polygonVertices, triangleIndices)) {
+            PolygonFillAlgorithm scanlineFill;
+            return scanlineFill.generateTriangulation(polygonVertices, maxHeight);
+        }
+
+        std::vector<std::vector<Point2D>> triangles;
+        triangles.reserve(triangleIndices.size() / 3);
+        for (size_t index = 0; index + 2 < triangleIndices.size(); index += 3) {
+            triangles.push_back({ polygonVertices[triangleIndices[index]],
+                                  polygonVertices[triangleIndices[index + 1]],
+                                  polygonVertices[triangleIndices[index + 2]] });
+        }
+        return triangles;
+    }
+};
+
+#endif // POLYGON_TRIANGULATOR_H
@@ -0,0 +1,249 @@
+/**
+ * @file primitive_mesh_cache.h
+ * @brief Display lists das primitivas 3D (cubo, esfera, cilindro, pirâmide), tesseladas uma única vez por nível de detalhe
+ * @author Sistema de Computação Gráfica
+ * @date 2025
+ */
+
+#ifndef PRIMITIVE_MESH_CACHE_H
+#define PRIMITIVE_MESH_CACHE_H
+
+#include <GL/glut.h>
+#include <GL/gl.h>
+#include <GL/glu.h>
+#include <algorithm>
+#include <cmath>
+#include "data_structures.h"
+#include "render_counters.h"
+
+/**
+ * @class PrimitiveMeshCache
+ * @brief Compila cada ObjectType em uma display list por nível de detalhe no primeiro desenho e a reutiliza
+ *
+ * Esfera e cilindro têm LOD_LEVEL_COUNT tesselações, da mais fina para a mais
+ * grossa; cubo e pirâmide são exatos com poucas faces e usam sempre o nível 0.
+ *
+ * As listas guardam só geometria e normais: material, luz, modelo de
+ * sombreamento e programa de shader continuam vindo do estado corrente, então
+ * o mesmo cache serve aos três modelos de iluminação. Exige contexto OpenGL
+ * ativo em draw() e no destrutor.
+ */
+class PrimitiveMeshCache {
+private:
+    static const int PRIMITIVE_COUNT = 4;
+
+public:
+    static const int LOD_LEVEL_COUNT = 3;
+
+private:
+    // Fatias e pilhas por nível; o nível 0 é a tesselação original
+    static constexpr int SPHERE_SLICES[LOD_LEVEL_COUNT] = { 20, 12, 6 };
+    static constexpr int SPHERE_STACKS[LOD_LEVEL_COUNT] = { 20, 12, 6 };
+    static constexpr int CYLINDER_SLICES[LOD_LEVEL_COUNT] = { 20, 12, 6 };
+    static constexpr int CYLINDER_STACKS[LOD_LEVEL_COUNT] = { 5, 2, 1 };
+    static constexpr float SPHERE_RADIUS = 1.0f;
+    static constexpr float CYLINDER_RADIUS = 0.8f;
+    static constexpr float CYLINDER_HEIGHT = 2.0f;
+    static constexpr float CUBE_SIZE = 1.5f;
+    static constexpr float PYRAMID_SIZE = 1.5f;
+
+    GLuint displayLists[PRIMITIVE_COUNT][LOD_LEVEL_COUNT];
+    GLUquadric* quadric; // Criado uma vez, no primeiro cilindro
+
+    static void tessellateSphere(float radius, int slices, int stacks) {
+        glutSolidSphere(radius, slices, stacks);
+    }
+
+    void tessellateCylinder(float baseRadius, float topRadius, float height, int slices, int stacks) {
+        if (!quadric) {
+            quadric = gluNewQuadric();
+            gluQuadricDrawStyle(quadric, GLU_FILL);
+            gluQuadricNormals(quadric, GLU_SMOOTH);
+        }
+
+        glPushMatrix();
+        glTranslatef(0.0f, -height/2.0f, 0.0f); // Centraliza
+        glRotatef(-90.0f, 1.0f, 0.0f, 0.0f); // Rotaciona para ficar em pé
+        gluCylinder(quadric, baseRadius, topRadius, height, slices, stacks);
+
+        // Tampas do cilindro
+        gluDisk(quadric, 0.0f, baseRadius, slices, 1);
+        glTranslatef(0.0f, 0.0f, height);
+        gluDisk(quadric, 0.0f, topRadius, slices, 1);
+
+        glPopMatrix();
+    }
+
+    static void tessellatePyramid(float size) {
+        float halfSize = size / 2.0f;
+
+        glBegin(GL_TRIANGLES);
+            // Frente
+            glNormal3f(0.0f, 0.5f, 1.0f);
+            glVertex3f(0.0f, halfSize, 0.0f);
+            glVertex3f(-halfSize, -halfSize, halfSize);
+            glVertex3f(halfSize, -halfSize, halfSize);
+
+            // Direita
+            glNormal3f(1.0f, 0.5f, 0.0f);
+            glVertex3f(0.0f, halfSize, 0.0f);
+            glVertex3f(halfSize, -halfSize, halfSize);
+            glVertex3f(halfSize, -halfSize, -halfSize);
+
+            // Trás
+            glNormal3f(0.0f, 0.5f, -1.0f);
+            glVertex3f(0.0f, halfSize, 0.0f);
+            glVertex3f(halfSize, -halfSize, -halfSize);
+            glVertex3f(-halfSize, -halfSize, -halfSize);
+
+            // Esquerda
+            glNormal3f(-1.0f, 0.5f, 0.0f);
+            glVertex3f(0.0f, halfSize, 0.0f);
+            glVertex3f(-halfSize, -halfSize, -halfSize);
+            glVertex3f(-halfSize, -halfSize, halfSize);
+        glEnd();
+
+        glBegin(GL_QUADS);
+            // Base
+            glNormal3f(0.0f, -1.0f, 0.0f);
+            glVertex3f(-halfSize, -halfSize, halfSize);
+            glVertex3f(halfSize, -halfSize, halfSize);
+            glVertex3f(halfSize, -halfSize, -halfSize);
+            glVertex3f(-halfSize, -halfSize, -halfSize);
+        glEnd();
+    }
+
+    /**
+     * @brief Emite a geometria da primitiva (usado só durante a compilação da lista)
+     */
+    void tessellate(ObjectType type, int level) {
+        switch (type) {
+            case ObjectType::CUBE:
+                glutSolidCube(CUBE_SIZE);
+                break;
+            case ObjectType::SPHERE:
+                tessellateSphere(SPHERE_RADIUS, SPHERE_SLICES[level], SPHERE_STACKS[level]);
+                break;
+            case ObjectType::CYLINDER:
+                tessellateCylinder(CYLINDER_RADIUS, CYLINDER_RADIUS, CYLINDER_HEIGHT, CYLINDER_SLICES[level], CYLINDER_STACKS[level]);
+                break;
+            case ObjectType::PYRAMID:
+                tessellatePyramid(PYRAMID_SIZE);
+                break;
+        }
+    }
+
+    static bool hasLevels(ObjectType type) {
+        return type == ObjectType::SPHERE || type == ObjectType::CYLINDER;
+    }
+
+    /**
+     * @brief Maior distância entre a superfície real e a tesselada (flecha da corda), em unidades locais
+     */
+    static float geometricError(ObjectType type, int level) {
+        const float pi = 3.14159265f;
+        switch (type) {
+            case ObjectType::SPHERE:
+                return SPHERE_RADIUS * (1.0f - std::cos(pi / std::min(SPHERE_SLICES[level], SPHERE_STACKS[level])));
+            case ObjectType::CYLINDER:
+                return CYLINDER_RADIUS * (1.0f - std::cos(pi / CYLINDER_SLICES[level]));
+            default:
+                return 0.0f;
+        }
+    }
+
+public:
+    PrimitiveMeshCache() : quadric(nullptr) {
+        for (int index = 0; index < PRIMITIVE_COUNT; ++index) {
+            for (int level = 0; level < LOD_LEVEL_COUNT; ++level) {
+                displayLists[index][level] = 0;
+            }
+        }
+    }
+
+    ~PrimitiveMeshCache() {
+        release();
+    }
+
+    PrimitiveMeshCache(const PrimitiveMeshCache&) = delete;
+    PrimitiveMeshCache& operator=(const PrimitiveMeshCache&) = delete;
+
+    /**
+     * @brief Raio da esfera envolvente da primitiva, centrada na origem
+     */
+    static float getBoundingRadius(ObjectType type) {
+        switch (type) {
+            case ObjectType::SPHERE:
+                return SPHERE_RADIUS;
+            case ObjectType::CYLINDER:
+                return std::sqrt(CYLINDER_RADIUS * CYLINDER_RADIUS + CYLINDER_HEIGHT * CYLINDER_HEIGHT / 4.0f);
+            case ObjectType::CUBE:
+                return CUBE_SIZE * 0.8660254f; // Metade da diagonal
+            default:
+                return PYRAMID_SIZE * 0.8660254f;
+        }
+    }
+
+    /**
+     * @brief Nível mais grosso cujo desvio, projetado na tela, não passa de maxPixelError
+     * @param pixelsPerUnit Pixels por unidade de mundo na distância da primitiva
+     */
+    static int selectLevel(ObjectType type, float pixelsPerUnit, float maxPixelError) {
+        if (!hasLevels(type)) {
+            return 0;
+        }
+        int level = 0;
+        while (level + 1 < LOD_LEVEL_COUNT && geometricError(type, level + 1) * pixelsPerUnit <= maxPixelError) {
+            level++;
+        }
+        return level;
+    }
+
+    /**
+     * @brief Desenha a primitiva no nível pedido, compilando sua display list na primeira chamada
+     */
+    void draw(ObjectType type, int level = 0) {
+        int index = static_cast<int>(type);
+        if (index < 0 || index >= PRIMITIVE_COUNT) {
+            return;
+        }
+        if (!hasLevels(type) || level < 0 || level >= LOD_LEVEL_COUNT) {
+            level = 0;
+        }
+
+        GLuint& list = displayLists[index][level];
+        if (!list) {
+            GLuint compiled = glGenLists(1);
+            if (!compiled) {
+                tessellate(type, level); // Sem listas disponíveis: desenha direto
+                return;
+            }
+            glNewList(compiled, GL_COMPILE);
+            tessellate(type, level);
+            glEndList();
+            list = compiled;
+        }
+        glCallList(list);
+        RenderCounters::add(RenderCounter::DRAW_CALLS);
+    }
+
+    /**
+     * @brief Libera as display lists e a quádrica (recompiladas sob demanda)
+     */
+    void release() {
+        for (int index = 0; index < PRIMITIVE_COUNT; ++index) {
+            for (int level = 0; level < LOD_LEVEL_COUNT; ++level) {
+                if (displayLists[index][level]) {
+                    glDeleteLists(displayLists[index][level], 1);
+                    displayLists[index][level] = 0;
+                }
+            }
+        }
+        if (quadric) {
+            gluDeleteQuadric(quadric);
+            quadric = nullptr;
+        }
+    }
+};
+
+#endif // PRIMITIVE_MESH_CACHE_H
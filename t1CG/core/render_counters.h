@@ -0,0 +1,63 @@
+/**
+ * @file render_counters.h
+ * @brief Contadores de trabalho de renderização por quadro (draw calls, glBegin, triângulos, arestas)
+ * @author Sistema de Computação Gráfica
+ * @date 2025
+ */
+
+#ifndef RENDER_COUNTERS_H
+#define RENDER_COUNTERS_H
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief O que cada contador mede
+ */
+enum class RenderCounter {
+    DRAW_CALLS = 0,       // glDrawArrays/glDrawElements/glCallList
+    IMMEDIATE_BLOCKS,     // Pares glBegin/glEnd
+    TRIANGLES,            // Triângulos enviados (quads contam como 2; display lists não entram)
+    SCANLINE_EDGES,       // Arestas inseridas na ET (buildSparseEdgeTable)
+    COUNT
+};
+
+/**
+ * @class RenderCounters
+ * @brief Contadores globais incrementados por quem desenha, lidos e zerados uma vez por quadro
+ *
+ * Não depende de GL nem do profiler: o algoritmo de preenchimento (que roda
+ * também nas threads de faixa e no benchmark) só soma a um atômico relaxado.
+ * FrameProfiler::endFrame() usa take() para fechar o quadro.
+ */
+class RenderCounters {
+private:
+    static std::atomic<uint64_t>* slots() {
+        static std::atomic<uint64_t> values[static_cast<int>(RenderCounter::COUNT)] = {};
+        return values;
+    }
+
+public:
+    static void add(RenderCounter counter, uint64_t amount = 1) {
+        slots()[static_cast<int>(counter)].fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Valor acumulado desde o último take(), zerando o contador
+     */
+    static uint64_t take(RenderCounter counter) {
+        return slots()[static_cast<int>(counter)].exchange(0, std::memory_order_relaxed);
+    }
+
+    static const char* getName(RenderCounter counter) {
+        switch (counter) {
+            case RenderCounter::DRAW_CALLS: return "draw calls";
+            case RenderCounter::IMMEDIATE_BLOCKS: return "blocos glBegin";
+            case RenderCounter::TRIANGLES: return "triangulos";
+            case RenderCounter::SCANLINE_EDGES: return "arestas ET/AET";
+            default: return "?";
+        }
+    }
+};
+
+#endif // RENDER_COUNTERS_H
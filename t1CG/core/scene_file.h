@@ -0,0 +1,500 @@
+/**
+ * @file scene_file.h
+ * @brief Arquivo binário de cena (polígonos salvos e extrusões prontas), carregado por mapeamento em memória
+ * @author Sistema de Computação Gráfica
+ * @date 2025
+ */
+
+#ifndef SCENE_FILE_H
+#define SCENE_FILE_H
+
+#include "data_structures.h"
+#include "polygon_manager.h"
+#include "object_3d.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*
+ * Layout (little-endian, todos os arrays alinhados em 8 bytes):
+ *
+ *   SceneFileHeader
+ *   SceneFilePolygonRecord[polygonCount]   em polygonTableOffset
+ *   SceneFileMeshRecord[meshCount]         em meshTableOffset
+ *   arrays referenciados pelos registros (SceneFileArray = offset + número de elementos)
+ *
+ * Cada extrusão é um registro de malha com geometricError 0 seguido dos registros
+ * dos seus níveis de detalhe (geometricError > 0, do mais fino ao mais grosso).
+ *
+ * Os arrays têm exatamente o formato da memória: vértices 2D como pares int32,
+ * geometria do Object3D em SoA e as variantes da malha prontas para glBufferData.
+ * Carregar é validar os limites e copiar/enviar blocos, sem interpretar elemento
+ * por elemento.
+ */
+
+struct SceneFileArray {
+    uint64_t offset;
+    uint64_t count; // Elementos, não bytes
+};
+
+struct SceneFileHeader {
+    char magic[4];               // "CGSC"
+    uint32_t version;
+    uint32_t polygonCount;
+    uint32_t meshCount;
+    uint64_t polygonTableOffset;
+    uint64_t meshTableOffset;
+    uint64_t fileSize;
+};
+
+struct SceneFilePolygonRecord {
+    SceneFileArray vertices;     // int32 x, y intercalados
+    float lineColor[3];
+    float fillColor[3];
+    float lineThickness;
+    int32_t selectedColorIndex;
+    uint32_t flags;              // SceneFile::FLAG_*
+    uint32_t reserved;
+};
+
+struct SceneFileMeshRecord {
+    uint32_t polygonIndex;       // Índice na tabela de polígonos
+    float depth;
+    uint64_t contentHash;        // SceneManager::hashExtrusion(vértices, depth) na gravação
+    float color[3];
+    float geometricError;        // 0 na malha completa; > 0 em um nível de detalhe da malha anterior
+    SceneFileArray positions;    // X[n], Y[n], Z[n]
+    SceneFileArray normals;      // Idem
+    SceneFileArray faceIndices;
+    SceneFileArray faceOffsets;  // Faces + 1
+    SceneFileArray faceNormals;  // X[f], Y[f], Z[f]
+    SceneFileArray interleaved[2]; // Por MeshVariant
+    SceneFileArray indices[2];
+};
+
+static_assert(sizeof(SceneFileHeader) == 40, "layout do cabeçalho da cena mudou");
+static_assert(sizeof(SceneFilePolygonRecord) == 56, "layout do registro de polígono mudou");
+static_assert(sizeof(SceneFileMeshRecord) == 176, "layout do registro de malha mudou");
+static_assert(sizeof(Point2D) == 2 * sizeof(int32_t) && std::is_trivially_copyable<Point2D>::value,
+              "Point2D precisa ter o layout de dois int32");
+
+/**
+ * @class MappedFile
+ * @brief Arquivo somente leitura mapeado em memória (CreateFileMapping no Windows, mmap nos demais)
+ */
+class MappedFile {
+private:
+    const unsigned char* bytes;
+    size_t length;
+#ifdef _WIN32
+    HANDLE fileHandle;
+    HANDLE mappingHandle;
+#else
+    int descriptor;
+#endif
+
+public:
+#ifdef _WIN32
+    MappedFile() : bytes(nullptr), length(0), fileHandle(INVALID_HANDLE_VALUE), mappingHandle(NULL) {}
+#else
+    MappedFile() : bytes(nullptr), length(0), descriptor(-1) {}
+#endif
+
+    ~MappedFile() {
+        close();
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @return false se o arquivo não existir, estiver vazio ou não puder ser mapeado
+     */
+    bool open(const char* path) {
+        close();
+#ifdef _WIN32
+        fileHandle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                                 FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+        if (fileHandle == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0) {
+            close();
+            return false;
+        }
+        mappingHandle = CreateFileMappingA(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (!mappingHandle) {
+            close();
+            return false;
+        }
+        bytes = static_cast<const unsigned char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+        length = static_cast<size_t>(fileSize.QuadPart);
+#else
+        descriptor = ::open(path, O_RDONLY);
+        if (descriptor < 0) {
+            return false;
+        }
+        struct stat status;
+        if (fstat(descriptor, &status) != 0 || status.st_size == 0) {
+            close();
+            return false;
+        }
+        void* mapping = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+        bytes = mapping == MAP_FAILED ? nullptr : static_cast<const unsigned char*>(mapping);
+        length = static_cast<size_t>(status.st_size);
+#endif
+        if (!bytes) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    void close() {
+#ifdef _WIN32
+        if (bytes) UnmapViewOfFile(bytes);
+        if (mappingHandle) CloseHandle(mappingHandle);
+        if (fileHandle != INVALID_HANDLE_VALUE) CloseHandle(fileHandle);
+        mappingHandle = NULL;
+        fileHandle = INVALID_HANDLE_VALUE;
+#else
+        if (bytes) munmap(const_cast<unsigned char*>(bytes), length);
+        if (descriptor >= 0) ::close(descriptor);
+        descriptor = -1;
+#endif
+        bytes = nullptr;
+        length = 0;
+    }
+
+    const unsigned char* data() const { return bytes; }
+    size_t size() const { return length; }
+};
+
+/**
+ * @brief Extrusão a gravar junto com um polígono salvo
+ */
+struct SceneFileMesh {
+    uint32_t polygonIndex;
+    float depth;
+    uint64_t contentHash;
+    Object3D* object; // Sem posse; só precisa existir durante SceneFile::save
+};
+
+/**
+ * @class SceneFile
+ * @brief Gravação do arquivo de cena
+ */
+class SceneFile {
+public:
+    static constexpr uint32_t VERSION = 2;
+    static constexpr uint32_t FLAG_FILLED = 1u << 0;
+    static constexpr uint32_t FLAG_SHOW_VERTICES = 1u << 1;
+
+    static bool hostIsLittleEndian() {
+        const uint16_t probe = 1;
+        unsigned char firstByte;
+        std::memcpy(&firstByte, &probe, 1);
+        return firstByte == 1;
+    }
+
+    /**
+     * @brief Grava os polígonos e as extrusões (com seus níveis de detalhe) em um único arquivo
+     * @return false se o arquivo não puder ser escrito (ou a máquina não for little-endian)
+     */
+    static bool save(const char* path,
+                     const std::vector<PolygonManager::SavedPolygon>& polygons,
+                     const std::vector<SceneFileMesh>& meshes) {
+        if (!hostIsLittleEndian()) {
+            return false;
+        }
+
+        // Cabeçalho e tabelas primeiro; os arrays vão sendo anexados e os registros apontam para eles
+        size_t meshRecordCount = 0;
+        for (const SceneFileMesh& mesh : meshes) {
+            meshRecordCount += mesh.object->getLodLevelCount();
+        }
+        std::vector<unsigned char> blob(sizeof(SceneFileHeader));
+        const uint64_t polygonTableOffset = reserve(blob, polygons.size() * sizeof(SceneFilePolygonRecord));
+        const uint64_t meshTableOffset = reserve(blob, meshRecordCount * sizeof(SceneFileMeshRecord));
+
+        for (size_t i = 0; i < polygons.size(); i++) {
+            const PolygonManager::SavedPolygon& polygon = polygons[i];
+            const PolygonConfiguration& configuration = polygon.configuration;
+            SceneFilePolygonRecord record = {};
+            record.vertices = append(blob, polygon.vertices.data(), polygon.vertices.size());
+            setColor(record.lineColor, configuration.lineColor);
+            setColor(record.fillColor, configuration.fillColor);
+            record.lineThickness = configuration.lineThickness;
+            record.selectedColorIndex = configuration.selectedColorIndex;
+            record.flags = (polygon.isFilled ? FLAG_FILLED : 0u) | (configuration.showVertices ? FLAG_SHOW_VERTICES : 0u);
+            std::memcpy(blob.data() + polygonTableOffset + i * sizeof(record), &record, sizeof(record));
+        }
+
+        size_t recordIndex = 0;
+        for (const SceneFileMesh& mesh : meshes) {
+            for (size_t level = 0; level < mesh.object->getLodLevelCount(); level++) {
+                SceneFileMeshRecord record = {};
+                record.polygonIndex = mesh.polygonIndex;
+                record.depth = mesh.depth;
+                record.contentHash = mesh.contentHash;
+                setColor(record.color, mesh.object->color);
+                record.geometricError = mesh.object->getLodError(level);
+                appendGeometry(blob, mesh.object->getLodMesh(level), record);
+                std::memcpy(blob.data() + meshTableOffset + recordIndex * sizeof(record), &record, sizeof(record));
+                recordIndex++;
+            }
+        }
+
+        SceneFileHeader header = {};
+        std::memcpy(header.magic, "CGSC", 4);
+        header.version = VERSION;
+        header.polygonCount = static_cast<uint32_t>(polygons.size());
+        header.meshCount = static_cast<uint32_t>(meshRecordCount);
+        header.polygonTableOffset = polygonTableOffset;
+        header.meshTableOffset = meshTableOffset;
+        header.fileSize = blob.size();
+        std::memcpy(blob.data(), &header, sizeof(header));
+
+        std::FILE* file = std::fopen(path, "wb");
+        if (!file) {
+            return false;
+        }
+        bool written = std::fwrite(blob.data(), 1, blob.size(), file) == blob.size();
+        return std::fclose(file) == 0 && written;
+    }
+
+private:
+    /**
+     * @brief Anexa a geometria de uma malha e aponta os arrays do registro para ela
+     */
+    static void appendGeometry(std::vector<unsigned char>& blob, Object3D& object, SceneFileMeshRecord& record) {
+        MeshGeometryView view = object.getGeometryView();
+        record.positions = appendComponents(blob, view.positions, view.vertexCount);
+        record.normals = appendComponents(blob, view.normals, view.vertexCount);
+        record.faceIndices = append(blob, view.faceIndices, view.faceIndexCount);
+        record.faceOffsets = append(blob, view.faceOffsets, view.faceCount + 1);
+        record.faceNormals = appendComponents(blob, view.faceNormals, view.faceCount);
+        for (int variant = 0; variant < 2; variant++) {
+            record.interleaved[variant] = append(blob, view.interleaved[variant], view.interleavedCount[variant]);
+            record.indices[variant] = append(blob, view.indices[variant], view.indexCount[variant]);
+        }
+    }
+
+    static uint64_t reserve(std::vector<unsigned char>& blob, size_t bytes) {
+        size_t offset = (blob.size() + 7) & ~static_cast<size_t>(7);
+        blob.resize(offset + bytes);
+        return offset;
+    }
+
+    template <typename T>
+    static SceneFileArray append(std::vector<unsigned char>& blob, const T* values, size_t count) {
+        SceneFileArray array;
+        array.offset = reserve(blob, count * sizeof(T));
+        array.count = count;
+        if (count > 0) {
+            std::memcpy(blob.data() + array.offset, values, count * sizeof(T));
+        }
+        return array;
+    }
+
+    /**
+     * @brief Três componentes SoA de count floats em sequência, como um único array de 3·count
+     */
+    static SceneFileArray appendComponents(std::vector<unsigned char>& blob, const float* const components[3], size_t count) {
+        SceneFileArray array;
+        array.offset = reserve(blob, 3 * count * sizeof(float));
+        array.count = 3 * count;
+        for (int axis = 0; axis < 3; axis++) {
+            if (count > 0) {
+                std::memcpy(blob.data() + array.offset + axis * count * sizeof(float), components[axis], count * sizeof(float));
+            }
+        }
+        return array;
+    }
+
+    static void setColor(float target[3], const ColorRGB& color) {
+        target[0] = color.redComponent;
+        target[1] = color.greenComponent;
+        target[2] = color.blueComponent;
+    }
+};
+
+/**
+ * @brief Dados de uma extrusão lida do arquivo (a geometria vem em uma MeshGeometryView)
+ */
+struct SceneFileMeshInfo {
+    uint32_t polygonIndex;
+    float depth;
+    uint64_t contentHash;
+    ColorRGB color;
+    float geometricError; // 0 na malha completa; > 0 em um nível de detalhe da malha completa anterior
+};
+
+/**
+ * @class SceneFileReader
+ * @brief Leitura do arquivo de cena direto do mapeamento
+ *
+ * As views devolvidas por readMesh apontam para o arquivo mapeado e valem
+ * enquanto o leitor estiver aberto.
+ */
+class SceneFileReader {
+private:
+    MappedFile file;
+    SceneFileHeader header;
+
+    /**
+     * @brief Ponteiro para um array do arquivo, ou nullptr se estiver fora dos limites ou desalinhado
+     */
+    template <typename T>
+    const T* array(const SceneFileArray& range, uint64_t expectedCount) const {
+        if (range.count != expectedCount || range.offset % alignof(T) != 0 || range.offset > file.size() ||
+            range.count > (file.size() - range.offset) / sizeof(T)) {
+            return nullptr;
+        }
+        return reinterpret_cast<const T*>(file.data() + range.offset);
+    }
+
+    template <typename Index>
+    static bool indicesBelow(const Index* values, size_t count, uint64_t limit) {
+        for (size_t i = 0; i < count; i++) {
+            if (static_cast<uint64_t>(values[i]) >= limit) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    const SceneFilePolygonRecord& polygonRecord(size_t index) const {
+        return reinterpret_cast<const SceneFilePolygonRecord*>(file.data() + header.polygonTableOffset)[index];
+    }
+
+    const SceneFileMeshRecord& meshRecord(size_t index) const {
+        return reinterpret_cast<const SceneFileMeshRecord*>(file.data() + header.meshTableOffset)[index];
+    }
+
+public:
+    SceneFileReader() : header() {}
+
+    /**
+     * @brief Mapeia o arquivo e valida o cabeçalho e as tabelas
+     * @return false se o arquivo não existir ou não for uma cena desta versão
+     */
+    bool open(const char* path) {
+        header = SceneFileHeader();
+        if (!SceneFile::hostIsLittleEndian() || !file.open(path) || file.size() < sizeof(SceneFileHeader)) {
+            file.close();
+            return false;
+        }
+        std::memcpy(&header, file.data(), sizeof(header));
+
+        SceneFileArray polygonTable = { header.polygonTableOffset, header.polygonCount };
+        SceneFileArray meshTable = { header.meshTableOffset, header.meshCount };
+        bool valid = std::memcmp(header.magic, "CGSC", 4) == 0 && header.version == SceneFile::VERSION &&
+                     header.fileSize == file.size() &&
+                     array<SceneFilePolygonRecord>(polygonTable, header.polygonCount) &&
+                     array<SceneFileMeshRecord>(meshTable, header.meshCount);
+        if (!valid) {
+            file.close();
+            header = SceneFileHeader();
+        }
+        return valid;
+    }
+
+    size_t getPolygonCount() const { return header.polygonCount; }
+    size_t getMeshCount() const { return header.meshCount; }
+
+    /**
+     * @brief Lê um polígono salvo (vértices copiados em bloco)
+     * @return false se o registro apontar para fora do arquivo
+     */
+    bool readPolygon(size_t index, std::vector<PolygonManager::SavedPolygon>& output) const {
+        const SceneFilePolygonRecord& record = polygonRecord(index);
+        const Point2D* vertices = array<Point2D>(record.vertices, record.vertices.count);
+        if (!vertices) {
+            return false;
+        }
+
+        PolygonConfiguration configuration;
+        configuration.lineColor = ColorRGB(record.lineColor[0], record.lineColor[1], record.lineColor[2]);
+        configuration.fillColor = ColorRGB(record.fillColor[0], record.fillColor[1], record.fillColor[2]);
+        configuration.lineThickness = record.lineThickness;
+        configuration.selectedColorIndex = record.selectedColorIndex;
+        configuration.showVertices = (record.flags & SceneFile::FLAG_SHOW_VERTICES) != 0;
+
+        output.push_back(PolygonManager::SavedPolygon(std::vector<Point2D>(), configuration,
+                                                      (record.flags & SceneFile::FLAG_FILLED) != 0));
+        output.back().vertices.resize(static_cast<size_t>(record.vertices.count));
+        std::memcpy(output.back().vertices.data(), vertices, static_cast<size_t>(record.vertices.count) * sizeof(Point2D));
+        return true;
+    }
+
+    /**
+     * @brief Aponta a view para a geometria de uma extrusão dentro do arquivo
+     * @return false se algum array estiver fora do arquivo ou com tamanho/índices inconsistentes
+     *
+     * Os índices são conferidos contra o número de vértices antes de chegarem à GPU.
+     */
+    bool readMesh(size_t index, SceneFileMeshInfo& info, MeshGeometryView& view) const {
+        const SceneFileMeshRecord& record = meshRecord(index);
+        info.polygonIndex = record.polygonIndex;
+        info.depth = record.depth;
+        info.contentHash = record.contentHash;
+        info.color = ColorRGB(record.color[0], record.color[1], record.color[2]);
+        info.geometricError = record.geometricError;
+
+        if (record.positions.count % 3 != 0 || record.faceOffsets.count == 0) {
+            return false;
+        }
+        view.vertexCount = static_cast<size_t>(record.positions.count / 3);
+        view.faceCount = static_cast<size_t>(record.faceOffsets.count - 1);
+        view.faceIndexCount = static_cast<size_t>(record.faceIndices.count);
+
+        const float* positions = array<float>(record.positions, 3 * static_cast<uint64_t>(view.vertexCount));
+        const float* normals = array<float>(record.normals, 3 * static_cast<uint64_t>(view.vertexCount));
+        const float* faceNormals = array<float>(record.faceNormals, 3 * static_cast<uint64_t>(view.faceCount));
+        view.faceIndices = array<int>(record.faceIndices, view.faceIndexCount);
+        view.faceOffsets = array<int>(record.faceOffsets, view.faceCount + 1);
+        if (!positions || !normals || !faceNormals || !view.faceIndices || !view.faceOffsets) {
+            return false;
+        }
+        for (int axis = 0; axis < 3; axis++) {
+            view.positions[axis] = positions + axis * view.vertexCount;
+            view.normals[axis] = normals + axis * view.vertexCount;
+            view.faceNormals[axis] = faceNormals + axis * view.faceCount;
+        }
+
+        if (view.faceOffsets[0] != 0 || static_cast<size_t>(view.faceOffsets[view.faceCount]) != view.faceIndexCount ||
+            !indicesBelow(view.faceIndices, view.faceIndexCount, view.vertexCount)) {
+            return false;
+        }
+        for (size_t f = 0; f < view.faceCount; f++) {
+            if (view.faceOffsets[f] > view.faceOffsets[f + 1]) {
+                return false;
+            }
+        }
+
+        for (int variant = 0; variant < 2; variant++) {
+            view.interleavedCount[variant] = static_cast<size_t>(record.interleaved[variant].count);
+            view.indexCount[variant] = static_cast<size_t>(record.indices[variant].count);
+            view.interleaved[variant] = array<GLfloat>(record.interleaved[variant], view.interleavedCount[variant]);
+            view.indices[variant] = array<GLuint>(record.indices[variant], view.indexCount[variant]);
+            if (!view.interleaved[variant] || !view.indices[variant] || view.interleavedCount[variant] % 6 != 0 ||
+                !indicesBelow(view.indices[variant], view.indexCount[variant], view.interleavedCount[variant] / 6)) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+#endif // SCENE_FILE_H
@@ -8,12 +8,24 @@
 #ifndef SCENE_MANAGER_H
 #define SCENE_MANAGER_H
 
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <unordered_map>
 #include <vector>
 #include <GL/gl.h>
 #include <GL/glu.h>
 #include "object_3d.h"
 #include "shader_utils.h"
 #include "polygon_fill_algorithm.h"
+#include "polygon_triangulator.h"
+#include "polygon_simplifier.h"
+#include "mesh_build_pipeline.h"
+#include "primitive_mesh_cache.h"
+#include "instanced_mesh_batch.h"
+#include "frustum.h"
+#include "gl_state_cache.h"
+#include "shader_manager.h"
 
 enum class LightingModel {
     FLAT,
@@ -26,12 +38,59 @@ enum class ProjectionType {
     ORTHOGRAPHIC
 };
 
+/**
+ * @brief Extrusão pronta vinda de fora do pipeline (por exemplo, de um arquivo de cena)
+ */
+struct BakedExtrusion {
+    unsigned long sourceId;
+    uint64_t contentHash; // SceneManager::hashExtrusion dos vértices e da profundidade de origem
+    std::unique_ptr<Object3D> object;
+};
+
 class SceneManager {
+public:
+    // Fator de escala das extrusões (coords tela 0-800 -> coords 3D aprox -4 a 4)
+    static constexpr float EXTRUSION_SCALE = 0.01f;
+
+    // Tolerâncias de Douglas-Peucker (em pixels do editor) dos níveis de detalhe das extrusões
+    static constexpr int EXTRUSION_LOD_TIERS = 3;
+    static constexpr float EXTRUSION_LOD_TOLERANCES[EXTRUSION_LOD_TIERS] = { 2.0f, 6.0f, 18.0f };
+
+    // Desvio máximo, em pixels de tela, aceito ao trocar uma malha por um nível mais grosso
+    static constexpr float LOD_PIXEL_ERROR = 1.0f;
+
 private:
-    std::vector<Object3D*> objects;
+    std::vector<std::unique_ptr<Object3D>> objects;
+
+    // Cache de extrusões: id da fonte -> (hash do conteúdo, objeto em objects; sem posse)
+    struct CachedExtrusion {
+        uint64_t contentHash;
+        Object3D* object;
+    };
+    std::unordered_map<unsigned long, CachedExtrusion> extrusionCache;
+
+    // Extrusões em segundo plano: a cena atual continua sendo desenhada até a nova ficar pronta
+    struct PendingEntry {
+        unsigned long sourceId;
+        uint64_t contentHash;
+    };
+    struct PendingScene {
+        bool active;
+        unsigned long generation;
+        std::vector<PendingEntry> order;                       // Fontes na ordem de desenho
+        std::unordered_map<unsigned long, std::unique_ptr<Object3D>> built; // Objetos já entregues pelas threads
+        size_t missingCount;                                   // Extrusões ainda em andamento
+
+        PendingScene() : active(false), generation(0), missingCount(0) {}
+    };
+    MeshBuildPipeline meshPipeline;
+    PendingScene pendingScene;
+    unsigned long extrusionGeneration;
     LightingModel currentLightingModel;
+    MeshVariant currentMeshVariant; // Malha ligada para o modelo de iluminação atual
     ProjectionType currentProjection;
     ObjectType currentObjectType;
+    PrimitiveMeshCache primitiveCache;
     
     // Câmera
     Vector3D cameraPosition;
@@ -45,13 +104,38 @@ private:
     // Objeto 3D
     ColorRGB objectColor;
 
-    // Shader Phong
+    // Parâmetros de luz/material mudaram desde o último envio ao OpenGL
+    bool lightColorDirty;
+    bool lightPositionDirty; // Posição da luz ou câmera: GL_POSITION depende da modelview
+    bool materialDirty;
+
+    // Programas GLSL 3.3 por modelo de iluminação; sem eles, pipeline fixo + Phong legado
+    ShaderManager shaderManager;
+    unsigned long lightingRevision; // Muda a cada alteração de luz, material ou câmera
+
+    // Shader Phong (legado, GLSL 1.10 com gl_LightSource)
     GLuint phongProgram;
     bool shadersLoaded;
 
+    // Culling: projeção guardada em updateProjectionMatrix, planos extraídos a cada render
+    GLfloat projectionMatrix[16];
+    int viewportHeight; // Altura usada em updateProjectionMatrix, para converter a projeção em pixels
+    ViewFrustum viewFrustum;
+    size_t culledObjectCount; // Objetos descartados no último render
+
+    // Ladrilhamento: cada objeto extrudado repetido em uma grade, por instancing
+    static const int TILE_GRID_SIZE = 5;
+    InstancedProgram instancedPhong;
+    std::vector<std::unique_ptr<InstancedMeshBatch>> tileBatches;
+    bool tilingEnabled;
+    bool tileBatchesDirty; // objects ou a cor mudaram desde a montagem dos lotes
+
 public:
     SceneManager() 
-        : currentLightingModel(LightingModel::FLAT),
+        : meshPipeline(&SceneManager::buildExtrudedObject),
+          extrusionGeneration(0),
+          currentLightingModel(LightingModel::FLAT),
+          currentMeshVariant(MeshVariant::FLAT),
           currentProjection(ProjectionType::PERSPECTIVE),
           currentObjectType(ObjectType::CUBE),
           cameraPosition(0, 0, 5),
@@ -60,68 +144,169 @@ public:
           lightPosition(5, 5, 5),
           lightColor(1, 1, 1),
           objectColor(0.8f, 0.8f, 0.8f),
+          lightColorDirty(true),
+          lightPositionDirty(true),
+          materialDirty(true),
+          lightingRevision(1),
           phongProgram(0),
-          shadersLoaded(false) {}
+          shadersLoaded(false),
+          viewportHeight(1),
+          culledObjectCount(0),
+          tilingEnabled(false),
+          tileBatchesDirty(true) {
+        for (int i = 0; i < 16; i++) {
+            projectionMatrix[i] = (i % 5 == 0) ? 1.0f : 0.0f;
+        }
+    }
 
     ~SceneManager() {
-        for (auto obj : objects) {
-            delete obj;
-        }
+        cancelPendingExtrusions();
         objects.clear();
     }
 
     void init() {
         // Configurações iniciais OpenGL
-        glEnable(GL_DEPTH_TEST);
-        glEnable(GL_LIGHTING);
-        glEnable(GL_LIGHT0);
-        glEnable(GL_NORMALIZE); // Importante para normais corretas após escala
+        GLStateCache& glState = GLStateCache::getInstance();
+        glState.invalidate();
+        glState.enable(GL_DEPTH_TEST);
+        glState.enable(GL_LIGHTING);
+        glState.enable(GL_LIGHT0);
+        glState.enable(GL_NORMALIZE); // Importante para normais corretas após escala
 
         // Carregar Shaders se possível
         if (ShaderUtils::loadExtensions()) {
-            loadPhongShader();
+            if (!shaderManager.load()) {
+                std::cerr << "Aviso: GLSL 3.3 indisponivel. Usando pipeline fixo e Phong legado." << std::endl;
+                loadPhongShader();
+            }
+            loadInstancedPhongShader();
             shadersLoaded = true;
         } else {
             std::cerr << "Aviso: Nao foi possivel carregar extensoes OpenGL para Shaders." << std::endl;
         }
     }
 
-    void addObject(Object3D* obj) {
-        objects.push_back(obj);
+    void addObject(std::unique_ptr<Object3D> obj) {
+        objects.push_back(std::move(obj));
+        tileBatchesDirty = true;
     }
 
     void clearObjects() {
-        for (auto obj : objects) delete obj;
+        cancelPendingExtrusions();
+        tileBatches.clear();
         objects.clear();
+        extrusionCache.clear();
+        tileBatchesDirty = true;
     }
 
+    /**
+     * @brief Liga/desliga a repetição dos objetos extrudados em uma grade
+     */
+    void toggleTiling() {
+        tilingEnabled = !tilingEnabled;
+        tileBatchesDirty = true;
+    }
 
+    bool isTilingEnabled() const { return tilingEnabled; }
 
-    void createExtrudedObject(const std::vector<Point2D>& vertices2D, float depth) {
-        if (vertices2D.size() < 3) return;
+    /**
+     * @brief Quantidade de objetos fora do frustum no último render
+     */
+    size_t getCulledObjectCount() const { return culledObjectCount; }
 
-        Object3D* obj = new Object3D();
-        
-        // Fator de escala para caber na visualizacao (coords tela 0-800 -> coords 3D aprox -4 a 4)
-        float scale = 0.01f; 
-        
-        // --- 0. Calcular Centroide para Centralizar na Origem ---
-        float centerX = 0.0f;
-        float centerY = 0.0f;
-        int n = vertices2D.size();
-        
+
+
+    /**
+     * @brief Monta a malha extrudada de um polígono 2D (paredes + tampas, com normais)
+     * @param vertices2D Contorno em coordenadas de tela
+     * @param depth Profundidade da extrusão (em pixels)
+     * @return Novo objeto, com os níveis de detalhe já montados, ou nullptr com menos de 3 vértices
+     */
+    static std::unique_ptr<Object3D> buildExtrudedObject(const std::vector<Point2D>& vertices2D, float depth) {
+        if (vertices2D.size() < 3) return nullptr;
+
+        float centerX, centerY;
+        extrusionCenter(vertices2D, centerX, centerY);
+        auto obj = buildExtrudedMesh(vertices2D, depth, centerX, centerY);
+        buildLodLevels(*obj, vertices2D, depth);
+        return obj;
+    }
+
+private:
+    /**
+     * @brief Acrescenta a obj os níveis simplificados do contorno de origem
+     * @param obj Extrusão completa de vertices2D
+     *
+     * Cada nível aplica Douglas-Peucker com uma tolerância de EXTRUSION_LOD_TOLERANCES
+     * e só é mantido se cortar ao menos um quarto dos vértices e das faces do nível
+     * anterior. Níveis cujo contorno simplificado não é simples são descartados: as
+     * faixas da scanline dependem da altura, não dos vértices, e não sairiam mais
+     * leves. Os níveis usam o mesmo centro da malha completa, então ficam sobrepostos a ela.
+     */
+    static void buildLodLevels(Object3D& obj, const std::vector<Point2D>& vertices2D, float depth) {
+        float centerX, centerY;
+        extrusionCenter(vertices2D, centerX, centerY);
+
+        size_t previousVertexCount = vertices2D.size();
+        size_t previousFaceCount = obj.getFaceCount();
+        for (int tier = 0; tier < EXTRUSION_LOD_TIERS; tier++) {
+            float tolerance = EXTRUSION_LOD_TOLERANCES[tier];
+            std::vector<Point2D> simplified = PolygonSimplifier::simplifyClosed(vertices2D, tolerance);
+            if (simplified.size() < 3) {
+                break;
+            }
+            if (simplified.size() * 4 > previousVertexCount * 3) {
+                continue;
+            }
+            auto level = buildExtrudedMesh(simplified, depth, centerX, centerY, false);
+            if (!level || level->getFaceCount() * 4 > previousFaceCount * 3) {
+                continue;
+            }
+            previousVertexCount = simplified.size();
+            previousFaceCount = level->getFaceCount();
+            obj.addLodLevel(std::move(level), tolerance * EXTRUSION_SCALE);
+        }
+    }
+
+    /**
+     * @brief Centroide dos vértices do contorno (a extrusão fica centrada nele)
+     */
+    static void extrusionCenter(const std::vector<Point2D>& vertices2D, float& centerX, float& centerY) {
+        centerX = 0.0f;
+        centerY = 0.0f;
         for (const auto& p : vertices2D) {
             centerX += p.coordinateX;
             centerY += p.coordinateY;
         }
-        if (n > 0) {
-            centerX /= n;
-            centerY /= n;
+        if (!vertices2D.empty()) {
+            centerX /= vertices2D.size();
+            centerY /= vertices2D.size();
         }
+    }
+
+    /**
+     * @brief Paredes e tampas de um contorno, centradas em (centerX, centerY)
+     * @param scanlineCaps Se false, contornos que não são simples devolvem nullptr
+     *        em vez de recorrer às faixas da scanline nas tampas
+     */
+    static std::unique_ptr<Object3D> buildExtrudedMesh(const std::vector<Point2D>& vertices2D, float depth,
+                                                       float centerX, float centerY, bool scanlineCaps = true) {
+        // Ear clipping primeiro: sem ele, e sem faixas da scanline, não há malha
+        std::vector<int> capIndices;
+        bool simpleContour = PolygonTriangulator::triangulateIndices(vertices2D, capIndices);
+        if (!simpleContour && !scanlineCaps) {
+            return nullptr;
+        }
+
+        auto obj = std::make_unique<Object3D>();
+        
+        const float scale = EXTRUSION_SCALE;
+        int n = vertices2D.size();
 
         // --- 1. Gerar Paredes Laterais (Side Walls) ---
         // Usamos os vértices originais para garantir o contorno correto
-        int baseIndex = 0;
+        // Reserva: 2n vértices nas paredes e 2n nas tampas; n quads laterais e 2(n - 2) triângulos nas tampas
+        obj->reserve(4 * n, 3 * n, 4 * n + 6 * n);
         
         // Adicionar vértices para as paredes (frente e trás)
         for (const auto& p : vertices2D) {
@@ -138,51 +323,220 @@ public:
             int next = (i + 1) % n;
             // Quad: i (frente), next (frente), next+n (trás), i+n (trás)
             // Ordem para normal apontar para fora
-            std::vector<int> sideFace;
-            sideFace.push_back(i);
-            sideFace.push_back(next);
-            sideFace.push_back(next + n);
-            sideFace.push_back(i + n);
-            obj->addFace(sideFace);
+            obj->addQuad(i, next, next + n, i + n);
         }
         
-        // --- 2. Gerar Tampas (Caps) usando Triangulação (Scanline) ---
-        // Isso resolve problemas de polígonos côncavos e auto-interseção
-        PolygonFillAlgorithm algo;
-        // Usamos uma altura suficiente para cobrir a tela
-        std::vector<std::vector<Point2D>> triangles = algo.generateTriangulation(vertices2D, 2000); 
-        
-        // Tampa Frontal
-        for (const auto& tri : triangles) {
-            std::vector<int> faceIndices;
-            for (const auto& p : tri) {
-                // Centralizado
-                obj->addVertex((p.coordinateX - centerX) * scale, -(p.coordinateY - centerY) * scale, (depth * scale) / 2.0f);
-                faceIndices.push_back(obj->vertices.size() - 1);
+        // --- 2. Gerar Tampas (Caps) por Ear Clipping ---
+        // n - 2 triângulos por tampa, compartilhando vértices só dentro da tampa: cada
+        // tampa tem seu próprio anel (frente 2n + i, trás 3n + i), senão calculateNormals
+        // misturaria a normal da tampa com a das paredes e a tampa deixaria de ser plana.
+        // Os triângulos têm área positiva em coordenadas de tela (Y para baixo); como Y é
+        // invertido na conversão para 3D, a tampa frontal inverte a ordem para a normal apontar para +Z
+        if (simpleContour) {
+            const int frontCap = 2 * n;
+            const int backCap = 3 * n;
+            for (int i = 0; i < 2 * n; i++) {
+                Vector3D wallVertex = obj->getVertexPosition(i);
+                obj->addVertex(wallVertex.x, wallVertex.y, wallVertex.z);
             }
-            // A ordem da triangulação do scanline é geralmente consistente, mas precisamos verificar o winding.
-            // Scanline varre Y, depois X. 
-            // Vamos assumir CCW. Se ficar invertido, trocamos.
-            obj->addFace(faceIndices);
-        }
-        
-        // Tampa Traseira
-        for (const auto& tri : triangles) {
-            std::vector<int> faceIndices;
-            // Para a tampa traseira, precisamos inverter a ordem dos vértices para a normal apontar para trás
-            for (int i = 2; i >= 0; i--) {
-                const auto& p = tri[i];
-                // Centralizado
-                obj->addVertex((p.coordinateX - centerX) * scale, -(p.coordinateY - centerY) * scale, -(depth * scale) / 2.0f);
-                faceIndices.push_back(obj->vertices.size() - 1);
+            for (size_t t = 0; t + 2 < capIndices.size(); t += 3) {
+                // Tampa Frontal
+                obj->addTriangle(capIndices[t + 2] + frontCap, capIndices[t + 1] + frontCap, capIndices[t] + frontCap);
+                // Tampa Traseira
+                obj->addTriangle(capIndices[t] + backCap, capIndices[t + 1] + backCap, capIndices[t + 2] + backCap);
+            }
+        } else {
+            // Auto-interseção: faixas da scanline, com os cantos soldados por posição
+            // dentro de cada tampa (não às paredes, pelo mesmo motivo acima)
+            PolygonFillAlgorithm algo;
+            // Usamos uma altura suficiente para cobrir a tela
+            std::vector<std::vector<Point2D>> triangles = algo.generateTriangulation(vertices2D, 2000);
+            
+            VertexWelder frontWelder(*obj);
+            VertexWelder backWelder(*obj);
+            
+            for (const auto& tri : triangles) {
+                int frontFace[3];
+                int backFace[3];
+                for (int i = 0; i < 3; i++) {
+                    const auto& p = tri[i];
+                    // Centralizado
+                    frontFace[2 - i] = frontWelder.addVertex((p.coordinateX - centerX) * scale, -(p.coordinateY - centerY) * scale, (depth * scale) / 2.0f);
+                    backFace[i] = backWelder.addVertex((p.coordinateX - centerX) * scale, -(p.coordinateY - centerY) * scale, -(depth * scale) / 2.0f);
+                }
+                // Faixas de largura zero viram triângulos degenerados após a solda
+                if (frontFace[0] == frontFace[1] || frontFace[1] == frontFace[2] || frontFace[0] == frontFace[2]) {
+                    continue;
+                }
+                obj->addFace(frontFace, 3);
+                obj->addFace(backFace, 3);
             }
-            obj->addFace(faceIndices);
         }
         
         obj->calculateNormals();
         obj->color = ColorRGB(0.7f, 0.7f, 0.7f); // Cor cinza padrao
         
-        addObject(obj);
+        return obj;
+    }
+
+public:
+    void createExtrudedObject(const std::vector<Point2D>& vertices2D, float depth) {
+        auto obj = buildExtrudedObject(vertices2D, depth);
+        if (obj) {
+            addObject(std::move(obj));
+        }
+    }
+
+    /**
+     * @brief Hash do conteúdo de uma extrusão (FNV-1a sobre os vértices e a profundidade)
+     */
+    static uint64_t hashExtrusion(const std::vector<Point2D>& vertices2D, float depth) {
+        uint64_t hash = 14695981039346656037ull;
+        auto mix = [&hash](uint32_t value) {
+            for (int byte = 0; byte < 4; byte++) {
+                hash ^= (value >> (byte * 8)) & 0xFFu;
+                hash *= 1099511628211ull;
+            }
+        };
+        for (const auto& p : vertices2D) {
+            mix(static_cast<uint32_t>(p.coordinateX));
+            mix(static_cast<uint32_t>(p.coordinateY));
+        }
+        uint32_t depthBits;
+        std::memcpy(&depthBits, &depth, sizeof(depthBits));
+        mix(depthBits);
+        return hash;
+    }
+
+    /**
+     * @brief Sincroniza os objetos da cena com as fontes 2D, extrudando só o que mudou
+     * @param sources Polígonos a extrudar, na ordem de desenho
+     *
+     * Fontes com mesmo id e mesmo hash de conteúdo reaproveitam o Object3D (e seus
+     * buffers na GPU) da última sincronização; as demais são reconstruídas, e objetos
+     * sem fonte correspondente são liberados. Roda na thread atual; veja
+     * requestExtrudedObjects() para a versão em segundo plano.
+     */
+    void syncExtrudedObjects(const std::vector<ExtrusionSource>& sources) {
+        cancelPendingExtrusions();
+
+        std::vector<PendingEntry> order;
+        std::unordered_map<unsigned long, std::unique_ptr<Object3D>> built;
+        for (const auto& source : sources) {
+            if (source.vertices.size() < 3) {
+                continue;
+            }
+            uint64_t contentHash = hashExtrusion(source.vertices, source.depth);
+            order.push_back(PendingEntry{ source.sourceId, contentHash });
+            if (!isExtrusionCached(source.sourceId, contentHash) && !built.count(source.sourceId)) {
+                built[source.sourceId] = buildExtrudedObject(source.vertices, source.depth);
+            }
+        }
+
+        commitScene(order, built);
+    }
+
+    /**
+     * @brief Troca a cena pelas extrusões informadas e as registra no cache
+     * @param baked Objetos prontos, na ordem de desenho (a posse passa para a cena)
+     *
+     * Um syncExtrudedObjects/requestExtrudedObjects seguinte com os mesmos ids e
+     * conteúdo reaproveita esses objetos sem extrudar de novo.
+     */
+    void adoptExtrudedObjects(std::vector<BakedExtrusion>& baked) {
+        cancelPendingExtrusions();
+
+        std::vector<PendingEntry> order;
+        std::unordered_map<unsigned long, std::unique_ptr<Object3D>> built;
+        for (auto& entry : baked) {
+            if (!entry.object || built.count(entry.sourceId)) {
+                continue;
+            }
+            order.push_back(PendingEntry{ entry.sourceId, entry.contentHash });
+            built[entry.sourceId] = std::move(entry.object);
+        }
+        baked.clear();
+
+        commitScene(order, built);
+    }
+
+    /**
+     * @brief Objeto da cena atual para uma fonte, se o conteúdo ainda for o mesmo
+     * @return Objeto (a posse continua com a cena) ou nullptr
+     */
+    Object3D* findCachedExtrusion(unsigned long sourceId, uint64_t contentHash) const {
+        auto cached = extrusionCache.find(sourceId);
+        if (cached == extrusionCache.end() || cached->second.contentHash != contentHash) {
+            return nullptr;
+        }
+        return cached->second.object;
+    }
+
+    /**
+     * @brief Pede a sincronização em segundo plano (não bloqueia)
+     * @param sources Polígonos a extrudar, na ordem de desenho (copiados como snapshot)
+     *
+     * Só as fontes novas ou editadas vão para as threads de trabalho. A troca da
+     * cena acontece em pollExtrusionResults(), quando todas ficarem prontas; um
+     * novo pedido antes disso descarta o anterior.
+     */
+    void requestExtrudedObjects(const std::vector<ExtrusionSource>& sources) {
+        cancelPendingExtrusions();
+
+        pendingScene.generation = ++extrusionGeneration;
+        for (const auto& source : sources) {
+            if (source.vertices.size() < 3) {
+                continue;
+            }
+            uint64_t contentHash = hashExtrusion(source.vertices, source.depth);
+            bool alreadyRequested = false;
+            for (const auto& entry : pendingScene.order) {
+                if (entry.sourceId == source.sourceId) {
+                    alreadyRequested = true;
+                    break;
+                }
+            }
+            pendingScene.order.push_back(PendingEntry{ source.sourceId, contentHash });
+            if (!alreadyRequested && !isExtrusionCached(source.sourceId, contentHash)) {
+                meshPipeline.submit(pendingScene.generation, source, contentHash);
+                pendingScene.missingCount++;
+            }
+        }
+        pendingScene.active = true;
+
+        if (pendingScene.missingCount == 0) {
+            finishPendingScene();
+        }
+    }
+
+    /**
+     * @brief Recolhe as malhas prontas e, se a cena pedida estiver completa, troca a cena
+     * @return true se a cena foi trocada (é preciso redesenhar)
+     *
+     * Deve ser chamada na thread do GLUT (o upload para a GPU acontece aqui).
+     */
+    bool pollExtrusionResults() {
+        for (auto& result : meshPipeline.takeCompleted()) {
+            if (pendingScene.active && result.generation == pendingScene.generation &&
+                !pendingScene.built.count(result.sourceId)) {
+                pendingScene.built[result.sourceId] = std::move(result.object);
+                pendingScene.missingCount--;
+            }
+            // Resultados de pedidos substituídos ou cancelados são liberados aqui
+        }
+
+        if (pendingScene.active && pendingScene.missingCount == 0) {
+            finishPendingScene();
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Indica se há uma troca de cena aguardando extrusões em segundo plano
+     */
+    bool hasPendingExtrusions() const {
+        return pendingScene.active;
     }
 
     void setLightingModel(LightingModel model) {
@@ -191,6 +545,7 @@ public:
             std::cerr << "Aviso: Phong nao suportado (shaders nao carregados). Usando Gouraud." << std::endl;
             currentLightingModel = LightingModel::GOURAUD;
         }
+        currentMeshVariant = (currentLightingModel == LightingModel::FLAT) ? MeshVariant::FLAT : MeshVariant::SMOOTH;
     }
 
     void setProjection(ProjectionType proj) {
@@ -218,16 +573,20 @@ public:
             else
                 glOrtho(-viewRange, viewRange, -viewRange / aspect, viewRange / aspect, 0.1f, 500.0f);
         }
+        glGetFloatv(GL_PROJECTION_MATRIX, projectionMatrix);
+        viewportHeight = h > 0 ? h : 1;
         glMatrixMode(GL_MODELVIEW);
     }
 
     void render() {
         // === GARANTIR ESTADO OPENGL CORRETO ===
         // Re-habilitar lighting que pode ter sido desabilitado durante renderização da UI
-        glEnable(GL_LIGHTING);
-        glEnable(GL_LIGHT0);
-        glEnable(GL_DEPTH_TEST);
-        glEnable(GL_NORMALIZE);
+        // (o cache só repassa ao driver o que de fato mudou)
+        GLStateCache& glState = GLStateCache::getInstance();
+        glState.enable(GL_LIGHTING);
+        glState.enable(GL_LIGHT0);
+        glState.enable(GL_DEPTH_TEST);
+        glState.enable(GL_NORMALIZE);
         
         // Configurar Câmera
         glLoadIdentity();
@@ -235,161 +594,299 @@ public:
                   cameraTarget.x, cameraTarget.y, cameraTarget.z,
                   cameraUp.x, cameraUp.y, cameraUp.z);
 
-        // Configurar Luz com lightColor dinâmica
-        GLfloat lightPos[] = { lightPosition.x, lightPosition.y, lightPosition.z, 1.0f };
-        GLfloat lightDiffuse[] = { lightColor.redComponent, lightColor.greenComponent, lightColor.blueComponent, 1.0f };
-        GLfloat lightAmbient[] = { lightColor.redComponent * 0.2f, lightColor.greenComponent * 0.2f, lightColor.blueComponent * 0.2f, 1.0f };
-        GLfloat lightSpecular[] = { lightColor.redComponent, lightColor.greenComponent, lightColor.blueComponent, 1.0f };
-        
-        glLightfv(GL_LIGHT0, GL_POSITION, lightPos);
-        glLightfv(GL_LIGHT0, GL_DIFFUSE, lightDiffuse);
-        glLightfv(GL_LIGHT0, GL_SPECULAR, lightSpecular);
-        glLightfv(GL_LIGHT0, GL_AMBIENT, lightAmbient);
-
-        // Configurar Material com objectColor dinâmica
-        GLfloat matAmbient[] = { objectColor.redComponent * 0.3f, objectColor.greenComponent * 0.3f, objectColor.blueComponent * 0.3f, 1.0f };
-        GLfloat matDiffuse[] = { objectColor.redComponent, objectColor.greenComponent, objectColor.blueComponent, 1.0f };
-        GLfloat matSpecular[] = { 1.0f, 1.0f, 1.0f, 1.0f };
-        GLfloat matShininess[] = { 50.0f };
-        
-        glMaterialfv(GL_FRONT, GL_AMBIENT, matAmbient);
-        glMaterialfv(GL_FRONT, GL_DIFFUSE, matDiffuse);
-        glMaterialfv(GL_FRONT, GL_SPECULAR, matSpecular);
-        glMaterialfv(GL_FRONT, GL_SHININESS, matShininess);
+        // Só a câmera na modelview: planos do frustum em coordenadas de mundo
+        GLfloat viewMatrix[16];
+        glGetFloatv(GL_MODELVIEW_MATRIX, viewMatrix);
+        viewFrustum.extract(projectionMatrix, viewMatrix);
+        culledObjectCount = 0;
+
+        // Luz e material só são reenviados quando um setter os marcou como sujos
+        flushLightAndMaterial();
 
         // Configurar Modelo de Iluminação (Persistência de Estado)
-        // Garanta que o glShadeModel seja aplicado a cada frame
         if (currentLightingModel == LightingModel::FLAT) {
-            glShadeModel(GL_FLAT);
+            glState.setShadeModel(GL_FLAT);
         } else {
-            glShadeModel(GL_SMOOTH); // Gouraud e Phong usam Smooth
+            glState.setShadeModel(GL_SMOOTH); // Gouraud e Phong usam Smooth
         }
 
-        if (currentLightingModel == LightingModel::PHONG) {
-            glUseProgram(phongProgram);
+        if (shaderManager.isAvailable()) {
+            ShaderManager::Variant variant = shaderVariantFor(currentLightingModel);
+            glState.useProgram(shaderManager.getProgram(variant));
+            shaderManager.applyUniforms(variant, buildLightingUniforms(viewMatrix), lightingRevision);
+        } else if (currentLightingModel == LightingModel::PHONG) {
+            glState.useProgram(phongProgram);
         } else {
-            glUseProgram(0); // Desativar shader
+            glState.useProgram(0); // Desativar shader
         }
 
         // Desenhar Objetos
-        bool useFlat = (currentLightingModel == LightingModel::FLAT);
         
         // Se tiver objetos na lista (do extrusor 2D), desenha eles
         // Caso contrário, desenha a primitiva selecionada
-        if (!objects.empty()) {
-             for (auto obj : objects) {
-                obj->draw(useFlat);
+        if (!objects.empty() && tilingEnabled) {
+            if (tileBatchesDirty) {
+                rebuildTileBatches();
             }
-        } else {
-            // Desenha primitiva baseada no tipo selecionado
-            switch (currentObjectType) {
-                case ObjectType::CUBE:
-                    glutSolidCube(1.5f);
-                    break;
-                case ObjectType::SPHERE:
-                    drawSphere(1.0f, 20, 20);
-                    break;
-                case ObjectType::CYLINDER:
-                    drawCylinder(0.8f, 0.8f, 2.0f, 20, 5);
-                    break;
-                case ObjectType::PYRAMID:
-                    drawPyramid(1.5f);
-                    break;
+            for (auto& batch : tileBatches) {
+                batch->draw(currentMeshVariant, instancedPhong);
             }
+        } else if (!objects.empty()) {
+             for (auto& obj : objects) {
+                Vector3D center;
+                float radius;
+                if (!obj->getWorldBoundingSphere(center, radius) ||
+                    !viewFrustum.intersectsSphere(center.x, center.y, center.z, radius)) {
+                    culledObjectCount++;
+                    continue;
+                }
+                size_t lodLevel = obj->selectLodLevel(pixelsPerUnitAt(center, radius), LOD_PIXEL_ERROR);
+                obj->draw(currentMeshVariant, lodLevel);
+            }
+        } else {
+            // Desenha primitiva baseada no tipo selecionado (display list compilada uma vez por nível)
+            float radius = PrimitiveMeshCache::getBoundingRadius(currentObjectType);
+            float pixelsPerUnit = pixelsPerUnitAt(Vector3D(0, 0, 0), radius);
+            primitiveCache.draw(currentObjectType,
+                                PrimitiveMeshCache::selectLevel(currentObjectType, pixelsPerUnit, LOD_PIXEL_ERROR));
         }
         
-        glUseProgram(0);
-    }
-
-    // Funções de desenho de primitivas
-    void drawSphere(float radius, int slices, int stacks) {
-        glutSolidSphere(radius, slices, stacks);
-    }
-
-    void drawCylinder(float baseRadius, float topRadius, float height, int slices, int stacks) {
-        GLUquadric* quad = gluNewQuadric();
-        gluQuadricDrawStyle(quad, GLU_FILL);
-        gluQuadricNormals(quad, GLU_SMOOTH);
-        
-        glPushMatrix();
-        glTranslatef(0.0f, -height/2.0f, 0.0f); // Centraliza
-        glRotatef(-90.0f, 1.0f, 0.0f, 0.0f); // Rotaciona para ficar em pé
-        gluCylinder(quad, baseRadius, topRadius, height, slices, stacks);
-        
-        // Tampas do cilindro
-        gluDisk(quad, 0.0f, baseRadius, slices, 1);
-        glTranslatef(0.0f, 0.0f, height);
-        gluDisk(quad, 0.0f, topRadius, slices, 1);
-        
-        glPopMatrix();
-        gluDeleteQuadric(quad);
-    }
-
-    void drawPyramid(float size) {
-        float halfSize = size / 2.0f;
-        
-        glBegin(GL_TRIANGLES);
-            // Frente
-            glNormal3f(0.0f, 0.5f, 1.0f);
-            glVertex3f(0.0f, halfSize, 0.0f);
-            glVertex3f(-halfSize, -halfSize, halfSize);
-            glVertex3f(halfSize, -halfSize, halfSize);
-            
-            // Direita
-            glNormal3f(1.0f, 0.5f, 0.0f);
-            glVertex3f(0.0f, halfSize, 0.0f);
-            glVertex3f(halfSize, -halfSize, halfSize);
-            glVertex3f(halfSize, -halfSize, -halfSize);
-            
-            // Trás
-            glNormal3f(0.0f, 0.5f, -1.0f);
-            glVertex3f(0.0f, halfSize, 0.0f);
-            glVertex3f(halfSize, -halfSize, -halfSize);
-            glVertex3f(-halfSize, -halfSize, -halfSize);
-            
-            // Esquerda
-            glNormal3f(-1.0f, 0.5f, 0.0f);
-            glVertex3f(0.0f, halfSize, 0.0f);
-            glVertex3f(-halfSize, -halfSize, -halfSize);
-            glVertex3f(-halfSize, -halfSize, halfSize);
-        glEnd();
-        
-        glBegin(GL_QUADS);
-            // Base
-            glNormal3f(0.0f, -1.0f, 0.0f);
-            glVertex3f(-halfSize, -halfSize, halfSize);
-            glVertex3f(halfSize, -halfSize, halfSize);
-            glVertex3f(halfSize, -halfSize, -halfSize);
-            glVertex3f(-halfSize, -halfSize, -halfSize);
-        glEnd();
+        glState.useProgram(0);
     }
 
     // Getters e Setters para Câmera e Luz...
-    void setCameraPosition(float x, float y, float z) { cameraPosition = Vector3D(x, y, z); }
+    void setCameraPosition(float x, float y, float z) {
+        if (x != cameraPosition.x || y != cameraPosition.y || z != cameraPosition.z) {
+            cameraPosition = Vector3D(x, y, z);
+            lightPositionDirty = true;
+            lightingRevision++;
+        }
+    }
     Vector3D getCameraPosition() const { return cameraPosition; }
     
-    void setLightPosition(float x, float y, float z) { lightPosition = Vector3D(x, y, z); }
+    void setLightPosition(float x, float y, float z) {
+        lightPosition = Vector3D(x, y, z);
+        lightPositionDirty = true;
+        lightingRevision++;
+    }
     Vector3D getLightPosition() const { return lightPosition; }
     
     // Métodos para customização de cores 3D
     void setObjectColor(float r, float g, float b) {
         objectColor = ColorRGB(r, g, b);
-        // Aplicar a todos os objetos via material properties
-        GLfloat mat_diffuse[] = {r, g, b, 1.0f};
-        GLfloat mat_ambient[] = {r * 0.2f, g * 0.2f, b * 0.2f, 1.0f};
-        glMaterialfv(GL_FRONT, GL_DIFFUSE, mat_diffuse);
-        glMaterialfv(GL_FRONT, GL_AMBIENT, mat_ambient);
+        tileBatchesDirty = true;
+        materialDirty = true; // Aplicado a todos os objetos no próximo render
+        lightingRevision++;
     }
     
     void setLightColor(float r, float g, float b) {
         lightColor = ColorRGB(r, g, b);
-        GLfloat diffuse[] = {r, g, b, 1.0f};
-        GLfloat ambient[] = {r * 0.2f, g * 0.2f, b * 0.2f, 1.0f};
-        glLightfv(GL_LIGHT0, GL_DIFFUSE, diffuse);
-        glLightfv(GL_LIGHT0, GL_AMBIENT, ambient);
+        lightColorDirty = true;
+        lightingRevision++;
     }
 
 private:
+    /**
+     * @brief Envia ao OpenGL só os parâmetros de luz e material marcados como sujos
+     *
+     * Precisa rodar com a modelview da câmera: GL_POSITION é guardada já
+     * transformada para coordenadas do olho.
+     */
+    void flushLightAndMaterial() {
+        if (lightPositionDirty) {
+            GLfloat lightPos[] = { lightPosition.x, lightPosition.y, lightPosition.z, 1.0f };
+            glLightfv(GL_LIGHT0, GL_POSITION, lightPos);
+            lightPositionDirty = false;
+        }
+
+        if (lightColorDirty) {
+            GLfloat lightDiffuse[] = { lightColor.redComponent, lightColor.greenComponent, lightColor.blueComponent, 1.0f };
+            GLfloat lightAmbient[] = { lightColor.redComponent * 0.2f, lightColor.greenComponent * 0.2f, lightColor.blueComponent * 0.2f, 1.0f };
+            GLfloat lightSpecular[] = { lightColor.redComponent, lightColor.greenComponent, lightColor.blueComponent, 1.0f };
+            glLightfv(GL_LIGHT0, GL_DIFFUSE, lightDiffuse);
+            glLightfv(GL_LIGHT0, GL_SPECULAR, lightSpecular);
+            glLightfv(GL_LIGHT0, GL_AMBIENT, lightAmbient);
+            lightColorDirty = false;
+        }
+
+        if (materialDirty) {
+            GLfloat matAmbient[] = { objectColor.redComponent * 0.3f, objectColor.greenComponent * 0.3f, objectColor.blueComponent * 0.3f, 1.0f };
+            GLfloat matDiffuse[] = { objectColor.redComponent, objectColor.greenComponent, objectColor.blueComponent, 1.0f };
+            GLfloat matSpecular[] = { 1.0f, 1.0f, 1.0f, 1.0f };
+            GLfloat matShininess[] = { 50.0f };
+            glMaterialfv(GL_FRONT, GL_AMBIENT, matAmbient);
+            glMaterialfv(GL_FRONT, GL_DIFFUSE, matDiffuse);
+            glMaterialfv(GL_FRONT, GL_SPECULAR, matSpecular);
+            glMaterialfv(GL_FRONT, GL_SHININESS, matShininess);
+            materialDirty = false;
+        }
+    }
+
+    static ShaderManager::Variant shaderVariantFor(LightingModel model) {
+        switch (model) {
+            case LightingModel::FLAT: return ShaderManager::FLAT;
+            case LightingModel::GOURAUD: return ShaderManager::GOURAUD;
+            default: return ShaderManager::PHONG;
+        }
+    }
+
+    /**
+     * @brief Uniforms com os mesmos valores enviados ao pipeline fixo em flushLightAndMaterial
+     * @param viewMatrix Modelview da câmera (ordem de colunas), para levar a luz ao espaço do olho
+     */
+    LightingUniforms buildLightingUniforms(const GLfloat viewMatrix[16]) const {
+        LightingUniforms values;
+        const float world[4] = { lightPosition.x, lightPosition.y, lightPosition.z, 1.0f };
+        for (int row = 0; row < 3; row++) {
+            values.lightPosition[row] = viewMatrix[0 * 4 + row] * world[0] + viewMatrix[1 * 4 + row] * world[1] +
+                                        viewMatrix[2 * 4 + row] * world[2] + viewMatrix[3 * 4 + row] * world[3];
+        }
+
+        const float light[3] = { lightColor.redComponent, lightColor.greenComponent, lightColor.blueComponent };
+        const float material[3] = { objectColor.redComponent, objectColor.greenComponent, objectColor.blueComponent };
+        for (int channel = 0; channel < 3; channel++) {
+            values.lightAmbient[channel] = light[channel] * 0.2f;
+            values.lightDiffuse[channel] = light[channel];
+            values.lightSpecular[channel] = light[channel];
+            values.materialAmbient[channel] = material[channel] * 0.3f;
+            values.materialDiffuse[channel] = material[channel];
+            values.materialSpecular[channel] = 1.0f;
+            values.sceneAmbient[channel] = material[channel] * 0.3f * 0.2f; // GL_LIGHT_MODEL_AMBIENT padrão
+        }
+        values.shininess = 50.0f;
+        return values;
+    }
+
+    bool isExtrusionCached(unsigned long sourceId, uint64_t contentHash) const {
+        auto cached = extrusionCache.find(sourceId);
+        return cached != extrusionCache.end() && cached->second.contentHash == contentHash;
+    }
+
+    /**
+     * @brief Substitui objects pela cena descrita em order, numa única troca
+     * @param order Fontes na ordem de desenho
+     * @param built Objetos recém-construídos por id; os não usados são liberados
+     */
+    void commitScene(const std::vector<PendingEntry>& order,
+                     std::unordered_map<unsigned long, std::unique_ptr<Object3D>>& built) {
+        // A cena anterior sai de objects; o que não for reaproveitado é liberado ao fim do escopo
+        std::vector<std::unique_ptr<Object3D>> previous;
+        previous.swap(objects);
+        std::unordered_map<Object3D*, size_t> previousIndex;
+        for (size_t i = 0; i < previous.size(); i++) {
+            previousIndex[previous[i].get()] = i;
+        }
+
+        std::unordered_map<unsigned long, CachedExtrusion> retained;
+        objects.reserve(order.size());
+
+        for (const auto& entry : order) {
+            if (retained.count(entry.sourceId)) {
+                continue;
+            }
+
+            std::unique_ptr<Object3D> obj;
+            auto fresh = built.find(entry.sourceId);
+            if (fresh != built.end()) {
+                obj = std::move(fresh->second);
+                built.erase(fresh);
+            } else {
+                auto cached = extrusionCache.find(entry.sourceId);
+                if (cached != extrusionCache.end() && cached->second.contentHash == entry.contentHash) {
+                    auto owner = previousIndex.find(cached->second.object);
+                    if (owner != previousIndex.end()) {
+                        obj = std::move(previous[owner->second]);
+                    }
+                }
+            }
+            if (!obj) {
+                continue;
+            }
+
+            retained[entry.sourceId] = CachedExtrusion{ entry.contentHash, obj.get() };
+            objects.push_back(std::move(obj));
+        }
+
+        built.clear();
+        extrusionCache.swap(retained);
+        tileBatchesDirty = true;
+    }
+
+    /**
+     * @brief Pixels de tela por unidade de mundo no ponto da esfera mais próximo da câmera
+     *
+     * Usa a projeção guardada em updateProjectionMatrix: na ortográfica a escala não
+     * depende da distância; na perspectiva cai com a profundidade ao longo da direção
+     * de visão (limitada ao plano near, para esferas que envolvem a câmera).
+     */
+    float pixelsPerUnitAt(const Vector3D& center, float radius) const {
+        float pixelsPerUnit = projectionMatrix[5] * viewportHeight * 0.5f;
+        bool perspective = projectionMatrix[11] != 0.0f; // Linha w da matriz: -z na perspectiva
+        if (!perspective) {
+            return pixelsPerUnit;
+        }
+
+        Vector3D forward = cameraTarget - cameraPosition;
+        forward.normalize();
+        Vector3D offset = center - cameraPosition;
+        float depth = offset.x * forward.x + offset.y * forward.y + offset.z * forward.z - radius;
+        return pixelsPerUnit / std::max(depth, 0.1f);
+    }
+
+    /**
+     * @brief Monta um lote por objeto: grade TILE_GRID_SIZE x TILE_GRID_SIZE no plano XY
+     *
+     * O espaçamento vem do maior raio do objeto no plano; as cópias alternam
+     * entre a cor do objeto e uma versão mais escura, em xadrez.
+     */
+    void rebuildTileBatches() {
+        tileBatches.clear();
+        tileBatches.reserve(objects.size());
+
+        const ColorRGB darker(objectColor.redComponent * 0.6f, objectColor.greenComponent * 0.6f,
+                              objectColor.blueComponent * 0.6f);
+        const float half = (TILE_GRID_SIZE - 1) / 2.0f;
+
+        for (auto& obj : objects) {
+            const BoundingVolume& bounds = obj->getBounds();
+            float radius = std::max(std::max(std::fabs(bounds.minX), std::fabs(bounds.maxX)),
+                                    std::max(std::fabs(bounds.minY), std::fabs(bounds.maxY)));
+            float spacing = std::max(radius * 2.2f, 0.1f);
+
+            auto batch = std::make_unique<InstancedMeshBatch>(obj.get());
+            batch->reserve(TILE_GRID_SIZE * TILE_GRID_SIZE);
+            for (int row = 0; row < TILE_GRID_SIZE; row++) {
+                for (int column = 0; column < TILE_GRID_SIZE; column++) {
+                    Vector3D offset((column - half) * spacing, (row - half) * spacing, 0.0f);
+                    batch->addInstance(offset, Vector3D(0, 0, 0), Vector3D(1, 1, 1),
+                                       ((row + column) % 2 == 0) ? objectColor : darker);
+                }
+            }
+            tileBatches.push_back(std::move(batch));
+        }
+        tileBatchesDirty = false;
+    }
+
+    void finishPendingScene() {
+        commitScene(pendingScene.order, pendingScene.built);
+        pendingScene = PendingScene();
+        // Objetos reaproveitados já estão na GPU; só os novos são enviados
+        for (auto& obj : objects) {
+            obj->uploadToGpu();
+        }
+    }
+
+    /**
+     * @brief Descarta a troca de cena em andamento (resultados atrasados são liberados ao chegar)
+     */
+    void cancelPendingExtrusions() {
+        if (!pendingScene.active) {
+            return;
+        }
+        meshPipeline.discardQueuedBefore(pendingScene.generation + 1);
+        pendingScene = PendingScene();
+    }
+
     void loadPhongShader() {
         std::string vertexShader = 
             "varying vec3 N;\n"
@@ -417,6 +914,61 @@ private:
             
         phongProgram = ShaderUtils::createShaderProgram(vertexShader, fragmentShader);
     }
+
+    /**
+     * @brief Phong com matriz e cor por instância (atributos com divisor 1)
+     *
+     * Mesma iluminação de loadPhongShader, com a cor da cópia no lugar do
+     * material difuso/ambiente. A normal usa a parte 3x3 da matriz da cópia,
+     * exata para escalas uniformes.
+     */
+    void loadInstancedPhongShader() {
+        if (!ShaderUtils::hasInstancing()) {
+            return;
+        }
+
+        std::string vertexShader =
+            "#version 120\n"
+            "attribute mat4 instanceTransform;\n"
+            "attribute vec4 instanceColor;\n"
+            "varying vec3 N;\n"
+            "varying vec3 v;\n"
+            "varying vec4 color;\n"
+            "void main(void) {\n"
+            "   vec4 world = instanceTransform * gl_Vertex;\n"
+            "   v = vec3(gl_ModelViewMatrix * world);\n"
+            "   N = normalize(gl_NormalMatrix * (mat3(instanceTransform) * gl_Normal));\n"
+            "   color = instanceColor;\n"
+            "   gl_Position = gl_ModelViewProjectionMatrix * world;\n"
+            "}";
+
+        std::string fragmentShader =
+            "#version 120\n"
+            "varying vec3 N;\n"
+            "varying vec3 v;\n"
+            "varying vec4 color;\n"
+            "void main(void) {\n"
+            "   vec3 n = normalize(N);\n"
+            "   vec3 L = normalize(gl_LightSource[0].position.xyz - v);\n"
+            "   vec3 E = normalize(-v);\n"
+            "   vec3 R = normalize(-reflect(L,n));\n"
+            "   vec4 Iamb = gl_LightSource[0].ambient * vec4(color.rgb * 0.3, color.a);\n"
+            "   vec4 Idiff = gl_LightSource[0].diffuse * color * max(dot(n,L), 0.0);\n"
+            "   Idiff = clamp(Idiff, 0.0, 1.0);\n"
+            "   vec4 Ispec = gl_FrontLightProduct[0].specular * pow(max(dot(R,E),0.0), 0.3 * gl_FrontMaterial.shininess);\n"
+            "   Ispec = clamp(Ispec, 0.0, 1.0);\n"
+            "   gl_FragColor = gl_FrontLightModelProduct.sceneColor + Iamb + Idiff + Ispec;\n"
+            "}";
+
+        instancedPhong.program = ShaderUtils::createShaderProgram(vertexShader, fragmentShader);
+        if (instancedPhong.program) {
+            instancedPhong.transformLocation = glGetAttribLocation(instancedPhong.program, "instanceTransform");
+            instancedPhong.colorLocation = glGetAttribLocation(instancedPhong.program, "instanceColor");
+        }
+        if (!instancedPhong.isValid()) {
+            std::cerr << "Aviso: shader instanciado indisponivel. Copias desenhadas em laco." << std::endl;
+        }
+    }
 };
 
 #endif // SCENE_MANAGER_H
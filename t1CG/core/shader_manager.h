@@ -0,0 +1,365 @@
+/**
+ * @file shader_manager.h
+ * @brief Programas GLSL 3.3 de iluminação (Flat, Gouraud, Phong) com uniforms explícitos e cache de binários
+ * @author Sistema de Computação Gráfica
+ * @date 2025
+ */
+
+#ifndef SHADER_MANAGER_H
+#define SHADER_MANAGER_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <GL/gl.h>
+#include "shader_utils.h"
+
+/**
+ * @brief Valores de luz e material enviados como uniforms (cores RGB, posição no espaço do olho)
+ */
+struct LightingUniforms {
+    float lightPosition[3];
+    float lightAmbient[3];
+    float lightDiffuse[3];
+    float lightSpecular[3];
+    float materialAmbient[3];
+    float materialDiffuse[3];
+    float materialSpecular[3];
+    float sceneAmbient[3]; // Ambiente global do modelo de luz já multiplicado pelo material
+    float shininess;
+};
+
+/**
+ * @class ShaderManager
+ * @brief Compila (ou recarrega do disco) um programa por modelo de iluminação e guarda os locais dos uniforms
+ *
+ * Os shaders são "#version 330 compatibility": vértices, normais e matrizes
+ * continuam vindo do pipeline fixo (glVertexPointer, gluLookAt), mas luz e
+ * material chegam só por uniforms. Quando o driver oferece glGetProgramBinary,
+ * cada programa é salvo em shader_cache_<nome>.bin; o arquivo é descartado se
+ * o fonte, o renderer ou a versão do driver mudarem.
+ */
+class ShaderManager {
+public:
+    enum Variant {
+        FLAT,
+        GOURAUD,
+        PHONG,
+        VARIANT_COUNT
+    };
+
+private:
+    struct Program {
+        GLuint handle;
+        GLint lightPosition, lightAmbient, lightDiffuse, lightSpecular;
+        GLint materialAmbient, materialDiffuse, materialSpecular;
+        GLint sceneAmbient, shininess;
+        unsigned long uploadedRevision; // Revisão de LightingUniforms já enviada a este programa
+        bool hasUniforms;
+
+        Program() : handle(0), lightPosition(-1), lightAmbient(-1), lightDiffuse(-1), lightSpecular(-1),
+                    materialAmbient(-1), materialDiffuse(-1), materialSpecular(-1),
+                    sceneAmbient(-1), shininess(-1), uploadedRevision(0), hasUniforms(false) {}
+    };
+
+    static const uint32_t CACHE_MAGIC = 0x43475342; // "CGSB"
+
+    Program programs[VARIANT_COUNT];
+    bool available;
+
+    static const char* variantName(Variant variant) {
+        switch (variant) {
+            case FLAT: return "flat";
+            case GOURAUD: return "gouraud";
+            default: return "phong";
+        }
+    }
+
+    static std::string lightingUniformDeclarations() {
+        return
+            "uniform vec3 uLightPosition;\n" // Espaço do olho
+            "uniform vec3 uLightAmbient;\n"
+            "uniform vec3 uLightDiffuse;\n"
+            "uniform vec3 uLightSpecular;\n"
+            "uniform vec3 uMaterialAmbient;\n"
+            "uniform vec3 uMaterialDiffuse;\n"
+            "uniform vec3 uMaterialSpecular;\n"
+            "uniform vec3 uSceneAmbient;\n"
+            "uniform float uShininess;\n"
+            "vec3 shade(vec3 P, vec3 N, float exponent) {\n"
+            "   vec3 L = normalize(uLightPosition - P);\n"
+            "   vec3 E = normalize(-P);\n"
+            "   vec3 R = reflect(-L, N);\n"
+            "   float diffuse = max(dot(N, L), 0.0);\n"
+            "   float specular = diffuse > 0.0 ? pow(max(dot(R, E), 0.0), exponent) : 0.0;\n"
+            "   return uSceneAmbient + uLightAmbient * uMaterialAmbient\n"
+            "        + clamp(uLightDiffuse * uMaterialDiffuse * diffuse, 0.0, 1.0)\n"
+            "        + clamp(uLightSpecular * uMaterialSpecular * specular, 0.0, 1.0);\n"
+            "}\n";
+    }
+
+    /**
+     * @brief Fontes de cada variante: Flat e Gouraud iluminam por vértice, Phong por fragmento
+     *
+     * Flat usa interpolação "flat" sobre a malha FLAT (normal da face em todos
+     * os cantos); Phong mantém o expoente 0.3 * brilho do shader anterior.
+     */
+    static void sourcesFor(Variant variant, std::string& vertexSource, std::string& fragmentSource) {
+        const std::string header = "#version 330 compatibility\n";
+        if (variant == PHONG) {
+            vertexSource = header +
+                "out vec3 vNormal;\n"
+                "out vec3 vPosition;\n"
+                "void main(void) {\n"
+                "   vPosition = vec3(gl_ModelViewMatrix * gl_Vertex);\n"
+                "   vNormal = gl_NormalMatrix * gl_Normal;\n"
+                "   gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;\n"
+                "}\n";
+            fragmentSource = header + lightingUniformDeclarations() +
+                "in vec3 vNormal;\n"
+                "in vec3 vPosition;\n"
+                "out vec4 fragColor;\n"
+                "void main(void) {\n"
+                "   fragColor = vec4(shade(vPosition, normalize(vNormal), 0.3 * uShininess), 1.0);\n"
+                "}\n";
+            return;
+        }
+
+        const std::string qualifier = (variant == FLAT) ? "flat " : "";
+        vertexSource = header + lightingUniformDeclarations() +
+            qualifier + "out vec3 vColor;\n"
+            "void main(void) {\n"
+            "   vec3 P = vec3(gl_ModelViewMatrix * gl_Vertex);\n"
+            "   vColor = shade(P, normalize(gl_NormalMatrix * gl_Normal), uShininess);\n"
+            "   gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;\n"
+            "}\n";
+        fragmentSource = header +
+            qualifier + "in vec3 vColor;\n"
+            "out vec4 fragColor;\n"
+            "void main(void) {\n"
+            "   fragColor = vec4(vColor, 1.0);\n"
+            "}\n";
+    }
+
+    /**
+     * @brief FNV-1a de 64 bits, encadeável
+     */
+    static uint64_t hashBytes(const void* data, size_t size, uint64_t hash = 1469598103934665603ull) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; i++) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    /**
+     * @brief Identifica fonte + driver: um binário só vale para a mesma combinação
+     */
+    static uint64_t cacheKey(const std::string& vertexSource, const std::string& fragmentSource) {
+        uint64_t hash = hashBytes(vertexSource.data(), vertexSource.size());
+        hash = hashBytes(fragmentSource.data(), fragmentSource.size(), hash);
+        const GLenum driverStrings[] = { GL_VENDOR, GL_RENDERER, GL_VERSION };
+        for (GLenum name : driverStrings) {
+            const char* value = reinterpret_cast<const char*>(glGetString(name));
+            if (value) {
+                hash = hashBytes(value, std::char_traits<char>::length(value), hash);
+            }
+        }
+        return hash;
+    }
+
+    static std::string cachePath(Variant variant) {
+        return std::string("shader_cache_") + variantName(variant) + ".bin";
+    }
+
+    /**
+     * @brief Tenta recriar o programa a partir do binário salvo
+     * @return Programa linkado, ou 0 se não houver arquivo válido ou o driver o rejeitar
+     */
+    static GLuint loadCachedProgram(Variant variant, uint64_t key) {
+        FILE* file = std::fopen(cachePath(variant).c_str(), "rb");
+        if (!file) {
+            return 0;
+        }
+
+        uint32_t magic = 0, format = 0, length = 0;
+        uint64_t storedKey = 0;
+        std::vector<char> binary;
+        bool valid = std::fread(&magic, sizeof(magic), 1, file) == 1 && magic == CACHE_MAGIC &&
+                     std::fread(&storedKey, sizeof(storedKey), 1, file) == 1 && storedKey == key &&
+                     std::fread(&format, sizeof(format), 1, file) == 1 &&
+                     std::fread(&length, sizeof(length), 1, file) == 1 && length > 0;
+        if (valid) {
+            binary.resize(length);
+            valid = std::fread(binary.data(), 1, length, file) == length;
+        }
+        std::fclose(file);
+        if (!valid) {
+            return 0;
+        }
+
+        GLuint program = glCreateProgram();
+        glProgramBinary(program, static_cast<GLenum>(format), binary.data(), static_cast<GLsizei>(length));
+        GLint linked = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &linked);
+        if (!linked) {
+            if (glDeleteProgram) {
+                glDeleteProgram(program);
+            }
+            return 0;
+        }
+        return program;
+    }
+
+    static void saveProgramBinary(Variant variant, GLuint program, uint64_t key) {
+        GLint length = 0;
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0) {
+            return;
+        }
+
+        std::vector<char> binary(static_cast<size_t>(length));
+        GLenum format = 0;
+        GLsizei written = 0;
+        glGetProgramBinary(program, length, &written, &format, binary.data());
+        if (written <= 0) {
+            return;
+        }
+
+        FILE* file = std::fopen(cachePath(variant).c_str(), "wb");
+        if (!file) {
+            return;
+        }
+        uint32_t magic = CACHE_MAGIC;
+        uint32_t storedFormat = static_cast<uint32_t>(format);
+        uint32_t storedLength = static_cast<uint32_t>(written);
+        std::fwrite(&magic, sizeof(magic), 1, file);
+        std::fwrite(&key, sizeof(key), 1, file);
+        std::fwrite(&storedFormat, sizeof(storedFormat), 1, file);
+        std::fwrite(&storedLength, sizeof(storedLength), 1, file);
+        std::fwrite(binary.data(), 1, storedLength, file);
+        std::fclose(file);
+    }
+
+    static void cacheUniformLocations(Program& program) {
+        GLuint handle = program.handle;
+        program.lightPosition = glGetUniformLocation(handle, "uLightPosition");
+        program.lightAmbient = glGetUniformLocation(handle, "uLightAmbient");
+        program.lightDiffuse = glGetUniformLocation(handle, "uLightDiffuse");
+        program.lightSpecular = glGetUniformLocation(handle, "uLightSpecular");
+        program.materialAmbient = glGetUniformLocation(handle, "uMaterialAmbient");
+        program.materialDiffuse = glGetUniformLocation(handle, "uMaterialDiffuse");
+        program.materialSpecular = glGetUniformLocation(handle, "uMaterialSpecular");
+        program.sceneAmbient = glGetUniformLocation(handle, "uSceneAmbient");
+        program.shininess = glGetUniformLocation(handle, "uShininess");
+        program.hasUniforms = true;
+    }
+
+    static void setVector(GLint location, const float value[3]) {
+        if (location >= 0) {
+            glUniform3f(location, value[0], value[1], value[2]);
+        }
+    }
+
+    static void uploadUniforms(const Program& program, const LightingUniforms& values) {
+        setVector(program.lightPosition, values.lightPosition);
+        setVector(program.lightAmbient, values.lightAmbient);
+        setVector(program.lightDiffuse, values.lightDiffuse);
+        setVector(program.lightSpecular, values.lightSpecular);
+        setVector(program.materialAmbient, values.materialAmbient);
+        setVector(program.materialDiffuse, values.materialDiffuse);
+        setVector(program.materialSpecular, values.materialSpecular);
+        setVector(program.sceneAmbient, values.sceneAmbient);
+        if (program.shininess >= 0) {
+            glUniform1f(program.shininess, values.shininess);
+        }
+    }
+
+public:
+    ShaderManager() : available(false) {}
+
+    ~ShaderManager() {
+        release();
+    }
+
+    ShaderManager(const ShaderManager&) = delete;
+    ShaderManager& operator=(const ShaderManager&) = delete;
+
+    /**
+     * @brief Carrega as três variantes (do cache de binários ou compilando)
+     * @return true se todas ficaram prontas; caso contrário nenhuma é usada
+     *
+     * Exige contexto atual e ShaderUtils::loadExtensions() já chamado.
+     */
+    bool load() {
+        release();
+        if (!glCreateShader || !glGetUniformLocation || !glUniform3f || !glUniform1f ||
+            ShaderUtils::getShadingLanguageVersion() < 330) {
+            return false;
+        }
+
+        const bool binaryCache = ShaderUtils::hasProgramBinary();
+        for (int index = 0; index < VARIANT_COUNT; index++) {
+            Variant variant = static_cast<Variant>(index);
+            std::string vertexSource, fragmentSource;
+            sourcesFor(variant, vertexSource, fragmentSource);
+
+            uint64_t key = binaryCache ? cacheKey(vertexSource, fragmentSource) : 0;
+            GLuint handle = binaryCache ? loadCachedProgram(variant, key) : 0;
+            if (!handle) {
+                handle = ShaderUtils::createShaderProgram(vertexSource, fragmentSource, binaryCache);
+                if (handle && binaryCache) {
+                    saveProgramBinary(variant, handle, key);
+                }
+            }
+            if (!handle) {
+                release();
+                return false;
+            }
+
+            programs[index].handle = handle;
+            cacheUniformLocations(programs[index]);
+        }
+
+        available = true;
+        return true;
+    }
+
+    void release() {
+        for (Program& program : programs) {
+            if (program.handle && glDeleteProgram) {
+                glDeleteProgram(program.handle);
+            }
+            program = Program();
+        }
+        available = false;
+    }
+
+    bool isAvailable() const { return available; }
+
+    GLuint getProgram(Variant variant) const {
+        return available ? programs[variant].handle : 0;
+    }
+
+    /**
+     * @brief Envia os uniforms ao programa, se ele ainda não tiver a revisão informada
+     * @param revision Número que muda sempre que values muda (0 nunca é considerado enviado)
+     *
+     * O programa precisa estar em uso (glUseProgram) na chamada.
+     */
+    void applyUniforms(Variant variant, const LightingUniforms& values, unsigned long revision) {
+        if (!available) {
+            return;
+        }
+        Program& program = programs[variant];
+        if (program.uploadedRevision == revision && revision != 0) {
+            return;
+        }
+        uploadUniforms(program, values);
+        program.uploadedRevision = revision;
+    }
+};
+
+#endif // SHADER_MANAGER_H
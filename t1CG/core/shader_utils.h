@@ -14,6 +14,9 @@
 // No Windows, precisamos carregar as funções manualmente ou usar GLEW/GLAD.
 // Como não temos GLEW/GLAD fácil aqui, vamos usar wglGetProcAddress para carregar o básico necessário para Shaders (GL 2.0)
 
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
 #include <iostream>
 #include <fstream>
 #include <string>
@@ -38,6 +41,63 @@
 #define GL_INFO_LOG_LENGTH 0x8B84
 #endif
 
+#ifndef GL_SHADING_LANGUAGE_VERSION
+#define GL_SHADING_LANGUAGE_VERSION 0x8B8C
+#endif
+
+// Binários de programa (OpenGL 4.1 / ARB_get_program_binary)
+#ifndef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#endif
+#ifndef GL_PROGRAM_BINARY_LENGTH
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#endif
+#ifndef GL_NUM_PROGRAM_BINARY_FORMATS
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#endif
+
+// Buffer objects (OpenGL 1.5)
+#ifndef GL_ARRAY_BUFFER
+#define GL_ARRAY_BUFFER 0x8892
+#endif
+#ifndef GL_ELEMENT_ARRAY_BUFFER
+#define GL_ELEMENT_ARRAY_BUFFER 0x8893
+#endif
+#ifndef GL_STATIC_DRAW
+#define GL_STATIC_DRAW 0x88E4
+#endif
+#ifndef GL_DYNAMIC_DRAW
+#define GL_DYNAMIC_DRAW 0x88E8
+#endif
+#ifndef GL_STREAM_DRAW
+#define GL_STREAM_DRAW 0x88E0
+#endif
+
+// Framebuffer objects (OpenGL 3.0 / EXT_framebuffer_object)
+#ifndef GL_FRAMEBUFFER
+#define GL_FRAMEBUFFER 0x8D40
+#endif
+#ifndef GL_FRAMEBUFFER_BINDING
+#define GL_FRAMEBUFFER_BINDING 0x8CA6
+#endif
+#ifndef GL_COLOR_ATTACHMENT0
+#define GL_COLOR_ATTACHMENT0 0x8CE0
+#endif
+#ifndef GL_FRAMEBUFFER_COMPLETE
+#define GL_FRAMEBUFFER_COMPLETE 0x8CD5
+#endif
+
+// Consultas de tempo da GPU (OpenGL 3.3 / ARB_timer_query)
+#ifndef GL_TIME_ELAPSED
+#define GL_TIME_ELAPSED 0x88BF
+#endif
+#ifndef GL_QUERY_RESULT
+#define GL_QUERY_RESULT 0x8866
+#endif
+#ifndef GL_QUERY_RESULT_AVAILABLE
+#define GL_QUERY_RESULT_AVAILABLE 0x8867
+#endif
+
 typedef GLuint (APIENTRY *PFNGLCREATESHADERPROC) (GLenum type);
 typedef void (APIENTRY *PFNGLSHADERSOURCEPROC) (GLuint shader, GLsizei count, const char* const* string, const GLint* length);
 typedef void (APIENTRY *PFNGLCOMPILESHADERPROC) (GLuint shader);
@@ -50,24 +110,81 @@ typedef void (APIENTRY *PFNGLGETPROGRAMIVPROC) (GLuint program, GLenum pname, GL
 typedef void (APIENTRY *PFNGLGETPROGRAMINFOLOGPROC) (GLuint program, GLsizei bufSize, GLsizei* length, char* infoLog);
 typedef void (APIENTRY *PFNGLUSEPROGRAMPROC) (GLuint program);
 typedef GLint (APIENTRY *PFNGLGETUNIFORMLOCATIONPROC) (GLuint program, const char* name);
+typedef void (APIENTRY *PFNGLDELETESHADERPROC) (GLuint shader);
+typedef void (APIENTRY *PFNGLDETACHSHADERPROC) (GLuint program, GLuint shader);
+typedef void (APIENTRY *PFNGLDELETEPROGRAMPROC) (GLuint program);
+typedef void (APIENTRY *PFNGLPROGRAMPARAMETERIPROC) (GLuint program, GLenum pname, GLint value);
+typedef void (APIENTRY *PFNGLGETPROGRAMBINARYPROC) (GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary);
+typedef void (APIENTRY *PFNGLPROGRAMBINARYPROC) (GLuint program, GLenum binaryFormat, const void* binary, GLsizei length);
 typedef void (APIENTRY *PFNGLUNIFORM1FPROC) (GLint location, GLfloat v0);
 typedef void (APIENTRY *PFNGLUNIFORM3FPROC) (GLint location, GLfloat v0, GLfloat v1, GLfloat v2);
+typedef void (APIENTRY *PFNGLGENBUFFERSPROC) (GLsizei n, GLuint* buffers);
+typedef void (APIENTRY *PFNGLBINDBUFFERPROC) (GLenum target, GLuint buffer);
+typedef void (APIENTRY *PFNGLBUFFERDATAPROC) (GLenum target, ptrdiff_t size, const void* data, GLenum usage);
+typedef void (APIENTRY *PFNGLDELETEBUFFERSPROC) (GLsizei n, const GLuint* buffers);
+typedef GLint (APIENTRY *PFNGLGETATTRIBLOCATIONPROC) (GLuint program, const char* name);
+typedef void (APIENTRY *PFNGLVERTEXATTRIBPOINTERPROC) (GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer);
+typedef void (APIENTRY *PFNGLENABLEVERTEXATTRIBARRAYPROC) (GLuint index);
+typedef void (APIENTRY *PFNGLDISABLEVERTEXATTRIBARRAYPROC) (GLuint index);
+typedef void (APIENTRY *PFNGLVERTEXATTRIBDIVISORPROC) (GLuint index, GLuint divisor);
+typedef void (APIENTRY *PFNGLDRAWELEMENTSINSTANCEDPROC) (GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instancecount);
+typedef void (APIENTRY *PFNGLGENFRAMEBUFFERSPROC) (GLsizei n, GLuint* framebuffers);
+typedef void (APIENTRY *PFNGLBINDFRAMEBUFFERPROC) (GLenum target, GLuint framebuffer);
+typedef void (APIENTRY *PFNGLFRAMEBUFFERTEXTURE2DPROC) (GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level);
+typedef GLenum (APIENTRY *PFNGLCHECKFRAMEBUFFERSTATUSPROC) (GLenum target);
+typedef void (APIENTRY *PFNGLDELETEFRAMEBUFFERSPROC) (GLsizei n, const GLuint* framebuffers);
+typedef void (APIENTRY *PFNGLBLENDFUNCSEPARATEPROC) (GLenum sfactorRGB, GLenum dfactorRGB, GLenum sfactorAlpha, GLenum dfactorAlpha);
+typedef void (APIENTRY *PFNGLGENQUERIESPROC) (GLsizei n, GLuint* ids);
+typedef void (APIENTRY *PFNGLDELETEQUERIESPROC) (GLsizei n, const GLuint* ids);
+typedef void (APIENTRY *PFNGLBEGINQUERYPROC) (GLenum target, GLuint id);
+typedef void (APIENTRY *PFNGLENDQUERYPROC) (GLenum target);
+typedef void (APIENTRY *PFNGLGETQUERYOBJECTIVPROC) (GLuint id, GLenum pname, GLint* params);
+typedef void (APIENTRY *PFNGLGETQUERYOBJECTUI64VPROC) (GLuint id, GLenum pname, uint64_t* params);
 
-// Variáveis globais para as funções (serão carregadas no init)
-extern PFNGLCREATESHADERPROC glCreateShader;
-extern PFNGLSHADERSOURCEPROC glShaderSource;
-extern PFNGLCOMPILESHADERPROC glCompileShader;
-extern PFNGLGETSHADERIVPROC glGetShaderiv;
-extern PFNGLGETSHADERINFOLOGPROC glGetShaderInfoLog;
-extern PFNGLCREATEPROGRAMPROC glCreateProgram;
-extern PFNGLATTACHSHADERPROC glAttachShader;
-extern PFNGLLINKPROGRAMPROC glLinkProgram;
-extern PFNGLGETPROGRAMIVPROC glGetProgramiv;
-extern PFNGLGETPROGRAMINFOLOGPROC glGetProgramInfoLog;
-extern PFNGLUSEPROGRAMPROC glUseProgram;
-extern PFNGLGETUNIFORMLOCATIONPROC glGetUniformLocation;
-extern PFNGLUNIFORM1FPROC glUniform1f;
-extern PFNGLUNIFORM3FPROC glUniform3f;
+// Variáveis globais para as funções (carregadas em loadExtensions; inline para que
+// qualquer executável que inclua os módulos, como o benchmark, tenha uma única definição)
+inline PFNGLCREATESHADERPROC glCreateShader = NULL;
+inline PFNGLSHADERSOURCEPROC glShaderSource = NULL;
+inline PFNGLCOMPILESHADERPROC glCompileShader = NULL;
+inline PFNGLGETSHADERIVPROC glGetShaderiv = NULL;
+inline PFNGLGETSHADERINFOLOGPROC glGetShaderInfoLog = NULL;
+inline PFNGLCREATEPROGRAMPROC glCreateProgram = NULL;
+inline PFNGLATTACHSHADERPROC glAttachShader = NULL;
+inline PFNGLLINKPROGRAMPROC glLinkProgram = NULL;
+inline PFNGLGETPROGRAMIVPROC glGetProgramiv = NULL;
+inline PFNGLGETPROGRAMINFOLOGPROC glGetProgramInfoLog = NULL;
+inline PFNGLUSEPROGRAMPROC glUseProgram = NULL;
+inline PFNGLGETUNIFORMLOCATIONPROC glGetUniformLocation = NULL;
+inline PFNGLDELETESHADERPROC glDeleteShader = NULL;
+inline PFNGLDETACHSHADERPROC glDetachShader = NULL;
+inline PFNGLDELETEPROGRAMPROC glDeleteProgram = NULL;
+inline PFNGLPROGRAMPARAMETERIPROC glProgramParameteri = NULL;
+inline PFNGLGETPROGRAMBINARYPROC glGetProgramBinary = NULL;
+inline PFNGLPROGRAMBINARYPROC glProgramBinary = NULL;
+inline PFNGLUNIFORM1FPROC glUniform1f = NULL;
+inline PFNGLUNIFORM3FPROC glUniform3f = NULL;
+inline PFNGLGENBUFFERSPROC glGenBuffers = NULL;
+inline PFNGLBINDBUFFERPROC glBindBuffer = NULL;
+inline PFNGLBUFFERDATAPROC glBufferData = NULL;
+inline PFNGLDELETEBUFFERSPROC glDeleteBuffers = NULL;
+inline PFNGLGETATTRIBLOCATIONPROC glGetAttribLocation = NULL;
+inline PFNGLVERTEXATTRIBPOINTERPROC glVertexAttribPointer = NULL;
+inline PFNGLENABLEVERTEXATTRIBARRAYPROC glEnableVertexAttribArray = NULL;
+inline PFNGLDISABLEVERTEXATTRIBARRAYPROC glDisableVertexAttribArray = NULL;
+inline PFNGLVERTEXATTRIBDIVISORPROC glVertexAttribDivisor = NULL;
+inline PFNGLDRAWELEMENTSINSTANCEDPROC glDrawElementsInstanced = NULL;
+inline PFNGLGENFRAMEBUFFERSPROC glGenFramebuffers = NULL;
+inline PFNGLBINDFRAMEBUFFERPROC glBindFramebuffer = NULL;
+inline PFNGLFRAMEBUFFERTEXTURE2DPROC glFramebufferTexture2D = NULL;
+inline PFNGLCHECKFRAMEBUFFERSTATUSPROC glCheckFramebufferStatus = NULL;
+inline PFNGLDELETEFRAMEBUFFERSPROC glDeleteFramebuffers = NULL;
+inline PFNGLBLENDFUNCSEPARATEPROC glBlendFuncSeparate = NULL;
+inline PFNGLGENQUERIESPROC glGenQueries = NULL;
+inline PFNGLDELETEQUERIESPROC glDeleteQueries = NULL;
+inline PFNGLBEGINQUERYPROC glBeginQuery = NULL;
+inline PFNGLENDQUERYPROC glEndQuery = NULL;
+inline PFNGLGETQUERYOBJECTIVPROC glGetQueryObjectiv = NULL;
+inline PFNGLGETQUERYOBJECTUI64VPROC glGetQueryObjectui64v = NULL;
 
 class ShaderUtils {
 public:
@@ -86,27 +203,162 @@ public:
         glGetUniformLocation = (PFNGLGETUNIFORMLOCATIONPROC)wglGetProcAddress("glGetUniformLocation");
         glUniform1f = (PFNGLUNIFORM1FPROC)wglGetProcAddress("glUniform1f");
         glUniform3f = (PFNGLUNIFORM3FPROC)wglGetProcAddress("glUniform3f");
+        glDeleteShader = (PFNGLDELETESHADERPROC)wglGetProcAddress("glDeleteShader");
+        glDetachShader = (PFNGLDETACHSHADERPROC)wglGetProcAddress("glDetachShader");
+        glDeleteProgram = (PFNGLDELETEPROGRAMPROC)wglGetProcAddress("glDeleteProgram");
+
+        // Cache de binários de programa; opcional (ShaderManager recompila sem ele)
+        glProgramParameteri = (PFNGLPROGRAMPARAMETERIPROC)wglGetProcAddress("glProgramParameteri");
+        glGetProgramBinary = (PFNGLGETPROGRAMBINARYPROC)wglGetProcAddress("glGetProgramBinary");
+        glProgramBinary = (PFNGLPROGRAMBINARYPROC)wglGetProcAddress("glProgramBinary");
+
+        // Buffer objects para as malhas (Object3D); sem eles o desenho volta ao modo imediato
+        glGenBuffers = (PFNGLGENBUFFERSPROC)wglGetProcAddress("glGenBuffers");
+        glBindBuffer = (PFNGLBINDBUFFERPROC)wglGetProcAddress("glBindBuffer");
+        glBufferData = (PFNGLBUFFERDATAPROC)wglGetProcAddress("glBufferData");
+        glDeleteBuffers = (PFNGLDELETEBUFFERSPROC)wglGetProcAddress("glDeleteBuffers");
+
+        // Instancing (OpenGL 3.3 ou ARB_instanced_arrays); sem ele as cópias são desenhadas em laço
+        glGetAttribLocation = (PFNGLGETATTRIBLOCATIONPROC)wglGetProcAddress("glGetAttribLocation");
+        glVertexAttribPointer = (PFNGLVERTEXATTRIBPOINTERPROC)wglGetProcAddress("glVertexAttribPointer");
+        glEnableVertexAttribArray = (PFNGLENABLEVERTEXATTRIBARRAYPROC)wglGetProcAddress("glEnableVertexAttribArray");
+        glDisableVertexAttribArray = (PFNGLDISABLEVERTEXATTRIBARRAYPROC)wglGetProcAddress("glDisableVertexAttribArray");
+        glVertexAttribDivisor = (PFNGLVERTEXATTRIBDIVISORPROC)wglGetProcAddress("glVertexAttribDivisor");
+        if (!glVertexAttribDivisor) {
+            glVertexAttribDivisor = (PFNGLVERTEXATTRIBDIVISORPROC)wglGetProcAddress("glVertexAttribDivisorARB");
+        }
+        glDrawElementsInstanced = (PFNGLDRAWELEMENTSINSTANCEDPROC)wglGetProcAddress("glDrawElementsInstanced");
+        if (!glDrawElementsInstanced) {
+            glDrawElementsInstanced = (PFNGLDRAWELEMENTSINSTANCEDPROC)wglGetProcAddress("glDrawElementsInstancedARB");
+        }
+
+        // Framebuffer objects para renderizar em textura (atlas de glifos da UI)
+        glGenFramebuffers = (PFNGLGENFRAMEBUFFERSPROC)wglGetProcAddress("glGenFramebuffers");
+        glBindFramebuffer = (PFNGLBINDFRAMEBUFFERPROC)wglGetProcAddress("glBindFramebuffer");
+        glFramebufferTexture2D = (PFNGLFRAMEBUFFERTEXTURE2DPROC)wglGetProcAddress("glFramebufferTexture2D");
+        glCheckFramebufferStatus = (PFNGLCHECKFRAMEBUFFERSTATUSPROC)wglGetProcAddress("glCheckFramebufferStatus");
+        glDeleteFramebuffers = (PFNGLDELETEFRAMEBUFFERSPROC)wglGetProcAddress("glDeleteFramebuffers");
+        if (!glGenFramebuffers) {
+            glGenFramebuffers = (PFNGLGENFRAMEBUFFERSPROC)wglGetProcAddress("glGenFramebuffersEXT");
+            glBindFramebuffer = (PFNGLBINDFRAMEBUFFERPROC)wglGetProcAddress("glBindFramebufferEXT");
+            glFramebufferTexture2D = (PFNGLFRAMEBUFFERTEXTURE2DPROC)wglGetProcAddress("glFramebufferTexture2DEXT");
+            glCheckFramebufferStatus = (PFNGLCHECKFRAMEBUFFERSTATUSPROC)wglGetProcAddress("glCheckFramebufferStatusEXT");
+            glDeleteFramebuffers = (PFNGLDELETEFRAMEBUFFERSPROC)wglGetProcAddress("glDeleteFramebuffersEXT");
+        }
+
+        // Blending com fatores separados para o alfa (OpenGL 1.4), usado no cache do painel
+        glBlendFuncSeparate = (PFNGLBLENDFUNCSEPARATEPROC)wglGetProcAddress("glBlendFuncSeparate");
+        if (!glBlendFuncSeparate) {
+            glBlendFuncSeparate = (PFNGLBLENDFUNCSEPARATEPROC)wglGetProcAddress("glBlendFuncSeparateEXT");
+        }
+
+        // Consultas de tempo da GPU para o FrameProfiler; sem elas só o tempo de CPU é medido
+        glGenQueries = (PFNGLGENQUERIESPROC)wglGetProcAddress("glGenQueries");
+        glDeleteQueries = (PFNGLDELETEQUERIESPROC)wglGetProcAddress("glDeleteQueries");
+        glBeginQuery = (PFNGLBEGINQUERYPROC)wglGetProcAddress("glBeginQuery");
+        glEndQuery = (PFNGLENDQUERYPROC)wglGetProcAddress("glEndQuery");
+        glGetQueryObjectiv = (PFNGLGETQUERYOBJECTIVPROC)wglGetProcAddress("glGetQueryObjectiv");
+        glGetQueryObjectui64v = (PFNGLGETQUERYOBJECTUI64VPROC)wglGetProcAddress("glGetQueryObjectui64v");
+        if (!glGetQueryObjectui64v) {
+            glGetQueryObjectui64v = (PFNGLGETQUERYOBJECTUI64VPROC)wglGetProcAddress("glGetQueryObjectui64vEXT");
+        }
 
         return glCreateShader && glUseProgram;
     }
 
-    static GLuint createShaderProgram(const std::string& vertexSource, const std::string& fragmentSource) {
+    /**
+     * @brief Indica se as funções de buffer objects (VBO/IBO) foram carregadas
+     */
+    static bool hasBufferObjects() {
+        return glGenBuffers && glBindBuffer && glBufferData && glDeleteBuffers;
+    }
+
+    /**
+     * @brief Indica se há suporte a desenho instanciado com atributos por instância
+     */
+    static bool hasInstancing() {
+        return hasBufferObjects() && glGetAttribLocation && glVertexAttribPointer &&
+               glEnableVertexAttribArray && glDisableVertexAttribArray &&
+               glVertexAttribDivisor && glDrawElementsInstanced;
+    }
+
+    /**
+     * @brief Indica se há framebuffer objects para renderizar em textura
+     */
+    static bool hasFramebufferObjects() {
+        return glGenFramebuffers && glBindFramebuffer && glFramebufferTexture2D &&
+               glCheckFramebufferStatus && glDeleteFramebuffers;
+    }
+
+    /**
+     * @brief Indica se há consultas GL_TIME_ELAPSED (tempo de GPU por trecho do quadro)
+     */
+    static bool hasTimerQueries() {
+        return glGenQueries && glDeleteQueries && glBeginQuery && glEndQuery &&
+               glGetQueryObjectiv && glGetQueryObjectui64v;
+    }
+
+    /**
+     * @brief Indica se os binários de programa podem ser lidos e recarregados
+     */
+    static bool hasProgramBinary() {
+        return glProgramParameteri && glGetProgramBinary && glProgramBinary;
+    }
+
+    /**
+     * @brief Versão de GLSL suportada, como 100 * maior + menor (ex.: 330); 0 se desconhecida
+     */
+    static int getShadingLanguageVersion() {
+        const char* version = reinterpret_cast<const char*>(glGetString(GL_SHADING_LANGUAGE_VERSION));
+        int major = 0, minor = 0;
+        if (!version || std::sscanf(version, "%d.%d", &major, &minor) != 2) {
+            return 0;
+        }
+        return major * 100 + (minor < 10 ? minor * 10 : minor);
+    }
+
+    /**
+     * @brief Compila e linka um programa a partir dos fontes
+     * @param retrievableBinary Pede ao driver que guarde o binário (glGetProgramBinary)
+     * @return Programa linkado, ou 0 (com o erro no stderr)
+     *
+     * Os shaders são soltos do programa e apagados após o link.
+     */
+    static GLuint createShaderProgram(const std::string& vertexSource, const std::string& fragmentSource,
+                                      bool retrievableBinary = false) {
         GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexSource);
         GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentSource);
 
-        if (!vertexShader || !fragmentShader) return 0;
+        if (!vertexShader || !fragmentShader) {
+            deleteShader(vertexShader);
+            deleteShader(fragmentShader);
+            return 0;
+        }
 
         GLuint program = glCreateProgram();
         glAttachShader(program, vertexShader);
         glAttachShader(program, fragmentShader);
+        if (retrievableBinary && glProgramParameteri) {
+            glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        }
         glLinkProgram(program);
 
+        if (glDetachShader) {
+            glDetachShader(program, vertexShader);
+            glDetachShader(program, fragmentShader);
+        }
+        deleteShader(vertexShader);
+        deleteShader(fragmentShader);
+
         GLint success;
         glGetProgramiv(program, GL_LINK_STATUS, &success);
         if (!success) {
             char infoLog[512];
             glGetProgramInfoLog(program, 512, NULL, infoLog);
             std::cerr << "Erro no Link do Shader Program:\n" << infoLog << std::endl;
+            if (glDeleteProgram) {
+                glDeleteProgram(program);
+            }
             return 0;
         }
 
@@ -114,6 +366,12 @@ public:
     }
 
 private:
+    static void deleteShader(GLuint shader) {
+        if (shader && glDeleteShader) {
+            glDeleteShader(shader);
+        }
+    }
+
     static GLuint compileShader(GLenum type, const std::string& source) {
         GLuint shader = glCreateShader(type);
         const char* src = source.c_str();
@@ -126,14 +384,11 @@ private:
             char infoLog[512];
             glGetShaderInfoLog(shader, 512, NULL, infoLog);
             std::cerr << "Erro na Compilacao do Shader (" << (type == GL_VERTEX_SHADER ? "Vertex" : "Fragment") << "):\n" << infoLog << std::endl;
+            deleteShader(shader);
             return 0;
         }
         return shader;
     }
 };
 
-// Implementação das variáveis globais (deve estar em um .cpp, mas para simplificar header-only/inline ou definimos aqui se for unico)
-// Para evitar erro de linkagem multipla, vamos declarar como inline ou esperar que seja incluido apenas uma vez no main.
-// Melhor: definir em main.cpp ou criar shader_utils.cpp. Vamos criar shader_utils.cpp depois ou colocar as definições no main.
-
 #endif // SHADER_UTILS_H
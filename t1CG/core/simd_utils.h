@@ -0,0 +1,23 @@
+/**
+ * @file simd_utils.h
+ * @brief Detecção dos conjuntos de instruções SIMD disponíveis na compilação
+ * @author Sistema de Preenchimento ET/AET
+ * @date 2025
+ */
+
+#ifndef SIMD_UTILS_H
+#define SIMD_UTILS_H
+
+// AVX2 só é usado quando o compilador recebe -mavx2 (ou /arch:AVX2)
+#if defined(__AVX2__)
+#define CG_SIMD_AVX2 1
+#include <immintrin.h>
+#endif
+
+// SSE2 faz parte da base x86-64; em 32 bits depende de -msse2
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CG_SIMD_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#endif // SIMD_UTILS_H
@@ -0,0 +1,299 @@
+/**
+ * @file software_framebuffer.h
+ * @brief Framebuffer RGBA em memória (CPU) preenchido por spans e enviado como uma textura
+ * @author Sistema de Preenchimento ET/AET
+ * @date 2025
+ */
+
+#ifndef SOFTWARE_FRAMEBUFFER_H
+#define SOFTWARE_FRAMEBUFFER_H
+
+#include "data_structures.h"
+#include "simd_utils.h"
+#include "render_counters.h"
+#include <GL/gl.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+/**
+ * @brief Preenche count pixels RGBA de uma linha com a mesma cor
+ */
+inline void fillPixelRow(uint32_t* row, int count, uint32_t color) {
+    int index = 0;
+#if defined(CG_SIMD_SSE2)
+    const __m128i color4 = _mm_set1_epi32(static_cast<int>(color));
+    for (; index + 4 <= count; index += 4) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(row + index), color4);
+    }
+#endif
+    for (; index < count; ++index) {
+        row[index] = color;
+    }
+}
+
+/**
+ * @class SoftwareFramebuffer
+ * @brief Rasteriza spans em um buffer RGBA8 na CPU e sobe só as linhas alteradas para uma textura
+ */
+class SoftwareFramebuffer {
+private:
+    int width;
+    int height;
+    std::vector<uint32_t> pixels;
+
+    // Linhas com conteúdo (precisam ser limpas) e linhas alteradas desde o último upload
+    int contentMinY, contentMaxY;
+    int dirtyMinY, dirtyMaxY;
+
+    GLuint texture;
+    int textureWidth;
+    int textureHeight;
+
+    void markDirty(int minY, int maxY) {
+        dirtyMinY = std::min(dirtyMinY, minY);
+        dirtyMaxY = std::max(dirtyMaxY, maxY);
+    }
+
+public:
+    SoftwareFramebuffer()
+        : width(0), height(0),
+          contentMinY(0), contentMaxY(-1), dirtyMinY(0), dirtyMaxY(-1),
+          texture(0), textureWidth(0), textureHeight(0) {}
+
+    ~SoftwareFramebuffer() {
+        if (texture) {
+            glDeleteTextures(1, &texture);
+        }
+    }
+
+    SoftwareFramebuffer(const SoftwareFramebuffer&) = delete;
+    SoftwareFramebuffer& operator=(const SoftwareFramebuffer&) = delete;
+
+    /**
+     * @brief Empacota uma cor (0.0 - 1.0) em RGBA8, na ordem de bytes de GL_RGBA/GL_UNSIGNED_BYTE
+     */
+    static uint32_t packColor(const ColorRGB& color, float alpha = 1.0f) {
+        uint32_t r = static_cast<uint32_t>(std::min(std::max(color.redComponent, 0.0f), 1.0f) * 255.0f + 0.5f);
+        uint32_t g = static_cast<uint32_t>(std::min(std::max(color.greenComponent, 0.0f), 1.0f) * 255.0f + 0.5f);
+        uint32_t b = static_cast<uint32_t>(std::min(std::max(color.blueComponent, 0.0f), 1.0f) * 255.0f + 0.5f);
+        uint32_t a = static_cast<uint32_t>(std::min(std::max(alpha, 0.0f), 1.0f) * 255.0f + 0.5f);
+        return r | (g << 8) | (b << 16) | (a << 24);
+    }
+
+    /**
+     * @brief Redimensiona o buffer (descarta o conteúdo)
+     * @return true se o tamanho mudou
+     */
+    bool resize(int newWidth, int newHeight) {
+        if (newWidth == width && newHeight == height) {
+            return false;
+        }
+        width = std::max(newWidth, 0);
+        height = std::max(newHeight, 0);
+        pixels.assign(static_cast<size_t>(width) * height, 0u);
+        contentMinY = 0;
+        contentMaxY = -1;
+        markDirty(0, height - 1);
+        return true;
+    }
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    const uint32_t* getPixels() const { return pixels.data(); }
+
+    /**
+     * @brief Zera (transparente) apenas as linhas que receberam spans
+     */
+    void clear() {
+        if (contentMaxY < contentMinY) {
+            return;
+        }
+        std::memset(pixels.data() + static_cast<size_t>(contentMinY) * width, 0,
+                    static_cast<size_t>(contentMaxY - contentMinY + 1) * width * sizeof(uint32_t));
+        markDirty(contentMinY, contentMaxY);
+        contentMinY = 0;
+        contentMaxY = -1;
+    }
+
+    /**
+     * @brief Preenche um span [xStart, xEnd] (recortado aos limites do buffer)
+     */
+    void fillSpan(int y, int xStart, int xEnd, uint32_t color) {
+        if (y < 0 || y >= height) {
+            return;
+        }
+        xStart = std::max(xStart, 0);
+        xEnd = std::min(xEnd, width - 1);
+        if (xStart > xEnd) {
+            return;
+        }
+
+        fillPixelRow(pixels.data() + static_cast<size_t>(y) * width + xStart, xEnd - xStart + 1, color);
+
+        if (contentMaxY < contentMinY) {
+            contentMinY = contentMaxY = y;
+        } else {
+            contentMinY = std::min(contentMinY, y);
+            contentMaxY = std::max(contentMaxY, y);
+        }
+        markDirty(y, y);
+    }
+
+    /**
+     * @brief Escreve um span apenas nos pixels, sem atualizar o controle de linhas
+     *
+     * Seguro para chamar de várias threads desde que cada uma escreva em linhas
+     * distintas; depois do join, registre as linhas com markRowsWritten().
+     */
+    void writeSpan(int y, int xStart, int xEnd, uint32_t color) {
+        if (y < 0 || y >= height) {
+            return;
+        }
+        xStart = std::max(xStart, 0);
+        xEnd = std::min(xEnd, width - 1);
+        if (xStart > xEnd) {
+            return;
+        }
+        fillPixelRow(pixels.data() + static_cast<size_t>(y) * width + xStart, xEnd - xStart + 1, color);
+    }
+
+    /**
+     * @brief Registra as linhas [minY, maxY] escritas via writeSpan (conteúdo e upload)
+     */
+    void markRowsWritten(int minY, int maxY) {
+        minY = std::max(minY, 0);
+        maxY = std::min(maxY, height - 1);
+        if (minY > maxY) {
+            return;
+        }
+        if (contentMaxY < contentMinY) {
+            contentMinY = minY;
+            contentMaxY = maxY;
+        } else {
+            contentMinY = std::min(contentMinY, minY);
+            contentMaxY = std::max(contentMaxY, maxY);
+        }
+        markDirty(minY, maxY);
+    }
+
+    /**
+     * @brief Preenche uma lista de spans com uma cor
+     */
+    void fillSpans(const SpanList& spans, uint32_t color) {
+        for (const Span& span : spans) {
+            fillSpan(span.y, span.xStart, span.xEnd, color);
+        }
+    }
+
+    /**
+     * @brief Envia para a textura somente as linhas alteradas desde o último upload
+     */
+    void upload() {
+        if (width == 0 || height == 0) {
+            return;
+        }
+
+        if (!texture) {
+            glGenTextures(1, &texture);
+        }
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+        if (textureWidth != width || textureHeight != height) {
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+            textureWidth = width;
+            textureHeight = height;
+        } else if (dirtyMaxY >= dirtyMinY) {
+            int firstRow = std::max(dirtyMinY, 0);
+            int lastRow = std::min(dirtyMaxY, height - 1);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, firstRow, width, lastRow - firstRow + 1,
+                            GL_RGBA, GL_UNSIGNED_BYTE, pixels.data() + static_cast<size_t>(firstRow) * width);
+        }
+
+        glBindTexture(GL_TEXTURE_2D, 0);
+        dirtyMinY = height;
+        dirtyMaxY = -1;
+    }
+
+    /**
+     * @brief Desenha a textura como um único quad cobrindo (0, 0) - (width, height)
+     *
+     * Espera a projeção 2D do editor (glOrtho com Y para baixo), de modo que a
+     * linha 0 do buffer caia na scanline 0.
+     */
+    void draw() const {
+        if (!texture) {
+            return;
+        }
+
+        GLboolean wasBlendEnabled = glIsEnabled(GL_BLEND);
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        glEnable(GL_TEXTURE_2D);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+
+        RenderCounters::add(RenderCounter::IMMEDIATE_BLOCKS);
+        RenderCounters::add(RenderCounter::TRIANGLES, 2);
+        glBegin(GL_QUADS);
+            glTexCoord2f(0.0f, 0.0f); glVertex2i(0, 0);
+            glTexCoord2f(1.0f, 0.0f); glVertex2i(width, 0);
+            glTexCoord2f(1.0f, 1.0f); glVertex2i(width, height);
+            glTexCoord2f(0.0f, 1.0f); glVertex2i(0, height);
+        glEnd();
+
+        glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glDisable(GL_TEXTURE_2D);
+        if (!wasBlendEnabled) {
+            glDisable(GL_BLEND);
+        }
+    }
+};
+
+/**
+ * @brief Sink do laço ET/AET que preenche direto no framebuffer, sem SpanList intermediária
+ */
+class FramebufferSpanSink {
+private:
+    SoftwareFramebuffer& framebuffer;
+    uint32_t color;
+
+public:
+    FramebufferSpanSink(SoftwareFramebuffer& target, uint32_t fillColor) : framebuffer(target), color(fillColor) {}
+
+    void span(int y, int xStart, int xEnd) {
+        framebuffer.fillSpan(y, xStart, xEnd, color);
+    }
+};
+
+/**
+ * @brief Variante para as threads de faixa: usa writeSpan e guarda as linhas tocadas
+ *
+ * Ao fim da faixa, passe [writtenMinY, writtenMaxY] para markRowsWritten() após o join.
+ */
+class FramebufferBandSink {
+private:
+    SoftwareFramebuffer& framebuffer;
+
+public:
+    uint32_t color;
+    int writtenMinY;
+    int writtenMaxY;
+
+    explicit FramebufferBandSink(SoftwareFramebuffer& target)
+        : framebuffer(target), color(0), writtenMinY(std::numeric_limits<int>::max()), writtenMaxY(-1) {}
+
+    void span(int y, int xStart, int xEnd) {
+        framebuffer.writeSpan(y, xStart, xEnd, color);
+        writtenMinY = std::min(writtenMinY, y);
+        writtenMaxY = std::max(writtenMaxY, y);
+    }
+};
+
+#endif // SOFTWARE_FRAMEBUFFER_H
@@ -0,0 +1,128 @@
+/**
+ * @file spatial_grid.h
+ * @brief Grade uniforme para consultas espaciais 2D (picking na UI e no editor)
+ * @author Sistema de Computação Gráfica
+ * @date 2025
+ */
+
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+/**
+ * @class UniformGrid
+ * @brief Células quadradas de tamanho fixo sobre um retângulo, cada uma com a lista de entradas que a tocam
+ *
+ * Uma entrada é registrada em todas as células que sua caixa envolvente
+ * cobre; consultas olham só as células em volta do ponto, então o custo
+ * independe do total de entradas enquanto elas estiverem espalhadas.
+ * Coordenadas fora do retângulo caem nas células da borda.
+ *
+ * @tparam Entry Tipo copiável guardado nas células (índices, pares de índices)
+ */
+template <typename Entry>
+class UniformGrid {
+private:
+    float originX, originY;
+    float cellSize;
+    int columns, rows;
+    std::vector<std::vector<Entry>> cells;
+
+    int columnOf(float x) const {
+        int column = static_cast<int>(std::floor((x - originX) / cellSize));
+        return std::min(std::max(column, 0), columns - 1);
+    }
+
+    int rowOf(float y) const {
+        int row = static_cast<int>(std::floor((y - originY) / cellSize));
+        return std::min(std::max(row, 0), rows - 1);
+    }
+
+public:
+    UniformGrid() : originX(0.0f), originY(0.0f), cellSize(1.0f), columns(1), rows(1), cells(1) {}
+
+    /**
+     * @brief Esvazia a grade e redefine a área coberta
+     * @param x Canto da área
+     * @param y Canto da área
+     * @param width Largura da área
+     * @param height Altura da área
+     * @param size Lado de cada célula
+     */
+    void reset(float x, float y, float width, float height, float size) {
+        originX = x;
+        originY = y;
+        cellSize = size > 0.0f ? size : 1.0f;
+        columns = std::max(1, static_cast<int>(std::ceil(width / cellSize)));
+        rows = std::max(1, static_cast<int>(std::ceil(height / cellSize)));
+        cells.assign(static_cast<size_t>(columns) * rows, std::vector<Entry>());
+    }
+
+    /**
+     * @brief Esvazia as células mantendo a área e a capacidade
+     */
+    void clear() {
+        for (auto& cell : cells) {
+            cell.clear();
+        }
+    }
+
+    void insert(const Entry& entry, float minX, float minY, float maxX, float maxY) {
+        int firstColumn = columnOf(minX), lastColumn = columnOf(maxX);
+        int firstRow = rowOf(minY), lastRow = rowOf(maxY);
+        for (int row = firstRow; row <= lastRow; row++) {
+            for (int column = firstColumn; column <= lastColumn; column++) {
+                cells[static_cast<size_t>(row) * columns + column].push_back(entry);
+            }
+        }
+    }
+
+    void insertPoint(const Entry& entry, float x, float y) {
+        cells[static_cast<size_t>(rowOf(y)) * columns + columnOf(x)].push_back(entry);
+    }
+
+    /**
+     * @brief Remove de todas as células cobertas pela caixa as entradas que satisfazem o predicado
+     */
+    template <typename Predicate>
+    void removeIf(float minX, float minY, float maxX, float maxY, Predicate predicate) {
+        int firstColumn = columnOf(minX), lastColumn = columnOf(maxX);
+        int firstRow = rowOf(minY), lastRow = rowOf(maxY);
+        for (int row = firstRow; row <= lastRow; row++) {
+            for (int column = firstColumn; column <= lastColumn; column++) {
+                std::vector<Entry>& cell = cells[static_cast<size_t>(row) * columns + column];
+                cell.erase(std::remove_if(cell.begin(), cell.end(), predicate), cell.end());
+            }
+        }
+    }
+
+    /**
+     * @brief Entradas da célula que contém o ponto
+     */
+    const std::vector<Entry>& cellAt(float x, float y) const {
+        return cells[static_cast<size_t>(rowOf(y)) * columns + columnOf(x)];
+    }
+
+    /**
+     * @brief Visita as entradas das células que tocam o quadrado de lado 2·radius em torno do ponto
+     *
+     * Uma entrada que ocupa várias células pode ser visitada mais de uma vez.
+     */
+    template <typename Visitor>
+    void forEachNear(float x, float y, float radius, Visitor visit) const {
+        int firstColumn = columnOf(x - radius), lastColumn = columnOf(x + radius);
+        int firstRow = rowOf(y - radius), lastRow = rowOf(y + radius);
+        for (int row = firstRow; row <= lastRow; row++) {
+            for (int column = firstColumn; column <= lastColumn; column++) {
+                for (const Entry& entry : cells[static_cast<size_t>(row) * columns + column]) {
+                    visit(entry);
+                }
+            }
+        }
+    }
+};
+
+#endif // SPATIAL_GRID_H
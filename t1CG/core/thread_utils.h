@@ -0,0 +1,64 @@
+/**
+ * @file thread_utils.h
+ * @brief Utilitários simples de paralelismo (std::thread) para os laços da CPU
+ * @author Sistema de Preenchimento ET/AET
+ * @date 2025
+ */
+
+#ifndef THREAD_UTILS_H
+#define THREAD_UTILS_H
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Número de threads de trabalho a usar (ao menos 1)
+ */
+inline unsigned getWorkerThreadCount() {
+    unsigned hardwareThreads = std::thread::hardware_concurrency();
+    return hardwareThreads == 0 ? 1u : hardwareThreads;
+}
+
+/**
+ * @brief Executa task(i) para i em [0, taskCount), distribuindo as tarefas entre threads
+ * @param taskCount Número de tarefas independentes
+ * @param task Função chamada com o índice da tarefa; deve ser segura para threads
+ *
+ * As tarefas são retiradas de um contador atômico; a thread chamadora também
+ * trabalha e a função só retorna quando todas tiverem terminado.
+ */
+template <typename Task>
+void parallelFor(size_t taskCount, const Task& task) {
+    if (taskCount == 0) {
+        return;
+    }
+
+    size_t threadCount = std::min<size_t>(getWorkerThreadCount(), taskCount);
+    if (threadCount <= 1) {
+        for (size_t taskIndex = 0; taskIndex < taskCount; ++taskIndex) {
+            task(taskIndex);
+        }
+        return;
+    }
+
+    std::atomic<size_t> nextTask(0);
+    auto worker = [&]() {
+        for (size_t taskIndex = nextTask++; taskIndex < taskCount; taskIndex = nextTask++) {
+            task(taskIndex);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+    for (size_t threadIndex = 1; threadIndex < threadCount; ++threadIndex) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+#endif // THREAD_UTILS_H
@@ -9,9 +9,11 @@
 #define UI_BUTTON_H
 
 #include "ui_primitives.h"
+#include "ui_draw_list.h"
 #include "ui_theme.h"
 #include <string>
 #include <functional>
+#include <cmath>
 #include <GL/glut.h>
 
 using namespace UIPrimitives;
@@ -57,6 +59,12 @@ public:
     // Ícone (opcional)
     enum class IconType { NONE, CUBE, SPHERE, PYRAMID, CYLINDER, SUN };
     IconType icon;
+
+private:
+    // Largura do label em pixels, medida no primeiro render (-1: ainda não medida)
+    mutable int labelWidth;
+
+public:
     
     /**
      * @brief Construtor
@@ -70,7 +78,7 @@ public:
           activeColor(DarkTheme::buttonActive),
           currentColor(DarkTheme::buttonBase),
           isHovered(false), isPressed(false), isActive(false), isEnabled(true),
-          type(btnType), radioGroupId(radioGroup), icon(IconType::NONE) {
+          type(btnType), radioGroupId(radioGroup), icon(IconType::NONE), labelWidth(-1) {
     }
     
     /**
@@ -85,12 +93,10 @@ public:
     /**
      * @brief Atualiza o estado de hover
      */
-    void updateHover(int mouseX, int mouseY) {
-        if (!isEnabled) {
-            isHovered = false;
-            return;
-        }
-        isHovered = containsPoint(mouseX, mouseY);
+    bool updateHover(int mouseX, int mouseY) {
+        bool wasHovered = isHovered;
+        isHovered = isEnabled && containsPoint(mouseX, mouseY);
+        return isHovered != wasHovered;
     }
     
     /**
@@ -123,49 +129,68 @@ public:
     /**
      * @brief Libera o botão pressionado
      */
-    void releasePress() {
+    bool releasePress() {
+        bool wasPressed = isPressed;
         isPressed = false;
+        return wasPressed;
     }
-    
+
     /**
-     * @brief Atualiza a cor com interpolação suave
+     * @brief Cor para a qual o botão está transicionando no estado atual
      */
-    void update(float deltaTime = 0.016f) {
-        ColorRGBA targetColor;
-        
+    ColorRGBA getTargetColor() const {
         if (!isEnabled) {
-            targetColor = DarkTheme::buttonDisabled;
+            return DarkTheme::buttonDisabled;
         } else if (isPressed) {
-            targetColor = activeColor;
+            return activeColor;
         } else if (isActive) {
-            targetColor = activeColor;
+            return activeColor;
         } else if (isHovered) {
-            targetColor = hoverColor;
-        } else {
-            targetColor = baseColor;
+            return hoverColor;
         }
+        return baseColor;
+    }
+
+    /**
+     * @brief Indica se a cor ainda não chegou ao alvo (precisa de mais frames)
+     */
+    bool isAnimating() const {
+        ColorRGBA targetColor = getTargetColor();
+        const float epsilon = 1.0f / 512.0f;
+        return std::fabs(currentColor.r - targetColor.r) > epsilon || std::fabs(currentColor.g - targetColor.g) > epsilon ||
+               std::fabs(currentColor.b - targetColor.b) > epsilon || std::fabs(currentColor.a - targetColor.a) > epsilon;
+    }
+    
+    /**
+     * @brief Atualiza a cor com interpolação suave
+     */
+    void update(float deltaTime = 0.016f) {
+        ColorRGBA targetColor = getTargetColor();
         
-        // Interpolação suave
+        // Interpolação suave; abaixo de meio nível de cor, encaixa no alvo e a animação termina
         float lerpFactor = Animation::hoverTransitionSpeed;
         currentColor = currentColor.lerp(targetColor, lerpFactor);
+        if (!isAnimating()) {
+            currentColor = targetColor;
+        }
     }
     
     /**
-     * @brief Renderiza o botão
+     * @brief Acrescenta o botão à lista de desenho do painel
      */
-    void render() const {
+    void render(UIDrawList& drawList) const {
         // Sombra (opcional)
         if (isEnabled && (isHovered || isActive)) {
-            drawShadow(x, y, width, height, Typography::borderRadius, 3.0f);
+            drawList.addShadow(x, y, width, height, Typography::borderRadius, 3.0f);
         }
         
         // Corpo do botão
-        drawRoundedRect(x, y, width, height, Typography::borderRadius, currentColor);
+        drawList.addRoundedRect(x, y, width, height, Typography::borderRadius, currentColor);
         
         // Borda (se ativo)
         if (isActive && isEnabled) {
-            drawRoundedRectOutline(x, y, width, height, Typography::borderRadius,
-                                  DarkTheme::accentBlue, 2.0f);
+            drawList.addRoundedRectOutline(x, y, width, height, Typography::borderRadius,
+                                           DarkTheme::accentBlue, 2.0f);
         }
         
         // Ícone (se houver)
@@ -177,19 +202,19 @@ public:
             
             switch (icon) {
                 case IconType::CUBE:
-                    drawCubeIcon(iconX, iconY, iconSize, iconColor);
+                    drawList.addCubeIcon(iconX, iconY, iconSize, iconColor);
                     break;
                 case IconType::SPHERE:
-                    drawSphereIcon(iconX, iconY, iconSize, iconColor);
+                    drawList.addSphereIcon(iconX, iconY, iconSize, iconColor);
                     break;
                 case IconType::PYRAMID:
-                    drawPyramidIcon(iconX, iconY, iconSize, iconColor);
+                    drawList.addPyramidIcon(iconX, iconY, iconSize, iconColor);
                     break;
                 case IconType::CYLINDER:
-                    drawCylinderIcon(iconX, iconY, iconSize, iconColor);
+                    drawList.addCylinderIcon(iconX, iconY, iconSize, iconColor);
                     break;
                 case IconType::SUN:
-                    drawSunIcon(iconX, iconY, iconSize, iconColor);
+                    drawList.addSunIcon(iconX, iconY, iconSize, iconColor);
                     break;
                 default:
                     break;
@@ -198,10 +223,20 @@ public:
         
         // Texto (renderização simplificada com GLUT)
         if (!label.empty()) {
-            renderText();
+            renderText(drawList);
         }
     }
     
+    /**
+     * @brief Troca o texto do botão (invalida a largura medida)
+     */
+    void setLabel(const std::string& text) {
+        if (label != text) {
+            label = text;
+            labelWidth = -1;
+        }
+    }
+
     /**
      * @brief Define o ícone do botão
      */
@@ -236,18 +271,17 @@ public:
 
 private:
     /**
-     * @brief Renderiza texto usando bitmap do GLUT
+     * @brief Acrescenta o texto à lista de desenho
      */
-    void renderText() const {
+    void renderText(UIDrawList& drawList) const {
         ColorRGBA textColor = isEnabled ? DarkTheme::textPrimary : DarkTheme::textDisabled;
-        glColor4f(textColor.r, textColor.g, textColor.b, textColor.a);
         
-        // Fonte e cálculo de largura do texto
+        // Fonte e largura do texto (medida uma vez por label)
         void* font = GLUT_BITMAP_HELVETICA_12;
-        int textWidth = 0;
-        for (char c : label) {
-            textWidth += glutBitmapWidth(font, c);
+        if (labelWidth < 0) {
+            labelWidth = UIDrawList::measureText(label, font);
         }
+        int textWidth = labelWidth;
         
         // Calcula posição do texto
         float textX, textY;
@@ -264,10 +298,7 @@ private:
             textX = x + (width - textWidth) * 0.5f;
         }
         
-        glRasterPos2f(textX, textY);
-        for (char c : label) {
-            glutBitmapCharacter(font, c);
-        }
+        drawList.addText(textX, textY, label, textColor, font);
     }
 };
 
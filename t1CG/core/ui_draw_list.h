@@ -0,0 +1,475 @@
+/**
+ * @file ui_draw_list.h
+ * @brief Lista de desenho 2D da UI: toda a geometria do painel em um único buffer por frame
+ * @author Sistema de UI OpenGL
+ * @date 2025
+ */
+
+#ifndef UI_DRAW_LIST_H
+#define UI_DRAW_LIST_H
+
+#include "ui_primitives.h"
+#include "ui_glyph_atlas.h"
+#include "shader_utils.h"
+#include "render_counters.h"
+#include <GL/glut.h>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace UIPrimitives {
+
+/**
+ * @brief Vértice intercalado da lista de desenho (posição + coordenada no atlas + cor)
+ */
+struct UIVertex {
+    GLfloat x, y;
+    GLfloat u, v;
+    GLfloat r, g, b, a;
+};
+
+/**
+ * @class UIDrawList
+ * @brief Acumula retângulos, cantos arredondados, círculos, linhas e ícones como triângulos
+ *
+ * As primitivas de ui_primitives.h abrem vários glBegin por botão e recalculam
+ * seno e cosseno a cada frame. Aqui cada forma vira triângulos em um vetor que
+ * é reaproveitado entre frames, e flush() envia tudo em um glBufferData e um
+ * glDrawArrays. Linhas viram quads da espessura pedida, então glLineWidth não
+ * separa o lote. Textos viram quads do atlas de glifos (UIGlyphAtlas) no mesmo
+ * lote, e a geometria amostra a célula branca do atlas; sem atlas, os textos
+ * ficam numa fila à parte desenhada com glutBitmapCharacter depois da geometria.
+ *
+ * Todos os arcos usam a mesma tabela de CIRCLE_SEGMENTS passos: um canto é um
+ * quarto dela (10 segmentos, como drawRoundedRect) e um arco de 180° é metade.
+ */
+class UIDrawList {
+public:
+    static const int CIRCLE_SEGMENTS = 40;
+
+private:
+    struct TextCommand {
+        float x, y;
+        ColorRGBA color;
+        std::string text;
+        void* font;
+    };
+
+    struct Point {
+        float x, y;
+    };
+
+    std::vector<UIVertex> vertices;
+    std::vector<TextCommand> texts;
+    std::vector<Point> outerContour;  // Reaproveitados entre formas
+    std::vector<Point> innerContour;
+    GLuint vertexBuffer;
+    bool textured;         // Atlas pronto: lote com textura, textos como quads
+    float solidU, solidV;  // Texel branco do atlas, usado por toda a geometria
+
+    /**
+     * @brief Cosseno e seno de 2π·i/CIRCLE_SEGMENTS, i em [0, CIRCLE_SEGMENTS], calculados uma vez
+     */
+    static const Point* unitCircle() {
+        static Point table[CIRCLE_SEGMENTS + 1];
+        static bool built = false;
+        if (!built) {
+            for (int i = 0; i <= CIRCLE_SEGMENTS; i++) {
+                double angle = 2.0 * M_PI * i / CIRCLE_SEGMENTS;
+                table[i].x = static_cast<float>(std::cos(angle));
+                table[i].y = static_cast<float>(std::sin(angle));
+            }
+            built = true;
+        }
+        return table;
+    }
+
+    void pushVertex(float x, float y, const ColorRGBA& color) {
+        UIVertex vertex = { x, y, solidU, solidV, color.r, color.g, color.b, color.a };
+        vertices.push_back(vertex);
+    }
+
+    void pushTexturedVertex(float x, float y, float u, float v, const ColorRGBA& color) {
+        UIVertex vertex = { x, y, u, v, color.r, color.g, color.b, color.a };
+        vertices.push_back(vertex);
+    }
+
+    void pushTriangle(float x0, float y0, float x1, float y1, float x2, float y2, const ColorRGBA& color) {
+        pushVertex(x0, y0, color);
+        pushVertex(x1, y1, color);
+        pushVertex(x2, y2, color);
+    }
+
+    /**
+     * @brief Contorno fechado de um retângulo arredondado com os cantos deslocados de offset
+     *
+     * Começa no canto superior esquerdo (ângulo π) e segue no sentido de
+     * drawRoundedRectOutline; os centros dos cantos não mudam com o offset,
+     * então contornos com offsets diferentes são paralelos ponto a ponto.
+     */
+    static void buildRoundedContour(float x, float y, float width, float height, float radius,
+                                    float offset, std::vector<Point>& contour) {
+        const Point* circle = unitCircle();
+        const int quarter = CIRCLE_SEGMENTS / 4;
+        const float centerX[4] = { x + radius, x + width - radius, x + width - radius, x + radius };
+        const float centerY[4] = { y + radius, y + radius, y + height - radius, y + height - radius };
+        float cornerRadius = radius + offset;
+        if (cornerRadius < 0.0f) cornerRadius = 0.0f;
+
+        contour.clear();
+        for (int corner = 0; corner < 4; corner++) {
+            for (int i = 0; i <= quarter; i++) {
+                const Point& direction = circle[(2 * quarter + corner * quarter + i) % CIRCLE_SEGMENTS];
+                Point point = { centerX[corner] + cornerRadius * direction.x,
+                                centerY[corner] + cornerRadius * direction.y };
+                contour.push_back(point);
+            }
+        }
+    }
+
+    /**
+     * @brief Faixa de triângulos entre dois contornos fechados com o mesmo número de pontos
+     */
+    void addRing(const std::vector<Point>& outer, const std::vector<Point>& inner, const ColorRGBA& color) {
+        size_t count = outer.size();
+        for (size_t i = 0; i < count; i++) {
+            size_t next = (i + 1) % count;
+            pushTriangle(outer[i].x, outer[i].y, outer[next].x, outer[next].y, inner[i].x, inner[i].y, color);
+            pushTriangle(inner[i].x, inner[i].y, outer[next].x, outer[next].y, inner[next].x, inner[next].y, color);
+        }
+    }
+
+    /**
+     * @brief Arco de elipse como sequência de linhas, com passo de um índice da tabela
+     * @param firstIndex Índice inicial na tabela (ângulo 2π·firstIndex/CIRCLE_SEGMENTS)
+     * @param steps Quantidade de segmentos
+     */
+    void addEllipseArc(float centerX, float centerY, float radiusX, float radiusY,
+                       int firstIndex, int steps, const ColorRGBA& color, float lineWidth) {
+        const Point* circle = unitCircle();
+        for (int i = 0; i < steps; i++) {
+            const Point& from = circle[(firstIndex + i + CIRCLE_SEGMENTS) % CIRCLE_SEGMENTS];
+            const Point& to = circle[(firstIndex + i + 1 + CIRCLE_SEGMENTS) % CIRCLE_SEGMENTS];
+            addLine(centerX + radiusX * from.x, centerY + radiusY * from.y,
+                    centerX + radiusX * to.x, centerY + radiusY * to.y, color, lineWidth);
+        }
+    }
+
+public:
+    UIDrawList() : vertexBuffer(0), textured(false), solidU(0.0f), solidV(0.0f) {}
+
+    ~UIDrawList() {
+        if (vertexBuffer && ShaderUtils::hasBufferObjects()) {
+            glDeleteBuffers(1, &vertexBuffer);
+        }
+    }
+
+    UIDrawList(const UIDrawList&) = delete;
+    UIDrawList& operator=(const UIDrawList&) = delete;
+
+    /**
+     * @brief Esvazia a lista mantendo a capacidade alocada
+     */
+    void clear() {
+        vertices.clear();
+        texts.clear();
+    }
+
+    /**
+     * @brief Começa um frame: esvazia a lista e monta o atlas de glifos na primeira vez
+     */
+    void begin() {
+        clear();
+        UIGlyphAtlas& atlas = UIGlyphAtlas::getInstance();
+        textured = atlas.ensureBuilt();
+        solidU = atlas.getSolidU();
+        solidV = atlas.getSolidV();
+    }
+
+    size_t getVertexCount() const { return vertices.size(); }
+
+    void addRect(float x, float y, float width, float height, const ColorRGBA& color) {
+        pushTriangle(x, y, x + width, y, x + width, y + height, color);
+        pushTriangle(x, y, x + width, y + height, x, y + height, color);
+    }
+
+    /**
+     * @brief Equivalente a drawRoundedRect: leque convexo a partir do centro do retângulo
+     */
+    void addRoundedRect(float x, float y, float width, float height, float radius, const ColorRGBA& color) {
+        float maxRadius = (width < height ? width : height) * 0.5f;
+        if (radius > maxRadius) radius = maxRadius;
+        if (radius <= 0.0f) {
+            addRect(x, y, width, height, color);
+            return;
+        }
+
+        buildRoundedContour(x, y, width, height, radius, 0.0f, outerContour);
+        float centerX = x + width * 0.5f;
+        float centerY = y + height * 0.5f;
+        size_t count = outerContour.size();
+        for (size_t i = 0; i < count; i++) {
+            const Point& from = outerContour[i];
+            const Point& to = outerContour[(i + 1) % count];
+            pushTriangle(centerX, centerY, from.x, from.y, to.x, to.y, color);
+        }
+    }
+
+    /**
+     * @brief Equivalente a drawRoundedRectOutline: anel de espessura lineWidth centrado no contorno
+     */
+    void addRoundedRectOutline(float x, float y, float width, float height, float radius,
+                               const ColorRGBA& color, float lineWidth = 2.0f) {
+        float maxRadius = (width < height ? width : height) * 0.5f;
+        if (radius > maxRadius) radius = maxRadius;
+        if (radius < 0.0f) radius = 0.0f;
+
+        float halfWidth = lineWidth * 0.5f;
+        buildRoundedContour(x, y, width, height, radius, halfWidth, outerContour);
+        buildRoundedContour(x, y, width, height, radius, -halfWidth, innerContour);
+        addRing(outerContour, innerContour, color);
+    }
+
+    /**
+     * @brief Equivalente a drawShadow
+     */
+    void addShadow(float x, float y, float width, float height, float radius, float shadowOffset = 4.0f) {
+        addRoundedRect(x + shadowOffset, y + shadowOffset, width, height, radius, ColorRGBA(0.0f, 0.0f, 0.0f, 0.3f));
+    }
+
+    void addCircle(float centerX, float centerY, float radius, const ColorRGBA& color) {
+        const Point* circle = unitCircle();
+        for (int i = 0; i < CIRCLE_SEGMENTS; i++) {
+            pushTriangle(centerX, centerY,
+                         centerX + radius * circle[i].x, centerY + radius * circle[i].y,
+                         centerX + radius * circle[i + 1].x, centerY + radius * circle[i + 1].y, color);
+        }
+    }
+
+    void addCircleOutline(float centerX, float centerY, float radius, const ColorRGBA& color, float lineWidth = 2.0f) {
+        const Point* circle = unitCircle();
+        float outerRadius = radius + lineWidth * 0.5f;
+        float innerRadius = radius - lineWidth * 0.5f;
+        if (innerRadius < 0.0f) innerRadius = 0.0f;
+
+        outerContour.clear();
+        innerContour.clear();
+        for (int i = 0; i < CIRCLE_SEGMENTS; i++) {
+            Point outer = { centerX + outerRadius * circle[i].x, centerY + outerRadius * circle[i].y };
+            Point inner = { centerX + innerRadius * circle[i].x, centerY + innerRadius * circle[i].y };
+            outerContour.push_back(outer);
+            innerContour.push_back(inner);
+        }
+        addRing(outerContour, innerContour, color);
+    }
+
+    /**
+     * @brief Segmento de reta como um quad de espessura lineWidth
+     */
+    void addLine(float x0, float y0, float x1, float y1, const ColorRGBA& color, float lineWidth = 1.0f) {
+        float dx = x1 - x0;
+        float dy = y1 - y0;
+        float length = std::sqrt(dx * dx + dy * dy);
+        if (length <= 0.0f) {
+            return;
+        }
+        float nx = -dy / length * lineWidth * 0.5f;
+        float ny = dx / length * lineWidth * 0.5f;
+        pushTriangle(x0 + nx, y0 + ny, x1 + nx, y1 + ny, x1 - nx, y1 - ny, color);
+        pushTriangle(x0 + nx, y0 + ny, x1 - nx, y1 - ny, x0 - nx, y0 - ny, color);
+    }
+
+    /**
+     * @brief Contorno fechado por uma lista de pontos (x0, y0, x1, y1, ...)
+     */
+    void addLineLoop(const float* coordinates, int pointCount, const ColorRGBA& color, float lineWidth) {
+        for (int i = 0; i < pointCount; i++) {
+            int next = (i + 1) % pointCount;
+            addLine(coordinates[2 * i], coordinates[2 * i + 1],
+                    coordinates[2 * next], coordinates[2 * next + 1], color, lineWidth);
+        }
+    }
+
+    // === Ícones (mesmo desenho das funções draw*Icon de ui_primitives.h) ===
+
+    void addCubeIcon(float centerX, float centerY, float size, const ColorRGBA& color) {
+        float hs = size * 0.5f;
+        float offset = size * 0.2f;
+
+        const float front[] = { centerX - hs, centerY - hs,   centerX + hs, centerY - hs,
+                                centerX + hs, centerY + hs,   centerX - hs, centerY + hs };
+        addLineLoop(front, 4, color, 2.0f);
+
+        const float back[] = { front[0] + offset, front[1] - offset,   front[2] + offset, front[3] - offset,
+                               front[4] + offset, front[5] - offset,   front[6] + offset, front[7] - offset };
+        addLineLoop(back, 4, color, 2.0f);
+
+        for (int i = 0; i < 4; i++) {
+            addLine(front[2 * i], front[2 * i + 1], back[2 * i], back[2 * i + 1], color, 2.0f);
+        }
+    }
+
+    void addSphereIcon(float centerX, float centerY, float size, const ColorRGBA& color) {
+        float radius = size * 0.5f;
+        addCircleOutline(centerX, centerY, radius, color, 2.0f);
+
+        // Equador e meridiano a meia opacidade
+        ColorRGBA faded(color.r, color.g, color.b, color.a * 0.5f);
+        addLine(centerX - radius, centerY, centerX + radius, centerY, faded, 1.0f);
+
+        // Meridiano: x = 0.3·r·sen(θ), y = -r·cos(θ) para θ em [0, π] é a meia elipse do índice -CIRCLE_SEGMENTS/4
+        addEllipseArc(centerX, centerY, radius * 0.3f, radius, -CIRCLE_SEGMENTS / 4, CIRCLE_SEGMENTS / 2, faded, 1.0f);
+    }
+
+    void addPyramidIcon(float centerX, float centerY, float size, const ColorRGBA& color) {
+        float hs = size * 0.5f;
+        const float base[] = { centerX - hs, centerY + hs,   centerX + hs, centerY + hs,
+                               centerX + hs * 0.7f, centerY + hs * 0.5f,   centerX - hs * 0.7f, centerY + hs * 0.5f };
+        addLineLoop(base, 4, color, 2.0f);
+
+        float topX = centerX;
+        float topY = centerY - hs;
+        addLine(base[0], base[1], topX, topY, color, 2.0f);
+        addLine(base[2], base[3], topX, topY, color, 2.0f);
+        addLine(base[6], base[7], topX, topY, color, 2.0f);
+    }
+
+    void addCylinderIcon(float centerX, float centerY, float size, const ColorRGBA& color) {
+        float radius = size * 0.35f;
+        float height = size * 0.8f;
+        float topY = centerY - height * 0.5f;
+        float bottomY = centerY + height * 0.5f;
+
+        // Metade de baixo da elipse superior e metade de cima da inferior
+        addEllipseArc(centerX, topY, radius, radius * 0.3f, 0, CIRCLE_SEGMENTS / 2, color, 2.0f);
+        addEllipseArc(centerX, bottomY, radius, radius * 0.3f, CIRCLE_SEGMENTS / 2, CIRCLE_SEGMENTS / 2, color, 2.0f);
+
+        addLine(centerX - radius, topY, centerX - radius, bottomY, color, 2.0f);
+        addLine(centerX + radius, topY, centerX + radius, bottomY, color, 2.0f);
+    }
+
+    void addSunIcon(float centerX, float centerY, float size, const ColorRGBA& color) {
+        const Point* circle = unitCircle();
+        float radius = size * 0.3f;
+        addCircle(centerX, centerY, radius, color);
+
+        for (int i = 0; i < 8; i++) {
+            const Point& direction = circle[i * CIRCLE_SEGMENTS / 8];
+            addLine(centerX + radius * 1.3f * direction.x, centerY + radius * 1.3f * direction.y,
+                    centerX + radius * 1.8f * direction.x, centerY + radius * 1.8f * direction.y, color, 2.0f);
+        }
+    }
+
+    /**
+     * @brief Texto com a caneta em (x, y) na linha de base, como glRasterPos2f
+     *
+     * Com o atlas, cada caractere vira um quad alinhado ao pixel onde glBitmap o
+     * poria; outras fontes (ou sem atlas) vão para a fila de glutBitmapCharacter.
+     */
+    void addText(float x, float y, const std::string& text, const ColorRGBA& color,
+                 void* font = GLUT_BITMAP_HELVETICA_12) {
+        const UIGlyphAtlas& atlas = UIGlyphAtlas::getInstance();
+        if (!textured || !atlas.supports(font)) {
+            TextCommand command = { x, y, color, text, font };
+            texts.push_back(command);
+            return;
+        }
+
+        // glBitmap usa floor da posição em janela; com Y invertido isso é ceil na linha de base
+        float penX = std::floor(x);
+        float baseline = std::ceil(y);
+        for (char c : text) {
+            const GlyphQuad& glyph = atlas.getGlyph(c);
+            if (c != ' ') {
+                float left = penX + glyph.offsetX;
+                float right = left + glyph.width;
+                float top = baseline - glyph.ascent;
+                float bottom = baseline + glyph.descent;
+                pushTexturedVertex(left, top, glyph.u0, glyph.v0, color);
+                pushTexturedVertex(right, top, glyph.u1, glyph.v0, color);
+                pushTexturedVertex(right, bottom, glyph.u1, glyph.v1, color);
+                pushTexturedVertex(left, top, glyph.u0, glyph.v0, color);
+                pushTexturedVertex(right, bottom, glyph.u1, glyph.v1, color);
+                pushTexturedVertex(left, bottom, glyph.u0, glyph.v1, color);
+            }
+            penX += glyph.advance;
+        }
+    }
+
+    /**
+     * @brief Largura de um texto, pela tabela do atlas quando a fonte é a dele
+     */
+    static int measureText(const std::string& text, void* font = GLUT_BITMAP_HELVETICA_12) {
+        return UIGlyphAtlas::getInstance().measure(text, font);
+    }
+
+    /**
+     * @brief Envia a geometria e os textos do atlas em um único draw; esvazia a lista
+     *
+     * Usa um VBO com GL_STREAM_DRAW quando há buffer objects e vertex arrays
+     * do cliente caso contrário. Textos sem atlas saem depois, via GLUT.
+     */
+    void flush() {
+        if (!vertices.empty()) {
+            const GLsizei stride = sizeof(UIVertex);
+            const GLvoid* positionOffset = reinterpret_cast<const GLvoid*>(0);
+            const GLvoid* texCoordOffset = reinterpret_cast<const GLvoid*>(2 * sizeof(GLfloat));
+            const GLvoid* colorOffset = reinterpret_cast<const GLvoid*>(4 * sizeof(GLfloat));
+            bool useBuffer = ShaderUtils::hasBufferObjects();
+
+            if (useBuffer) {
+                if (!vertexBuffer) {
+                    glGenBuffers(1, &vertexBuffer);
+                }
+                glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+                glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(UIVertex), vertices.data(), GL_STREAM_DRAW);
+            } else {
+                positionOffset = &vertices[0].x;
+                texCoordOffset = &vertices[0].u;
+                colorOffset = &vertices[0].r;
+            }
+
+            if (textured) {
+                glEnable(GL_TEXTURE_2D);
+                glBindTexture(GL_TEXTURE_2D, UIGlyphAtlas::getInstance().getTexture());
+                glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+                glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+                glTexCoordPointer(2, GL_FLOAT, stride, texCoordOffset);
+            }
+
+            glEnableClientState(GL_VERTEX_ARRAY);
+            glEnableClientState(GL_COLOR_ARRAY);
+            glVertexPointer(2, GL_FLOAT, stride, positionOffset);
+            glColorPointer(4, GL_FLOAT, stride, colorOffset);
+            glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(vertices.size()));
+            RenderCounters::add(RenderCounter::DRAW_CALLS);
+            RenderCounters::add(RenderCounter::TRIANGLES, vertices.size() / 3);
+            glDisableClientState(GL_COLOR_ARRAY);
+            glDisableClientState(GL_VERTEX_ARRAY);
+
+            if (textured) {
+                glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+                glBindTexture(GL_TEXTURE_2D, 0);
+                glDisable(GL_TEXTURE_2D);
+            }
+
+            if (useBuffer) {
+                glBindBuffer(GL_ARRAY_BUFFER, 0);
+            }
+        }
+
+        for (const TextCommand& command : texts) {
+            glColor4f(command.color.r, command.color.g, command.color.b, command.color.a);
+            glRasterPos2f(command.x, command.y);
+            for (char c : command.text) {
+                glutBitmapCharacter(command.font, c);
+            }
+        }
+
+        clear();
+    }
+};
+
+} // namespace UIPrimitives
+
+#endif // UI_DRAW_LIST_H
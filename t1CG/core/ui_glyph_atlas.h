@@ -0,0 +1,251 @@
+/**
+ * @file ui_glyph_atlas.h
+ * @brief Atlas de glifos da UI: a fonte bitmap do GLUT rasterizada uma vez em uma textura
+ * @author Sistema de UI OpenGL
+ * @date 2025
+ */
+
+#ifndef UI_GLYPH_ATLAS_H
+#define UI_GLYPH_ATLAS_H
+
+#include "shader_utils.h"
+#include <GL/glut.h>
+#include <cmath>
+#include <string>
+
+namespace UIPrimitives {
+
+/**
+ * @brief Retângulo de um glifo no atlas e onde ele cai em relação à caneta
+ *
+ * Coordenadas de tela com Y para baixo, como a projeção da UI: o quad vai de
+ * (penX + offsetX, baseline - ascent) a (penX + offsetX + width, baseline + descent).
+ */
+struct GlyphQuad {
+    float u0, v0, u1, v1;  // v0 na borda de cima do quad, v1 na de baixo
+    float offsetX;
+    float ascent, descent, width;
+    int advance;
+};
+
+/**
+ * @class UIGlyphAtlas
+ * @brief Os caracteres ASCII imprimíveis de GLUT_BITMAP_HELVETICA_12 em uma textura RGBA
+ *
+ * build() desenha cada caractere com glutBitmapCharacter, uma única vez, em
+ * uma célula de uma textura presa a um FBO. Daí em diante um texto é só uma
+ * sequência de quads texturizados que entram no mesmo lote da geometria do
+ * painel (UIDrawList). Uma célula fica toda branca: a geometria sem texto
+ * amostra esse texel, e assim tudo sai em um único draw com textura ligada.
+ *
+ * As larguras de avanço são lidas de glutBitmapWidth no build e guardadas, o que
+ * também torna measure() uma soma em tabela.
+ */
+class UIGlyphAtlas {
+public:
+    static const int FIRST_CHARACTER = 32;
+    static const int CHARACTER_COUNT = 95;          // ' ' .. '~'
+    static const int CELL_SIZE = 16;
+    static const int CELL_MARGIN = 2;               // Folga à esquerda para glifos com xorig negativo
+    static const int CELL_DESCENT = 4;              // Linha de base a 4 pixels da base da célula
+    static const int ATLAS_COLUMNS = 16;
+    static const int ATLAS_WIDTH = 256;
+    static const int ATLAS_HEIGHT = 128;
+
+private:
+    void* font;
+    GLuint texture;
+    bool built;
+    bool buildFailed;
+    int advances[CHARACTER_COUNT];
+    GlyphQuad glyphs[CHARACTER_COUNT];
+    float solidU, solidV;
+
+    UIGlyphAtlas()
+        : font(GLUT_BITMAP_HELVETICA_12), texture(0), built(false), buildFailed(false),
+          solidU(0.0f), solidV(0.0f) {
+        for (int i = 0; i < CHARACTER_COUNT; i++) {
+            advances[i] = 0;
+        }
+    }
+
+    static void cellOrigin(int cell, int& cellX, int& cellY) {
+        cellX = (cell % ATLAS_COLUMNS) * CELL_SIZE;
+        cellY = (cell / ATLAS_COLUMNS) * CELL_SIZE;
+    }
+
+    /**
+     * @brief Rasteriza os glifos e a célula branca no atlas (contexto atual, FBO disponível)
+     */
+    bool rasterize() {
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, ATLAS_WIDTH, ATLAS_HEIGHT, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        GLint previousFramebuffer = 0;
+        glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+
+        GLuint framebuffer = 0;
+        glGenFramebuffers(1, &framebuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+        bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+
+        if (complete) {
+            glPushAttrib(GL_VIEWPORT_BIT | GL_COLOR_BUFFER_BIT | GL_ENABLE_BIT | GL_CURRENT_BIT);
+            glDisable(GL_BLEND);
+            glDisable(GL_TEXTURE_2D);
+            glDisable(GL_LIGHTING);
+            glDisable(GL_DEPTH_TEST);
+            glDisable(GL_SCISSOR_TEST);
+            glDisable(GL_POLYGON_SMOOTH);
+            glViewport(0, 0, ATLAS_WIDTH, ATLAS_HEIGHT);
+
+            glMatrixMode(GL_PROJECTION);
+            glPushMatrix();
+            glLoadIdentity();
+            glOrtho(0, ATLAS_WIDTH, 0, ATLAS_HEIGHT, -1, 1);
+            glMatrixMode(GL_MODELVIEW);
+            glPushMatrix();
+            glLoadIdentity();
+
+            glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+            glClear(GL_COLOR_BUFFER_BIT);
+            glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+
+            int cellX, cellY;
+            for (int i = 0; i < CHARACTER_COUNT; i++) {
+                cellOrigin(i, cellX, cellY);
+                glRasterPos2i(cellX + CELL_MARGIN, cellY + CELL_DESCENT);
+                glutBitmapCharacter(font, FIRST_CHARACTER + i);
+            }
+
+            // Célula branca para a geometria sem texto
+            cellOrigin(CHARACTER_COUNT, cellX, cellY);
+            glRecti(cellX, cellY, cellX + CELL_SIZE, cellY + CELL_SIZE);
+            solidU = (cellX + CELL_SIZE * 0.5f) / ATLAS_WIDTH;
+            solidV = (cellY + CELL_SIZE * 0.5f) / ATLAS_HEIGHT;
+
+            glMatrixMode(GL_PROJECTION);
+            glPopMatrix();
+            glMatrixMode(GL_MODELVIEW);
+            glPopMatrix();
+            glPopAttrib();
+        }
+
+        glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previousFramebuffer));
+        glDeleteFramebuffers(1, &framebuffer);
+
+        if (!complete) {
+            glDeleteTextures(1, &texture);
+            texture = 0;
+        }
+        return complete;
+    }
+
+public:
+    static UIGlyphAtlas& getInstance() {
+        static UIGlyphAtlas instance;
+        return instance;
+    }
+
+    UIGlyphAtlas(const UIGlyphAtlas&) = delete;
+    UIGlyphAtlas& operator=(const UIGlyphAtlas&) = delete;
+
+    /**
+     * @brief Monta o atlas na primeira chamada (exige contexto e ShaderUtils::loadExtensions())
+     * @return true se o atlas está pronto; sem FBO, false e o texto volta a glutBitmapCharacter
+     */
+    bool ensureBuilt() {
+        if (built || buildFailed) {
+            return built;
+        }
+
+        for (int i = 0; i < CHARACTER_COUNT; i++) {
+            advances[i] = glutBitmapWidth(font, FIRST_CHARACTER + i);
+        }
+
+        if (!ShaderUtils::hasFramebufferObjects() || !rasterize()) {
+            buildFailed = true;
+            return false;
+        }
+
+        for (int i = 0; i < CHARACTER_COUNT; i++) {
+            int cellX, cellY;
+            cellOrigin(i, cellX, cellY);
+            GlyphQuad& glyph = glyphs[i];
+            glyph.u0 = static_cast<float>(cellX) / ATLAS_WIDTH;
+            glyph.u1 = static_cast<float>(cellX + CELL_SIZE) / ATLAS_WIDTH;
+            glyph.v0 = static_cast<float>(cellY + CELL_SIZE) / ATLAS_HEIGHT;
+            glyph.v1 = static_cast<float>(cellY) / ATLAS_HEIGHT;
+            glyph.offsetX = -static_cast<float>(CELL_MARGIN);
+            glyph.ascent = static_cast<float>(CELL_SIZE - CELL_DESCENT);
+            glyph.descent = static_cast<float>(CELL_DESCENT);
+            glyph.width = static_cast<float>(CELL_SIZE);
+            glyph.advance = advances[i];
+        }
+        built = true;
+        return true;
+    }
+
+    bool isReady() const { return built; }
+
+    /**
+     * @brief Indica se textos nessa fonte podem ser desenhados pelo atlas
+     */
+    bool supports(void* textFont) const { return built && textFont == font; }
+
+    GLuint getTexture() const { return texture; }
+    float getSolidU() const { return solidU; }
+    float getSolidV() const { return solidV; }
+
+    /**
+     * @brief Glifo de um caractere; fora de ' '..'~' devolve o do espaço
+     */
+    const GlyphQuad& getGlyph(char character) const {
+        int index = static_cast<unsigned char>(character) - FIRST_CHARACTER;
+        if (index < 0 || index >= CHARACTER_COUNT) {
+            index = 0;
+        }
+        return glyphs[index];
+    }
+
+    /**
+     * @brief Largura do texto em pixels na fonte do atlas (ou na fonte pedida, via GLUT)
+     */
+    int measure(const std::string& text, void* textFont = GLUT_BITMAP_HELVETICA_12) const {
+        int width = 0;
+        if (textFont == font && (built || buildFailed)) {
+            for (char c : text) {
+                int index = static_cast<unsigned char>(c) - FIRST_CHARACTER;
+                width += (index >= 0 && index < CHARACTER_COUNT) ? advances[index] : glutBitmapWidth(textFont, c);
+            }
+            return width;
+        }
+        for (char c : text) {
+            width += glutBitmapWidth(textFont, c);
+        }
+        return width;
+    }
+
+    /**
+     * @brief Apaga a textura; o próximo ensureBuilt() rasteriza de novo
+     */
+    void release() {
+        if (texture) {
+            glDeleteTextures(1, &texture);
+            texture = 0;
+        }
+        built = false;
+        buildFailed = false;
+    }
+};
+
+} // namespace UIPrimitives
+
+#endif // UI_GLYPH_ATLAS_H
@@ -10,8 +10,13 @@
 
 #include "ui_button.h"
 #include "ui_primitives.h"
+#include "ui_draw_list.h"
+#include "ui_panel_cache.h"
 #include "ui_theme.h"
 #include "data_structures.h"
+#include "spatial_grid.h"
+#include "frame_profiler.h"
+#include <cstdio>
 #include <vector>
 #include <memory>
 #include <GL/glut.h>
@@ -94,6 +99,21 @@ private:
     
     // Posição Y da paleta de cores (atualizada dinamicamente)
     float paletteStartY;
+
+    // Índices dos botões por célula, uma grade por modo (0 = 2D, 1 = 3D)
+    UniformGrid<int> buttonGrid[2];
+    int hoveredButton;  // -1 se nenhum
+
+    // Geometria do painel acumulada durante render() e enviada em um único draw
+    UIDrawList drawList;
+
+    // Painel já desenhado em textura; só é refeito quando algo visível muda
+    UIPanelCache panelCache;
+    bool panelDirty;
+    int cachedModeValue;  // Modo (2D/3D) do conteúdo em panelCache; -1 se nenhum
+
+    // Overlay do FrameProfiler; fora do cache porque muda a cada quadro
+    UIDrawList overlayList;
     
 public:
     UIManager()
@@ -107,7 +127,8 @@ public:
           colorTargetToggle(nullptr),
           button2DStart(0), button2DEnd(0),
           button3DStart(0), button3DEnd(0),
-          paletteStartY(0.0f) {
+          paletteStartY(0.0f), hoveredButton(-1),
+          panelDirty(true), cachedModeValue(-1) {
     }
     
     /**
@@ -162,6 +183,7 @@ public:
         windowWidth = width;
         windowHeight = height;
         panelX = width - panelWidth;
+        panelDirty = true;
         
         // Reposiciona botões existentes
         repositionButtons();
@@ -172,6 +194,7 @@ public:
      */
     void createButtons() {
         buttons.clear();
+        panelDirty = true;
         
         float startY = 20;
         float x = panelX + 10;
@@ -295,94 +318,49 @@ public:
         button3DEnd = buttons.size();
         
         // Paleta de cores será renderizada separadamente (16 círculos coloridos)
+        rebuildButtonGrid();
     }
     
     /**
-     * @brief Renderiza a interface completa usando layout em pilha vertical
+     * @brief Desenha o painel, reaproveitando a textura do frame anterior se nada mudou
+     *
+     * O painel é refeito na textura quando marcado sujo (layout, hover, clique,
+     * troca de modo) e enquanto algum botão ainda anima a cor; fora disso o
+     * frame custa um quad. Sem FBO, desenha direto como antes.
      */
     void render() {
-        enableAntiAliasing();
-        
-        // Painel lateral de fundo
-        drawRoundedRect(panelX, 0, panelWidth, windowHeight, 0, DarkTheme::panel);
-        
-        // === CURSOR DE LAYOUT (Stack Layout) ===
-        float currentY = 30.0f;  // Margem inicial
-        const float sectionSpacing = 25.0f;
-        const float labelHeight = 20.0f;
-        const float buttonSpacing = Typography::buttonSpacing;
-        const float buttonHeight = Typography::buttonHeight;
-        
-        // === DETECÇÃO DE MODO (HARD SEPARATION) ===
-        // currentMode é um ponteiro para AppMode (enum de 2 valores: 0=2D, 1=3D)
-        bool is3DMode = false;
-        if (currentMode != nullptr) {
-            int modeValue = *(int*)currentMode;
-            is3DMode = (modeValue == 1);  // MODE_3D_VIEWER = 1
+        if (!UIPanelCache::isSupported()) {
+            renderPanel();
+            return;
         }
-        
-        // === RENDERIZAÇÃO EXCLUSIVA POR MODO ===
-        if (is3DMode) {
-            // ===== MODO 3D EXCLUSIVO =====
-            
-            // SEÇÃO: OBJECTS
-            currentY = renderSectionLabel("OBJECTS", currentY);
-            for (int i = button3DStart; i < button3DStart + 4 && i < button3DEnd; i++) {
-                buttons[i]->update();
-                buttons[i]->render();
-                currentY += buttonHeight + buttonSpacing;
-            }
-            currentY += sectionSpacing;
-            
-            // SEÇÃO: PROJECTION
-            currentY = renderSectionLabel("PROJECTION", currentY);
-            for (int i = button3DStart + 4; i < button3DStart + 6 && i < button3DEnd; i++) {
-                buttons[i]->update();
-                buttons[i]->render();
-                currentY += buttonHeight + buttonSpacing;
-            }
-            currentY += sectionSpacing;
-            
-            // SEÇÃO: SHADING
-            currentY = renderSectionLabel("SHADING", currentY);
-            for (int i = button3DStart + 6; i < button3DStart + 9 && i < button3DEnd; i++) {
-                buttons[i]->update();
-                buttons[i]->render();
-                currentY += buttonHeight + buttonSpacing;
-            }
-            currentY += sectionSpacing;
-            
-            // SEÇÃO: COLOR TARGET
-            currentY = renderSectionLabel("COLOR TARGET", currentY);
-            if (colorTargetToggle) {
-                colorTargetToggle->update();
-                colorTargetToggle->render();
-                currentY += buttonHeight * 0.8f + buttonSpacing;
-            }
-            currentY += sectionSpacing;
-            
-        } else {
-            // ===== MODO 2D EXCLUSIVO =====
-            
-            // SEÇÃO: POLYGON TOOLS
-            currentY = renderSectionLabel("POLYGON TOOLS", currentY);
-            
-            // Renderiza TODOS os botões 2D (Close, Fill, Clear, Toggle Vertices, Save)
-            for (int i = button2DStart; i < button2DEnd && i < buttons.size(); i++) {
-                buttons[i]->update();
-                buttons[i]->render();
-                currentY += buttonHeight + buttonSpacing;
+
+        int modeValue = (currentMode != nullptr) ? *(int*)currentMode : 0;
+        bool stale = panelDirty || modeValue != cachedModeValue || isAnimating() ||
+                     !panelCache.matches(panelWidth, windowHeight);
+
+        if (stale) {
+            if (!panelCache.beginCapture(panelX, panelWidth, windowHeight)) {
+                renderPanel();
+                return;
             }
-            currentY += sectionSpacing;
+            renderPanel();
+            panelCache.endCapture();
+            panelDirty = false;
+            cachedModeValue = modeValue;
         }
-        
-        // === PALETA DE CORES (Comum a ambos os modos, mas com label diferente) ===
-        currentY = renderSectionLabel(is3DMode ? "COLOR PALETTE" : "FILL COLOR", currentY);
-        paletteStartY = currentY;  // Armazena posição Y para detecção de cliques
-        renderColorPalette(currentY);
-        
+
+        // Deixa o blending como o desenho direto deixava
+        enableAntiAliasing();
+        panelCache.composite();
         disableAntiAliasing();
     }
+
+    /**
+     * @brief Força o painel a ser redesenhado no próximo render()
+     */
+    void markDirty() {
+        panelDirty = true;
+    }
     
     /**
      * @brief Processa clique do mouse
@@ -394,11 +372,8 @@ public:
             is3DMode = (modeValue == 1);
         }
 
-        int start = is3DMode ? button3DStart : button2DStart;
-        int end = is3DMode ? button3DEnd : button2DEnd;
-
-        // Verifica clique nos botões
-        for (int i = start; i < end; i++) {
+        // Verifica clique nos botões da célula sob o cursor
+        for (int i : buttonGrid[is3DMode ? 1 : 0].cellAt(static_cast<float>(mouseX), static_cast<float>(mouseY))) {
             auto& btn = buttons[i];
             if (btn->handleClick(mouseX, mouseY)) {
                 // Para botões RADIO, atualiza o grupo
@@ -411,14 +386,14 @@ public:
                         shadingGroup.setActive(btn.get());
                     }
                 }
-                glutPostRedisplay();
+                panelDirty = true;
                 return true;
             }
         }
         
         // Verifica clique na paleta de cores
         if (handleColorPaletteClick(mouseX, mouseY)) {
-            glutPostRedisplay();
+            panelDirty = true;
             return true;
         }
         
@@ -427,8 +402,40 @@ public:
     
     /**
      * @brief Atualiza hover de todos os botões
+     * @return true se algum botão entrou ou saiu do hover (precisa redesenhar)
      */
-    void handleHover(int mouseX, int mouseY) {
+    bool handleHover(int mouseX, int mouseY) {
+        bool is3DMode = false;
+        if (currentMode != nullptr) {
+            int modeValue = *(int*)currentMode;
+            is3DMode = (modeValue == 1);
+        }
+
+        // Só os botões da célula sob o cursor podem estar em hover; o anterior sai dele
+        int hit = -1;
+        for (int i : buttonGrid[is3DMode ? 1 : 0].cellAt(static_cast<float>(mouseX), static_cast<float>(mouseY))) {
+            if (buttons[i]->containsPoint(mouseX, mouseY)) {
+                hit = i;
+                break;
+            }
+        }
+
+        bool changed = false;
+        if (hoveredButton >= 0 && hoveredButton != hit) {
+            changed |= buttons[hoveredButton]->updateHover(mouseX, mouseY);
+        }
+        if (hit >= 0) {
+            changed |= buttons[hit]->updateHover(mouseX, mouseY);
+        }
+        hoveredButton = hit;
+        panelDirty |= changed;
+        return changed;
+    }
+
+    /**
+     * @brief Indica se algum botão do modo atual ainda está em transição de cor
+     */
+    bool isAnimating() const {
         bool is3DMode = false;
         if (currentMode != nullptr) {
             int modeValue = *(int*)currentMode;
@@ -439,19 +446,107 @@ public:
         int end = is3DMode ? button3DEnd : button2DEnd;
 
         for (int i = start; i < end; i++) {
-            buttons[i]->updateHover(mouseX, mouseY);
+            if (buttons[i]->isAnimating()) {
+                return true;
+            }
         }
+        return false;
     }
     
     /**
      * @brief Libera todos os botões pressionados
+     * @return true se algum estava pressionado
      */
-    void releaseAll() {
+    bool releaseAll() {
+        bool released = false;
         for (auto& btn : buttons) {
-            btn->releasePress();
+            released |= btn->releasePress();
         }
+        panelDirty |= released;
+        return released;
     }
     
+    /**
+     * @brief Desenha as estatísticas do FrameProfiler no canto superior esquerdo (se ligado)
+     *
+     * Espera a projeção 2D da UI. Uma linha por etapa com média, mediana e p95
+     * de CPU e de GPU (ms), o tempo do quadro e os contadores por quadro.
+     */
+    void renderProfilerOverlay() {
+        const FrameProfiler& profiler = FrameProfiler::getInstance();
+        if (!profiler.isEnabled()) {
+            return;
+        }
+
+        const float left = 10.0f;
+        const float top = 10.0f;
+        const float lineHeight = 15.0f;
+        const float columns[] = { 0.0f, 120.0f, 180.0f, 235.0f, 295.0f, 360.0f };
+        const int counterLines = FrameProfiler::COUNTER_COUNT;
+        const float boxWidth = 425.0f;
+        const float boxHeight = lineHeight * (4 + FrameProfiler::STAGE_COUNT + counterLines) + 12.0f;
+        char text[64];
+
+        enableAntiAliasing();
+        overlayList.begin();
+        overlayList.addShadow(left, top, boxWidth, boxHeight, 6.0f);
+        overlayList.addRoundedRect(left, top, boxWidth, boxHeight, 6.0f, DarkTheme::panelDark);
+
+        float x = left + 10.0f;
+        float y = top + 18.0f;
+        std::snprintf(text, sizeof(text), "Perfil: %d quadros (F3 fecha, F4 grava CSV)", profiler.getSampleCount());
+        overlayList.addText(x, y, text, DarkTheme::textPrimary);
+        y += lineHeight;
+
+        const char* headers[] = { "etapa (ms)", "CPU med", "p50", "p95", "GPU med", "p95" };
+        for (int column = 0; column < 6; column++) {
+            overlayList.addText(x + columns[column], y, headers[column], DarkTheme::textSecondary);
+        }
+        y += lineHeight;
+
+        for (int stage = -1; stage < FrameProfiler::STAGE_COUNT; stage++) {
+            TimingSummary cpu = stage < 0 ? profiler.getFrameSummary()
+                                          : profiler.getCpuSummary(static_cast<ProfileStage>(stage));
+            overlayList.addText(x, y, stage < 0 ? "quadro" : FrameProfiler::getStageName(static_cast<ProfileStage>(stage)),
+                                stage < 0 ? DarkTheme::accentYellow : DarkTheme::textPrimary);
+            if (cpu.samples > 0) {
+                double values[] = { cpu.average, cpu.median, cpu.percentile95 };
+                for (int column = 0; column < 3; column++) {
+                    std::snprintf(text, sizeof(text), "%.3f", values[column]);
+                    overlayList.addText(x + columns[column + 1], y, text, DarkTheme::textPrimary);
+                }
+            } else {
+                overlayList.addText(x + columns[1], y, "-", DarkTheme::textDisabled);
+            }
+            if (stage >= 0) {
+                TimingSummary gpu = profiler.getGpuSummary(static_cast<ProfileStage>(stage));
+                if (gpu.samples > 0) {
+                    std::snprintf(text, sizeof(text), "%.3f", gpu.average);
+                    overlayList.addText(x + columns[4], y, text, DarkTheme::accentGreen);
+                    std::snprintf(text, sizeof(text), "%.3f", gpu.percentile95);
+                    overlayList.addText(x + columns[5], y, text, DarkTheme::accentGreen);
+                } else {
+                    overlayList.addText(x + columns[4], y, profiler.hasGpuTimings() ? "-" : "n/d", DarkTheme::textDisabled);
+                }
+            }
+            y += lineHeight;
+        }
+
+        y += 4.0f;
+        for (int counter = 0; counter < counterLines; counter++) {
+            RenderCounter id = static_cast<RenderCounter>(counter);
+            overlayList.addText(x, y, RenderCounters::getName(id), DarkTheme::textSecondary);
+            std::snprintf(text, sizeof(text), "%llu", static_cast<unsigned long long>(profiler.getLastCounter(id)));
+            overlayList.addText(x + columns[1], y, text, DarkTheme::textPrimary);
+            std::snprintf(text, sizeof(text), "med %.1f", profiler.getCounterAverage(id));
+            overlayList.addText(x + columns[3], y, text, DarkTheme::textSecondary);
+            y += lineHeight;
+        }
+
+        overlayList.flush();
+        disableAntiAliasing();
+    }
+
     // Getters de estado
     ShadingMode getShadingMode() const { return currentShading; }
     ProjectionMode getProjectionMode() const { return currentProjection; }
@@ -471,6 +566,23 @@ private:
         return ptr;
     }
     
+    /**
+     * @brief Indexa os botões de cada modo pela caixa que ocupam
+     */
+    void rebuildButtonGrid() {
+        const float cellSize = 32.0f;
+        for (int mode = 0; mode < 2; mode++) {
+            buttonGrid[mode].reset(0.0f, 0.0f, static_cast<float>(windowWidth), static_cast<float>(windowHeight), cellSize);
+            int start = mode ? button3DStart : button2DStart;
+            int end = mode ? button3DEnd : button2DEnd;
+            for (int i = start; i < end; i++) {
+                const UIButton& btn = *buttons[i];
+                buttonGrid[mode].insert(i, btn.x, btn.y, btn.x + btn.width, btn.y + btn.height);
+            }
+        }
+        hoveredButton = -1;
+    }
+    
     /**
      * @brief Reposiciona botões após redimensionamento
      */
@@ -482,18 +594,104 @@ private:
     }
     
     /**
-     * @brief Renderiza um label de seção e retorna a próxima posição Y
+     * @brief Desenha a interface completa usando layout em pilha vertical
      */
-    float renderSectionLabel(const std::string& text, float currentY) {
-        glColor4f(DarkTheme::textSecondary.r, DarkTheme::textSecondary.g, 
-                 DarkTheme::textSecondary.b, DarkTheme::textSecondary.a);
+    void renderPanel() {
+        enableAntiAliasing();
+        if (panelCache.isCapturing()) {
+            panelCache.useCaptureBlending();
+        }
+        drawList.begin();
+        
+        // Painel lateral de fundo
+        drawList.addRect(panelX, 0, panelWidth, windowHeight, DarkTheme::panel);
         
-        void* font = GLUT_BITMAP_HELVETICA_12;
-        glRasterPos2f(panelX + 15, currentY);
-        for (char c : text) {
-            glutBitmapCharacter(font, c);
+        // === CURSOR DE LAYOUT (Stack Layout) ===
+        float currentY = 30.0f;  // Margem inicial
+        const float sectionSpacing = 25.0f;
+        const float labelHeight = 20.0f;
+        const float buttonSpacing = Typography::buttonSpacing;
+        const float buttonHeight = Typography::buttonHeight;
+        
+        // === DETECÇÃO DE MODO (HARD SEPARATION) ===
+        // currentMode é um ponteiro para AppMode (enum de 2 valores: 0=2D, 1=3D)
+        bool is3DMode = false;
+        if (currentMode != nullptr) {
+            int modeValue = *(int*)currentMode;
+            is3DMode = (modeValue == 1);  // MODE_3D_VIEWER = 1
+        }
+        
+        // === RENDERIZAÇÃO EXCLUSIVA POR MODO ===
+        if (is3DMode) {
+            // ===== MODO 3D EXCLUSIVO =====
+            
+            // SEÇÃO: OBJECTS
+            currentY = renderSectionLabel("OBJECTS", currentY);
+            for (int i = button3DStart; i < button3DStart + 4 && i < button3DEnd; i++) {
+                buttons[i]->update();
+                buttons[i]->render(drawList);
+                currentY += buttonHeight + buttonSpacing;
+            }
+            currentY += sectionSpacing;
+            
+            // SEÇÃO: PROJECTION
+            currentY = renderSectionLabel("PROJECTION", currentY);
+            for (int i = button3DStart + 4; i < button3DStart + 6 && i < button3DEnd; i++) {
+                buttons[i]->update();
+                buttons[i]->render(drawList);
+                currentY += buttonHeight + buttonSpacing;
+            }
+            currentY += sectionSpacing;
+            
+            // SEÇÃO: SHADING
+            currentY = renderSectionLabel("SHADING", currentY);
+            for (int i = button3DStart + 6; i < button3DStart + 9 && i < button3DEnd; i++) {
+                buttons[i]->update();
+                buttons[i]->render(drawList);
+                currentY += buttonHeight + buttonSpacing;
+            }
+            currentY += sectionSpacing;
+            
+            // SEÇÃO: COLOR TARGET
+            currentY = renderSectionLabel("COLOR TARGET", currentY);
+            if (colorTargetToggle) {
+                colorTargetToggle->update();
+                colorTargetToggle->render(drawList);
+                currentY += buttonHeight * 0.8f + buttonSpacing;
+            }
+            currentY += sectionSpacing;
+            
+        } else {
+            // ===== MODO 2D EXCLUSIVO =====
+            
+            // SEÇÃO: POLYGON TOOLS
+            currentY = renderSectionLabel("POLYGON TOOLS", currentY);
+            
+            // Renderiza TODOS os botões 2D (Close, Fill, Clear, Toggle Vertices, Save)
+            for (int i = button2DStart; i < button2DEnd && i < buttons.size(); i++) {
+                buttons[i]->update();
+                buttons[i]->render(drawList);
+                currentY += buttonHeight + buttonSpacing;
+            }
+            currentY += sectionSpacing;
         }
         
+        // === PALETA DE CORES (Comum a ambos os modos, mas com label diferente) ===
+        currentY = renderSectionLabel(is3DMode ? "COLOR PALETTE" : "FILL COLOR", currentY);
+        paletteStartY = currentY;  // Armazena posição Y para detecção de cliques
+        renderColorPalette(currentY);
+        
+        // Todo o painel sai em um único draw de triângulos, seguido dos textos
+        drawList.flush();
+        disableAntiAliasing();
+    }
+    
+    /**
+     * @brief Renderiza um label de seção e retorna a próxima posição Y
+     */
+    float renderSectionLabel(const std::string& text, float currentY) {
+        drawList.addText(panelX + 15, currentY, text, DarkTheme::textSecondary);
+        
         // Retorna Y + altura do label + espaçamento
         return currentY + 20.0f;
     }
@@ -516,11 +714,11 @@ private:
             float cy = startY + row * spacing + circleRadius;
             
             // Desenha o círculo de cor
-            drawCircle(cx, cy, circleRadius, colors[i]);
+            drawList.addCircle(cx, cy, circleRadius, colors[i]);
             
             // Destaca a cor selecionada
             if (i == selectedColorIndex) {
-                drawCircleOutline(cx, cy, circleRadius + 3, DarkTheme::accentBlue, 3.0f);
+                drawList.addCircleOutline(cx, cy, circleRadius + 3, DarkTheme::accentBlue, 3.0f);
             }
         }
     }
@@ -534,23 +732,27 @@ private:
         float circleRadius = 12;
         float spacing = 30;
         
-        for (int i = 0; i < 16; i++) {
-            int row = i / 4;
-            int col = i % 4;
-            
-            float cx = startX + col * spacing + circleRadius;
-            float cy = startY + row * spacing + circleRadius;
-            
-            // Verifica se clicou neste círculo
-            float dx = mouseX - cx;
-            float dy = mouseY - cy;
-            float distSq = dx * dx + dy * dy;
-            
-            if (distSq <= circleRadius * circleRadius) {
-                selectedColorIndex = i;
-                applyColorChange(i);
-                return true;
-            }
+        // A paleta é uma grade 4x4 de passo spacing: a célula sai direto da divisão,
+        // e cada círculo fica inteiro dentro da sua
+        int col = static_cast<int>(std::floor((mouseX - startX) / spacing));
+        int row = static_cast<int>(std::floor((mouseY - startY) / spacing));
+        if (col < 0 || col >= 4 || row < 0 || row >= 4) {
+            return false;
+        }
+        
+        float cx = startX + col * spacing + circleRadius;
+        float cy = startY + row * spacing + circleRadius;
+        
+        // Verifica se clicou neste círculo
+        float dx = mouseX - cx;
+        float dy = mouseY - cy;
+        float distSq = dx * dx + dy * dy;
+        
+        if (distSq <= circleRadius * circleRadius) {
+            int i = row * 4 + col;
+            selectedColorIndex = i;
+            applyColorChange(i);
+            return true;
         }
         
         return false;
@@ -580,12 +782,12 @@ private:
         if (currentColorTarget == ColorTarget::OBJECT) {
             currentColorTarget = ColorTarget::LIGHT;
             if (colorTargetToggle) {
-                colorTargetToggle->label = "Light Color";
+                colorTargetToggle->setLabel("Light Color");
             }
         } else {
             currentColorTarget = ColorTarget::OBJECT;
             if (colorTargetToggle) {
-                colorTargetToggle->label = "Object Color";
+                colorTargetToggle->setLabel("Object Color");
             }
         }
     }
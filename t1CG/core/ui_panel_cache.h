@@ -0,0 +1,212 @@
+/**
+ * @file ui_panel_cache.h
+ * @brief Painel lateral renderizado em uma textura e reaproveitado enquanto não muda
+ * @author Sistema de UI OpenGL
+ * @date 2025
+ */
+
+#ifndef UI_PANEL_CACHE_H
+#define UI_PANEL_CACHE_H
+
+#include "shader_utils.h"
+#include "render_counters.h"
+#include <GL/gl.h>
+
+namespace UIPrimitives {
+
+/**
+ * @class UIPanelCache
+ * @brief Alvo de renderização (FBO + textura) do tamanho do painel
+ *
+ * O painel é semitransparente (DarkTheme::panel tem alfa 0.95) e desenhado
+ * com blending por cima da cena. Para que compor a textura depois dê o mesmo
+ * resultado, a captura grava cor pré-multiplicada: a cor usa
+ * SRC_ALPHA/ONE_MINUS_SRC_ALPHA como sempre, e o alfa acumula com
+ * ONE/ONE_MINUS_SRC_ALPHA (glBlendFuncSeparate). A composição é então um quad
+ * com ONE/ONE_MINUS_SRC_ALPHA.
+ *
+ * Durante a captura a projeção continua em coordenadas de janela, só que
+ * recortada ao retângulo do painel; quem desenha não precisa saber do cache.
+ */
+class UIPanelCache {
+private:
+    GLuint texture;
+    GLuint framebuffer;
+    int width, height;
+    float originX;
+    bool capturing;
+    GLint previousFramebuffer;
+
+    /**
+     * @brief (Re)cria a textura e o FBO quando o tamanho muda
+     */
+    bool ensureTarget(int targetWidth, int targetHeight) {
+        if (texture && width == targetWidth && height == targetHeight) {
+            return true;
+        }
+
+        if (!texture) {
+            glGenTextures(1, &texture);
+        }
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, targetWidth, targetHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        if (!framebuffer) {
+            glGenFramebuffers(1, &framebuffer);
+        }
+        GLint boundFramebuffer = 0;
+        glGetIntegerv(GL_FRAMEBUFFER_BINDING, &boundFramebuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+        bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+        glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(boundFramebuffer));
+
+        if (!complete) {
+            release();
+            return false;
+        }
+        width = targetWidth;
+        height = targetHeight;
+        return true;
+    }
+
+public:
+    UIPanelCache()
+        : texture(0), framebuffer(0), width(0), height(0), originX(0.0f),
+          capturing(false), previousFramebuffer(0) {}
+
+    ~UIPanelCache() {
+        release();
+    }
+
+    UIPanelCache(const UIPanelCache&) = delete;
+    UIPanelCache& operator=(const UIPanelCache&) = delete;
+
+    /**
+     * @brief Indica se o driver permite o cache (FBO e blending separado de alfa)
+     */
+    static bool isSupported() {
+        return ShaderUtils::hasFramebufferObjects() && glBlendFuncSeparate;
+    }
+
+    /**
+     * @brief Indica se há um conteúdo capturado com esse tamanho
+     */
+    bool matches(int panelWidth, int panelHeight) const {
+        return texture && width == panelWidth && height == panelHeight;
+    }
+
+    bool isCapturing() const { return capturing; }
+
+    /**
+     * @brief Redireciona o desenho para a textura, limpa para transparente
+     * @param x Coordenada X (de janela) da borda esquerda do painel
+     * @param windowHeight Altura da janela, que também é a do painel
+     * @return false se o alvo não pôde ser criado (desenhe direto na tela)
+     */
+    bool beginCapture(float x, int panelWidth, int windowHeight) {
+        if (panelWidth <= 0 || windowHeight <= 0 || !ensureTarget(panelWidth, windowHeight)) {
+            return false;
+        }
+
+        originX = x;
+        glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+
+        glPushAttrib(GL_VIEWPORT_BIT | GL_COLOR_BUFFER_BIT | GL_ENABLE_BIT);
+        glViewport(0, 0, width, height);
+        glDisable(GL_SCISSOR_TEST);
+        glDisable(GL_DEPTH_TEST);
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        glMatrixMode(GL_PROJECTION);
+        glPushMatrix();
+        glLoadIdentity();
+        glOrtho(x, x + width, height, 0, -1, 1);
+        glMatrixMode(GL_MODELVIEW);
+        glPushMatrix();
+        glLoadIdentity();
+
+        capturing = true;
+        return true;
+    }
+
+    /**
+     * @brief Blending da captura (cor pré-multiplicada); chamar depois de quem mexe em glBlendFunc
+     */
+    void useCaptureBlending() const {
+        glEnable(GL_BLEND);
+        glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    }
+
+    /**
+     * @brief Volta ao framebuffer, viewport e matrizes de antes de beginCapture
+     */
+    void endCapture() {
+        if (!capturing) {
+            return;
+        }
+        glMatrixMode(GL_PROJECTION);
+        glPopMatrix();
+        glMatrixMode(GL_MODELVIEW);
+        glPopMatrix();
+        glPopAttrib();
+        glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previousFramebuffer));
+        capturing = false;
+    }
+
+    /**
+     * @brief Compõe a textura sobre o que já está na tela, na posição da captura
+     *
+     * Espera a projeção 2D da UI (glOrtho com Y para baixo, em pixels de janela).
+     */
+    void composite() const {
+        if (!texture) {
+            return;
+        }
+
+        glPushAttrib(GL_COLOR_BUFFER_BIT | GL_ENABLE_BIT | GL_TEXTURE_BIT);
+        glDisable(GL_POLYGON_SMOOTH);
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+        glEnable(GL_TEXTURE_2D);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+
+        // Linha 0 da textura é a base do painel (Y da janela para cima)
+        float right = originX + width;
+        RenderCounters::add(RenderCounter::IMMEDIATE_BLOCKS);
+        RenderCounters::add(RenderCounter::TRIANGLES, 2);
+        glBegin(GL_QUADS);
+            glTexCoord2f(0.0f, 1.0f); glVertex2f(originX, 0.0f);
+            glTexCoord2f(1.0f, 1.0f); glVertex2f(right, 0.0f);
+            glTexCoord2f(1.0f, 0.0f); glVertex2f(right, static_cast<float>(height));
+            glTexCoord2f(0.0f, 0.0f); glVertex2f(originX, static_cast<float>(height));
+        glEnd();
+
+        glPopAttrib();
+    }
+
+    void release() {
+        if (framebuffer && ShaderUtils::hasFramebufferObjects()) {
+            glDeleteFramebuffers(1, &framebuffer);
+        }
+        if (texture) {
+            glDeleteTextures(1, &texture);
+        }
+        framebuffer = 0;
+        texture = 0;
+        width = 0;
+        height = 0;
+    }
+};
+
+} // namespace UIPrimitives
+
+#endif // UI_PANEL_CACHE_H
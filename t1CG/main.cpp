@@ -15,27 +15,59 @@
 #include "core/event_handler.h"
 #include "core/scene_manager.h"
 #include "core/application_context.h"
-
-// Variáveis Globais de Shader
-PFNGLCREATESHADERPROC glCreateShader = NULL;
-PFNGLSHADERSOURCEPROC glShaderSource = NULL;
-PFNGLCOMPILESHADERPROC glCompileShader = NULL;
-PFNGLGETSHADERIVPROC glGetShaderiv = NULL;
-PFNGLGETSHADERINFOLOGPROC glGetShaderInfoLog = NULL;
-PFNGLCREATEPROGRAMPROC glCreateProgram = NULL;
-PFNGLATTACHSHADERPROC glAttachShader = NULL;
-PFNGLLINKPROGRAMPROC glLinkProgram = NULL;
-PFNGLGETPROGRAMIVPROC glGetProgramiv = NULL;
-PFNGLGETPROGRAMINFOLOGPROC glGetProgramInfoLog = NULL;
-PFNGLUSEPROGRAMPROC glUseProgram = NULL;
-PFNGLGETUNIFORMLOCATIONPROC glGetUniformLocation = NULL;
-PFNGLUNIFORM1FPROC glUniform1f = NULL;
-PFNGLUNIFORM3FPROC glUniform3f = NULL;
+#include "core/frame_scheduler.h"
+#include "core/frame_profiler.h"
 
 // --- CALLBACKS GLUT ---
 
+/**
+ * @brief Mantém os redesenhos enquanto há extrusões em segundo plano (display() faz a troca)
+ */
+void extrusionPollTimer(int) {
+    FrameScheduler::getInstance().requestRedraw();
+    if (ApplicationContext::getInstance()->sceneManager.hasPendingExtrusions()) {
+        glutTimerFunc(16, extrusionPollTimer, 0);
+    }
+}
+
+/**
+ * @brief Desenha os polígonos salvos, só os que tocam clip quando informado
+ */
+static void renderSavedPolygons(ApplicationContext* app, const ScreenRect* clip) {
+    app->graphicsRenderer.renderSavedPolygons(app->polygonManager.getSavedPolygons(), 
+                                              app->windowDimensions->height, 
+                                              app->windowDimensions->width,
+                                              app->polygonManager.getSavedPolygonsRevision(),
+                                              clip);
+}
+
+/**
+ * @brief Desenha o polígono em edição: contorno, preenchimento (se ativo) e vértices
+ */
+static void renderCurrentPolygon(ApplicationContext* app) {
+    app->graphicsRenderer.renderPolygon(app->polygonManager.getVertices(), 
+                                        app->polygonManager.getVisualConfiguration(), 
+                                        app->polygonManager.isPolygonCurrentlyClosed());
+    
+    if (app->polygonManager.canBeFilled() && app->applicationState == ApplicationState::POLYGON_FILLED) {
+         app->graphicsRenderer.fillPolygon(app->polygonManager.getVertices(), 
+                                           app->polygonManager.getCurrentFillColor(), 
+                                           app->windowDimensions->height, 
+                                           app->windowDimensions->width);
+    }
+    
+    app->graphicsRenderer.renderPolygonVertices(app->polygonManager.getVertices(), 
+                                                app->polygonManager.getVisualConfiguration().showVertices);
+}
+
 void display() {
     auto* app = ApplicationContext::getInstance();
+    FrameScheduler::getInstance().beginFrame();
+    FrameProfiler::getInstance().beginFrame();
+    
+    // Recolhe malhas prontas das threads de extrusão e troca a cena se estiver completa
+    app->sceneManager.pollExtrusionResults();
+    
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
     if (app->currentMode == AppMode::MODE_2D_EDITOR) {
@@ -47,45 +79,75 @@ void display() {
         }
         glMatrixMode(GL_MODELVIEW);
         glLoadIdentity();
-        glDisable(GL_DEPTH_TEST);
-        glDisable(GL_LIGHTING);
+        GLStateCache::getInstance().disable(GL_DEPTH_TEST);
+        GLStateCache::getInstance().disable(GL_LIGHTING);
 
-        // Renderiza polígonos
-        app->graphicsRenderer.renderSavedPolygons(app->polygonManager.getSavedPolygons(), 
-                                                  app->windowDimensions->height, 
-                                                  app->windowDimensions->width);
-        
-        app->graphicsRenderer.renderPolygon(app->polygonManager.getVertices(), 
-                                            app->polygonManager.getVisualConfiguration(), 
-                                            app->polygonManager.isPolygonCurrentlyClosed());
-        
-        if (app->polygonManager.canBeFilled() && app->applicationState == ApplicationState::POLYGON_FILLED) {
-             app->graphicsRenderer.fillPolygon(app->polygonManager.getVertices(), 
-                                               app->polygonManager.getCurrentFillColor(), 
-                                               app->windowDimensions->height, 
-                                               app->windowDimensions->width);
+        int width = app->windowDimensions->width;
+        int height = app->windowDimensions->height;
+        app->collectEditorDamage();
+        DamageTracker& damage = app->polygonManager.getDamage();
+
+        if (app->editorLayer.prepare(width, height)) {
+            // Só os retângulos danificados são redesenhados na camada; o resto do quadro vem dela.
+            // Os retângulos são disjuntos, então desenhar salvos e atual em passadas separadas
+            // mantém a mesma ordem de sobreposição do desenho completo.
+            if (damage.hasDamage()) {
+                std::vector<ScreenRect> dirtyRects = app->editorLayer.takeDirtyRects(damage);
+                app->editorLayer.beginUpdate();
+                {
+                    ProfileScope scope(ProfileStage::SAVED_POLYGONS);
+                    for (const ScreenRect& rect : dirtyRects) {
+                        app->editorLayer.beginRect(rect);
+                        renderSavedPolygons(app, &rect);
+                    }
+                }
+                {
+                    ProfileScope scope(ProfileStage::CURRENT_POLYGON);
+                    for (const ScreenRect& rect : dirtyRects) {
+                        app->editorLayer.resumeRect(rect);
+                        renderCurrentPolygon(app);
+                    }
+                }
+                app->editorLayer.endUpdate();
+            }
+            app->editorLayer.present();
+        } else {
+            // Sem FBO: desenho completo a cada quadro
+            damage.clear();
+            {
+                ProfileScope scope(ProfileStage::SAVED_POLYGONS);
+                renderSavedPolygons(app, nullptr);
+            }
+            {
+                ProfileScope scope(ProfileStage::CURRENT_POLYGON);
+                renderCurrentPolygon(app);
+            }
         }
         
-        app->graphicsRenderer.renderPolygonVertices(app->polygonManager.getVertices(), 
-                                                    app->polygonManager.getVisualConfiguration().showVertices);
-        
         // === RENDERIZA UI NO MODO 2D ===
-        app->uiManager.render();
+        {
+            ProfileScope scope(ProfileStage::UI);
+            app->uiManager.render();
+        }
+        app->uiManager.renderProfilerOverlay();
 
     } else {
         // --- MODO 3D ---
         int w = glutGet(GLUT_WINDOW_WIDTH);
         int h = glutGet(GLUT_WINDOW_HEIGHT);
         
-        glEnable(GL_DEPTH_TEST);
-        glEnable(GL_LIGHTING);
-        app->sceneManager.updateProjectionMatrix(w, h);
-        app->sceneManager.render();
+        {
+            ProfileScope scope(ProfileStage::SCENE_3D);
+            app->sceneManager.updateProjectionMatrix(w, h);
+            app->sceneManager.render();
+        }
 
         // --- Renderizar UI Overlay no modo 3D ---
-        glPushAttrib(GL_ALL_ATTRIB_BITS);
-        glDisable(GL_DEPTH_TEST);
-        glDisable(GL_LIGHTING);
+        // Luz e profundidade saem pelo cache, antes do push: o pop restaura o que o cache já registrou.
+        // O empilhamento guarda só o que a UI altera (blend, suavização, espessura de linha).
+        GLStateCache::getInstance().disable(GL_DEPTH_TEST);
+        GLStateCache::getInstance().disable(GL_LIGHTING);
+        glPushAttrib(GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT | GL_LINE_BIT);
         
         glMatrixMode(GL_PROJECTION);
         glPushMatrix();
@@ -96,7 +158,11 @@ void display() {
         glPushMatrix();
         glLoadIdentity();
         
-        app->uiManager.render();
+        {
+            ProfileScope scope(ProfileStage::UI);
+            app->uiManager.render();
+        }
+        app->uiManager.renderProfilerOverlay();
         
         glMatrixMode(GL_PROJECTION);
         glPopMatrix();
@@ -105,7 +171,17 @@ void display() {
         glPopAttrib();
     }
 
-    glutSwapBuffers();
+    {
+        ProfileScope scope(ProfileStage::SWAP);
+        glutSwapBuffers();
+    }
+    FrameProfiler::getInstance().endFrame();
+
+    // Transições de hover/clique dos botões continuam por conta própria até chegarem à cor alvo;
+    // com o profiler ligado os quadros seguem contínuos (até o limite de FPS) para o overlay andar
+    if (app->uiManager.isAnimating() || FrameProfiler::getInstance().isEnabled()) {
+        FrameScheduler::getInstance().requestRedraw();
+    }
 }
 
 void reshape(int w, int h) {
@@ -118,9 +194,10 @@ void reshape(int w, int h) {
         app->eventHandler->updateWindowDimensions(app->windowDimensions);
     }
     
+    app->polygonManager.setSpanCacheBounds(h, w);
     app->uiManager.updateLayout(w, h);
     glViewport(0, 0, w, h);
-    glutPostRedisplay();
+    FrameScheduler::getInstance().requestRedraw();
 }
 
 void keyboard(unsigned char key, int x, int y) {
@@ -132,10 +209,13 @@ void keyboard(unsigned char key, int x, int y) {
         if (app->currentMode == AppMode::MODE_2D_EDITOR) {
             app->create3DObjectsFrom2D();
             app->currentMode = AppMode::MODE_3D_VIEWER;
+            if (app->sceneManager.hasPendingExtrusions()) {
+                glutTimerFunc(16, extrusionPollTimer, 0);
+            }
         } else {
             app->currentMode = AppMode::MODE_2D_EDITOR;
         }
-        glutPostRedisplay();
+        FrameScheduler::getInstance().requestRedraw();
         return;
     }
 
@@ -158,10 +238,51 @@ void keyboard(unsigned char key, int x, int y) {
             case '3': app->sceneManager.setLightingModel(LightingModel::PHONG); break;
             case 'p': case 'P': app->sceneManager.setProjection(ProjectionType::PERSPECTIVE); break;
             case 'o': case 'O': app->sceneManager.setProjection(ProjectionType::ORTHOGRAPHIC); break;
+            case 't': case 'T': app->sceneManager.toggleTiling(); break;
         }
         app->sceneManager.setCameraPosition(camPos.x, camPos.y, camPos.z);
+        FrameScheduler::getInstance().requestRedraw();
+    }
+}
+
+/**
+ * @brief Teclas de função: F3 liga/desliga o profiler, F4 grava o histórico em CSV,
+ *        F5 grava a cena em scene.cgs e F9 a carrega de volta
+ */
+void specialKeys(int key, int, int) {
+    FrameProfiler& profiler = FrameProfiler::getInstance();
+    if (key == GLUT_KEY_F3) {
+        profiler.toggle();
+        std::cout << "Profiler de quadro " << (profiler.isEnabled() ? "ligado" : "desligado") << std::endl;
+        FrameScheduler::getInstance().requestRedraw();
+    } else if (key == GLUT_KEY_F4) {
+        const char* path = "frame_profile.csv";
+        if (profiler.writeCsv(path)) {
+            std::cout << "Perfil de " << profiler.getSampleCount() << " quadros gravado em " << path << std::endl;
+        } else {
+            std::cout << "Sem amostras para gravar (ligue o profiler com F3)" << std::endl;
+        }
+    } else if (key == GLUT_KEY_F5) {
+        const char* path = "scene.cgs";
+        auto* app = ApplicationContext::getInstance();
+        if (app->saveScene(path)) {
+            std::cout << app->polygonManager.getSavedPolygonCount() << " poligonos gravados em " << path << std::endl;
+        } else {
+            std::cout << "Falha ao gravar " << path << std::endl;
+        }
+    } else if (key == GLUT_KEY_F9) {
+        const char* path = "scene.cgs";
+        auto* app = ApplicationContext::getInstance();
+        if (app->loadScene(path)) {
+            std::cout << app->polygonManager.getSavedPolygonCount() << " poligonos carregados de " << path << std::endl;
+            if (app->sceneManager.hasPendingExtrusions()) {
+                glutTimerFunc(16, extrusionPollTimer, 0);
+            }
+        } else {
+            std::cout << "Nao foi possivel carregar " << path << std::endl;
+        }
+        FrameScheduler::getInstance().requestRedraw();
     }
-    glutPostRedisplay();
 }
 
 void mouse(int button, int state, int x, int y) {
@@ -171,7 +292,12 @@ void mouse(int button, int state, int x, int y) {
         if (button == GLUT_LEFT_BUTTON) {
             // Prioridade: UI consome cliques em ambos os modos
             if (app->uiManager.handleClick(x, y)) {
-                glutPostRedisplay();
+                FrameScheduler::getInstance().requestRedraw();
+                return;
+            }
+            // Ctrl + clique no editor pega um vértice (ou aresta) de polígono salvo para arrastar
+            if (app->currentMode == AppMode::MODE_2D_EDITOR && (glutGetModifiers() & GLUT_ACTIVE_CTRL)) {
+                if (app->eventHandler) app->eventHandler->beginSavedPolygonDrag(x, y);
                 return;
             }
             // Se UI não consumiu, processa normalmente
@@ -189,10 +315,12 @@ void mouse(int button, int state, int x, int y) {
         if (button == GLUT_RIGHT_BUTTON) {
             app->isRightMouseButtonPressed = false;
         } else if (button == GLUT_LEFT_BUTTON) {
-            app->uiManager.releaseAll();
+            if (app->eventHandler) app->eventHandler->endSavedPolygonDrag();
+            if (app->uiManager.releaseAll()) {
+                FrameScheduler::getInstance().requestRedraw();
+            }
         }
     }
-    glutPostRedisplay();
 }
 
 void motion(int x, int y) {
@@ -210,21 +338,29 @@ void motion(int x, int y) {
             
             app->lastMouseX = x;
             app->lastMouseY = y;
+            if (dx != 0 || dy != 0) {
+                FrameScheduler::getInstance().requestRedraw();
+            }
+        }
+    } else if (app->eventHandler && app->eventHandler->isDraggingSavedPolygon()) {
+        if (app->eventHandler->updateSavedPolygonDrag(x, y)) {
+            FrameScheduler::getInstance().requestRedraw();
         }
     }
-    glutPostRedisplay();
 }
 
 void passiveMotion(int x, int y) {
     auto* app = ApplicationContext::getInstance();
     
-    // UI Hover deve funcionar em ambos os modos
-    app->uiManager.handleHover(x, y);
+    // UI Hover deve funcionar em ambos os modos; só redesenha se algum botão mudou de estado
+    if (app->uiManager.handleHover(x, y)) {
+        FrameScheduler::getInstance().requestRedraw();
+    }
 
+    // O cursor em cruz é o do sistema: trocá-lo não exige redesenhar a cena
     if (app->currentMode == AppMode::MODE_2D_EDITOR) {
         if (app->eventHandler) app->eventHandler->updateMouseCursor(x, y);
     }
-    glutPostRedisplay();
 }
 
 int main(int argc, char** argv) {
@@ -234,10 +370,12 @@ int main(int argc, char** argv) {
     glutCreateWindow("Sistema de Computacao Grafica - OpenGL + GLUT");
 
     ApplicationContext::getInstance()->init();
+    FrameScheduler::getInstance().setFrameRateCap(60);
 
     glutDisplayFunc(display);
     glutReshapeFunc(reshape);
     glutKeyboardFunc(keyboard);
+    glutSpecialFunc(specialKeys);
     glutMouseFunc(mouse);
     glutMotionFunc(motion);
     glutPassiveMotionFunc(passiveMotion);
@@ -248,15 +386,21 @@ int main(int argc, char** argv) {
     std::cout << "Controles:" << std::endl;
     std::cout << "  M - Alternar 2D/3D" << std::endl;
     std::cout << "  ESC - Sair" << std::endl;
+    std::cout << "  F3 - Profiler de quadro (overlay)" << std::endl;
+    std::cout << "  F4 - Gravar perfil em frame_profile.csv" << std::endl;
+    std::cout << "  F5 / F9 - Gravar / carregar a cena (scene.cgs)" << std::endl;
     std::cout << "Modo 2D:" << std::endl;
     std::cout << "  Click - Adicionar vertice" << std::endl;
     std::cout << "  F - Fechar poligono" << std::endl;
     std::cout << "  P - Preencher" << std::endl;
     std::cout << "  S - Salvar poligono" << std::endl;
+    std::cout << "  Ctrl + arrastar - Mover vertice (ou o poligono, pela aresta) salvo" << std::endl;
+    std::cout << "  B - Alternar backend (GL imediato / framebuffer CPU / framebuffer CPU paralelo)" << std::endl;
     std::cout << "Modo 3D:" << std::endl;
     std::cout << "  WASD QE - Mover camera" << std::endl;
     std::cout << "  1/2/3 - Flat/Gouraud/Phong" << std::endl;
     std::cout << "  P/O - Perspectiva/Ortografica" << std::endl;
+    std::cout << "  T - Repetir objetos em grade (instancing)" << std::endl;
     std::cout << "  Arrastar botao direito - Mover luz" << std::endl;
     std::cout << "========================================" << std::endl;
 